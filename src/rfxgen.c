@@ -7,9 +7,21 @@
 *   #define VERSION_ONE
 *       Enable PRO features for the tool. Usually command-line and export options related.
 *
+*   #define COMMAND_LINE_ONLY
+*       Compile headless tool, only command line is available. raylib, raygui and tinyfiledialogs
+*       are not required (WAV loading/export functions are provided), no window, graphics or
+*       audio device is ever initialized. Sound playing (--play) is not available.
+*
 *   #define RENDER_WAVE_TO_TEXTURE (defined by default)
 *       Use RenderTexture2D to render wave on. If not defined, wave is diretly drawn using lines.
 *
+*   #define SYNTH_NO_SIMD, SYNTH_SIMD_VALIDATE
+*       Synth configuration, check rfxgen_synth.h for details.
+*
+*   #define SYNTH_PROFILE
+*       Enable --profile command line option: generation stages and wave export are measured,
+*       summary is shown at exit and events are saved as Chrome trace (chrome://tracing).
+*
 *   VERSIONS HISTORY:
 *       2.0  (xx-Nov-2018) GUI redesigned, CLI improvements
 *       1.8  (10-Oct-2018) Functions renaming, code reorganized, better consistency...
@@ -28,18 +40,23 @@
 *       0.5  (27-Aug-2016) Completed port and adaptation from sfxr (only sound generation and playing)
 *
 *   DEPENDENCIES:
-*       raylib 2.1-dev          - Windowing/input management and drawing.
-*       raygui 2.0              - Immediate-mode GUI controls.
+*       rfxgen_synth            - Wave generation from parameters (single-header library).
+*       raylib 2.1-dev          - Windowing/input management and drawing (not required for COMMAND_LINE_ONLY).
+*       raygui 2.0              - Immediate-mode GUI controls (not required for COMMAND_LINE_ONLY).
 *       tinyfiledialogs 3.3.7   - Open/save file dialogs, it requires linkage with comdlg32 and ole32 libs.
+*                                 (not required for COMMAND_LINE_ONLY)
 *
 *   COMPILATION (Windows - MinGW):
 *       gcc -o rfxgen.exe rfxgen.c external/tinyfiledialogs.c -s rfxgen_icon -Iexternal /
-*           -lraylib -lopengl32 -lgdi32 -lcomdlg32 -lole32 -std=c99 -Wl,--subsystem,windows
+*           -lraylib -lopengl32 -lgdi32 -lcomdlg32 -lole32 -lpthread -std=c99 -Wl,--subsystem,windows
 *
 *   COMPILATION (Linux - GCC):
 *       gcc -o rfxgen rfxgen.c external/tinyfiledialogs.c -s -Iexternal -no-pie -D_DEFAULT_SOURCE /
 *           -lraylib -lGL -lm -lpthread -ldl -lrt -lX11
 *
+*   COMPILATION (Headless command line tool - GCC):
+*       gcc -o rfxgen rfxgen.c -s -O2 -std=c99 -D_DEFAULT_SOURCE -DCOMMAND_LINE_ONLY -lm -lpthread
+*
 *   DEVELOPERS:
 *       Ramon Santamaria (@raysan5):   Developer, supervisor, updater and maintainer.
 *
@@ -64,6 +81,7 @@
 *
 **********************************************************************************************/
 
+#if !defined(COMMAND_LINE_ONLY)
 #include "raylib.h"
 
 #define RAYGUI_IMPLEMENTATION
@@ -74,103 +92,473 @@
 #include "gui_window_about.h"
 
 #include "external/tinyfiledialogs.h"   // Required for: Native open/save file dialogs
+#endif
+
+#define RFXGEN_SYNTH_IMPLEMENTATION
+#include "rfxgen_synth.h"               // Required for: Wave generation from parameters (synth)
 
 #include <math.h>                       // Required for: sinf(), pow()
-#include <time.h>                       // Required for: clock()
+#include <time.h>                       // Required for: clock_gettime(), nanosleep()
 #include <stdlib.h>                     // Required for: calloc(), free()
 #include <string.h>                     // Required for: strcmp()
 #include <stdio.h>                      // Required for: FILE, fopen(), fread(), fwrite(), ftell(), fseek() fclose()
                                         // NOTE: Used on functions: LoadSound(), SaveSound(), WriteWAV()
+#include <ctype.h>                      // Required for: isspace()
+#include <pthread.h>                    // Required for: pthread_create(), pthread_join(), pthread_mutex_lock()
+#include <sys/stat.h>                   // Required for: stat(), mkdir()
+#if defined(COMMAND_LINE_ONLY)
+    #include <dirent.h>                 // Required for: opendir(), readdir(), closedir() [headless GetDirectoryFiles()]
+#endif
 
 #if defined(_WIN32)
     #include <conio.h>                  // Required for: kbhit() [Windows only, no stardard library]
+    #include <direct.h>                 // Required for: _mkdir() [Windows only]
+    #include <io.h>                     // Required for: _dup(), _dup2(), _setmode() [serve mode output]
+    #include <fcntl.h>                  // Required for: _O_BINARY [serve mode output]
 #else
-    // Provide kbhit() function in non-Windows platforms
-    #include <termios.h>
+    #include <termios.h>                // Required for: tcgetattr(), tcsetattr() [CLI playback input]
+    #include <poll.h>                   // Required for: poll() [CLI playback input]
     #include <unistd.h>
     #include <fcntl.h>
+    #include <sys/mman.h>               // Required for: mmap(), munmap() [sound bank loading]
 #endif
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
-#define VERSION_ONE                   // Enable version ONE features
+#if !defined(VERSION_ONE)
+    #define VERSION_ONE                 // Enable version ONE features
                                         // NOTE: It should be passed to compilation
-//#define COMMAND_LINE_ONLY             // Compile tool oly for command line usage
+#endif
+//#define COMMAND_LINE_ONLY             // Compile tool oly for command line usage (headless, no raylib)
+                                        // NOTE: It should be passed to compilation, raylib include depends on it
 
 #define TOOL_VERSION_TEXT    "2.0"      // Tool version string
 
-#define MAX_WAVE_SLOTS       4          // Number of wave slots for generation
+#define MAX_WAVE_SLOTS       4          // Number of wave slots for generation (waves and sounds are only allocated on first slot use)
 
-// Float random number generation
-#define frnd(range) ((float)GetRandomValue(0, 10000)/10000.0f*range)
+#define WAVE_PEAKS_BLOCK_SIZE   16      // Samples per wave peaks block (pyramid level 0)
+#define WAVE_PEAKS_MAX_LEVELS   16      // Max levels for wave peaks pyramid
 
-#if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
-bool __stdcall FreeConsole(void);       // Close console from code (kernel32.lib)
-#endif
+#define MAX_JOB_THREADS     64          // Max number of worker threads for parallel jobs (batch and explore modes)
 
-//----------------------------------------------------------------------------------
-// Types and Structures Definition
-//----------------------------------------------------------------------------------
+#define EXPLORE_MAX_CANDIDATES  64      // Max number of candidates generated on explore mode
+#define EXPLORE_GRID_COLUMNS     8      // Explore window candidates grid columns
 
-// Wave parameters type (96 bytes)
-typedef struct WaveParams {
+#define BATCH_MANIFEST_FILE  "rfxgen.manifest"  // Batch manifest file name, input files state (incremental mode)
+#define BATCH_DEPS_FILE      "rfxgen.d"         // Batch dependencies file name, Make/Ninja depfile format
+#define BATCH_SHARD_MANIFEST_FILE "rfxgen.%iof%i.manifest"  // Batch shard manifest file name (shard index, shards count)
+#define BATCH_SHARD_DEPS_FILE     "rfxgen.%iof%i.d"         // Batch shard dependencies file name (shard index, shards count)
+#define BATCH_SHARD_MANIFEST_PATTERN "rfxgen.*of*.manifest" // Batch shard manifest files pattern, used on merge
 
-    // Random seed used to generate the wave
-    int randSeed;
+#define BENCH_PRESETS        8          // Benchmark presets: all sound generation functions plus randomize
+#define BENCH_SOUNDS        32          // Benchmark sounds per preset (seeds 1..BENCH_SOUNDS)
+#define BENCH_RUNS           5          // Benchmark generations per sound
+#define BENCH_MIXER_VOICES  64          // Benchmark mixer voices capacity
+#define BENCH_MIXER_BLOCKS 2000        // Benchmark mixer blocks rendered
+#define BENCH_MIXER_FRAMES  512         // Benchmark mixer frames per block
+#define BENCH_MIXER_PLAYS    4          // Benchmark mixer voices started per block
+#define BENCH_QUALITIES      5          // Benchmark generation quality tiers
 
-    // Wave type (square, sawtooth, sine, noise)
-    int waveTypeValue;
+#define PROFILE_TRACE_FILE  "rfxgen_trace.json"   // Profile trace default file name (Chrome trace format)
+#define ANALYSIS_FILE_EXT   ".json"     // Wave analysis sidecar file extension, appended to output file name
 
-    // Wave envelope parameters
-    float attackTimeValue;
-    float sustainTimeValue;
-    float sustainPunchValue;
-    float decayTimeValue;
+#define ADPCM_BLOCK_SIZE        512     // IMA ADPCM block size per channel in bytes (WAV IMA ADPCM block layout)
+#define QOA_SLICE_LEN            20     // QOA samples per slice (per channel)
+#define QOA_SLICES_PER_FRAME    256     // QOA slices per frame (per channel)
+#define QOA_FRAME_LEN    (QOA_SLICE_LEN*QOA_SLICES_PER_FRAME)   // QOA samples per frame (per channel)
 
-    // Frequency parameters
-    float startFrequencyValue;
-    float minFrequencyValue;
-    float slideValue;
-    float deltaSlideValue;
-    float vibratoDepthValue;
-    float vibratoSpeedValue;
-    //float vibratoPhaseDelayValue;
+#define PREVIEW_LENGTH_MS       250     // Wave length generated for live preview while dragging sliders
+#define SOUND_SLOT_FRAMES_STEP 11025    // Sound slot frames allocation step (0.25 s), sounds are only reloaded when a wave does not fit
+#define SOUND_SLOT_CHANNELS       2     // Sound slot sounds channels, raylib sounds are stored in device format (32 bit float, stereo)
 
-    // Tone change parameters
-    float changeAmountValue;
-    float changeSpeedValue;
+#define PLAY_UPDATE_MS           20     // CLI playback progress update interval, input is waited (no CPU used) between updates
+#define PLAY_STREAM_FRAMES     4096     // CLI playback audio stream update frames (raylib audio stream sub-buffer size)
 
-    // Square wave parameters
-    float squareDutyValue;
-    float dutySweepValue;
+#define RENDER_CACHE_VERSION      5     // Render cache version, increase it when generated waves change
+#define RENDER_CACHE_MAX_ENTRIES 64     // Number of generated waves kept in memory by render cache
 
-    // Repeat parameters
-    float repeatSpeedValue;
+#define SOUND_BANK_VERSION      100     // Sound bank file version (.rfxb)
+#define SOUND_BANK_NAME_SIZE     48     // Sound bank max name length (including '\0')
+#define SOUND_BANK_FLAG_PCM       1     // Sound bank flag: pre-rendered PCM data included
 
-    // Phaser parameters
-    float phaserOffsetValue;
-    float phaserSweepValue;
+#define DEDUP_FRAMES             16     // Dedup fingerprint time frames (wave length split)
+#define DEDUP_BANDS               4     // Dedup fingerprint frequency bands per frame
+#define DEDUP_FINGERPRINT_SIZE  (DEDUP_FRAMES*DEDUP_BANDS)  // Dedup fingerprint values
+#define DEDUP_LSH_TABLES         16     // Dedup LSH index tables, more tables find more candidates
+#define DEDUP_LSH_BITS           12     // Dedup LSH signature bits (random hyperplanes), more bits make buckets smaller
+#define DEDUP_SIMILARITY       0.98f    // Dedup default fingerprints similarity to consider sounds duplicated
+#define DEDUP_DURATION_TOLERANCE 0.1f   // Dedup max duration difference (relative) for duplicated sounds
 
-    // Filter parameters
-    float lpfCutoffValue;
-    float lpfCutoffSweepValue;
-    float lpfResonanceValue;
-    float hpfCutoffValue;
-    float hpfCutoffSweepValue;
+#define SERVE_MAX_LINE         1024     // Serve mode max request line length (including '\0')
+#define SERVE_ID_SIZE            64     // Serve mode max request id length (including '\0')
+#define SERVE_QUEUE_SIZE        256     // Serve mode max pending requests, reading waits while queue is full
 
-} WaveParams;
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
+bool __stdcall FreeConsole(void);       // Close console from code (kernel32.lib)
+int __stdcall QueryPerformanceCounter(unsigned long long *lpPerformanceCount);     // High resolution time counter (kernel32.lib)
+int __stdcall QueryPerformanceFrequency(unsigned long long *lpFrequency);         // High resolution time counter frequency (kernel32.lib)
+void __stdcall Sleep(unsigned long dwMilliseconds);     // Suspend thread execution (kernel32.lib)
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Code file export mode (.h)
+typedef enum {
+    CODE_EXPORT_PCM = 0,            // Wave samples as array of bytes
+    CODE_EXPORT_PARAMS,             // Wave parameters, wave is generated on load by embedded synth (rfxgen_synth.h)
+    CODE_EXPORT_ADPCM               // Wave samples compressed as IMA ADPCM (4 bit), decoder included
+} CodeExportMode;
+
+// Wave file (.wav) export mode
+typedef enum {
+    WAV_EXPORT_PCM = 0,             // Wave samples as PCM (export format sample size)
+    WAV_EXPORT_ADPCM                // Wave samples compressed as IMA ADPCM (4 bit)
+} WavExportMode;
+
+// Compressed audio file format, encoded by blocks
+typedef enum {
+    AUDIO_FORMAT_NONE = 0,          // Not compressed: wave file (.wav) or code file (.h)
+    AUDIO_FORMAT_QOA,               // Quite OK Audio (.qoa), 3.2 bits per sample
+    AUDIO_FORMAT_ADPCM              // WAV IMA ADPCM (.wav), 4 bits per sample
+} AudioFormat;
+
+// IMA ADPCM encoder state: predicted sample and step index per channel, kept between blocks
+typedef struct AdpcmState {
+    int predictor[2];               // Predicted sample value
+    int index[2];                   // Step table index
+} AdpcmState;
+
+// QOA encoder LMS predictor state per channel, kept between frames
+typedef struct QoaLms {
+    int history[4];                 // Last reconstructed samples
+    int weights[4];                 // Predictor weights
+} QoaLms;
+
+// Audio encoder: compressed audio file written by blocks while samples are provided
+// NOTE: Only one block of samples is kept, file header is written on init for expected frames
+// and updated on close if a different number of frames was written
+typedef struct AudioEncoder {
+    FILE *file;                     // Output file
+    int format;                     // Compressed audio format (AudioFormat)
+    int sampleRate;                 // Output frequency
+    int channels;                   // Output channels: 1 or 2
+    int frameCount;                 // Frames declared on file header
+    int framesWritten;              // Frames encoded
+    int dataSize;                   // Encoded data size in bytes
+    int blockFrames;                // Frames per block: QOA frame or IMA ADPCM block
+    int pendingFrames;              // Frames pending to be encoded on current block
+    short *samples;                 // Block samples (16 bit, channels interleaved)
+    unsigned char *block;           // Encoded block data
+    AdpcmState adpcm;               // IMA ADPCM encoder state
+    QoaLms lms[2];                  // QOA encoder predictors state
+} AudioEncoder;
+
+// Render cache entry, generated wave for wave parameters and format
+typedef struct RenderCacheEntry {
+    unsigned long long key;         // Render key: hash of wave parameters and format
+    WaveParams params;              // Wave parameters, compared on lookup to discard hash collisions
+    int quality;                    // Generation quality (SynthQuality)
+    Wave wave;                      // Generated wave in requested format (data is NULL for empty entry)
+    WaveAnalysis analysis;          // Wave analysis measured on generation (sampleCount is 0 if not measured)
+} RenderCacheEntry;
+
+// Render cache, generated waves kept in memory and on disk (optional)
+// NOTE: Generated wave only depends on wave parameters, format and quality, they are used as cache key
+typedef struct RenderCache {
+    RenderCacheEntry entries[RENDER_CACHE_MAX_ENTRIES];  // Memory cache entries, one entry per key slot
+    char directory[256];            // Disk cache directory (empty for memory only cache)
+    int hitCount;                   // Waves retrieved from cache (memory or disk)
+    int missCount;                  // Waves generated
+    unsigned int tempCounter;       // Counter used for unique temporal file names
+    pthread_mutex_t lock;           // Render cache lock, cache is shared by worker threads
+} RenderCache;
+
+// Sound bank file header (.rfxb), all sections offsets are relative to file start
+typedef struct SoundBankHeader {
+    char signature[4];              // File signature: "rFXB"
+    unsigned short version;         // Sound bank version: SOUND_BANK_VERSION
+    unsigned short flags;           // Sound bank flags: SOUND_BANK_FLAG_PCM
+    int soundCount;                 // Sounds count
+    int tableSize;                  // Hash table size (power of two)
+    int sampleRate;                 // Pre-rendered PCM sample rate
+    int sampleSize;                 // Pre-rendered PCM sample size
+    int channels;                   // Pre-rendered PCM channels
+    int reserved;                   // Reserved for future use
+    long long entriesOffset;        // Index entries offset
+    long long tableOffset;          // Hash table offset (entry index per slot, -1 for empty slot)
+    long long paramsOffset;         // Wave parameters records offset
+    long long pcmOffset;            // Pre-rendered PCM data offset
+} SoundBankHeader;
+
+// Sound bank index entry, one per sound
+typedef struct SoundBankEntry {
+    unsigned long long nameHash;    // Sound name hash (ComputeHash64())
+    long long pcmOffset;            // Pre-rendered PCM data offset, relative to PCM data section
+    int pcmSampleCount;             // Pre-rendered PCM samples count (0 if not available)
+    int reserved;                   // Reserved for future use
+    char name[SOUND_BANK_NAME_SIZE];    // Sound name (file name without extension)
+} SoundBankEntry;
+
+// Sound bank, file data is mapped into memory and used directly (no parsing)
+typedef struct SoundBank {
+    void *data;                     // Sound bank file data (mapped or loaded)
+    long long size;                 // Sound bank file size
+    bool mapped;                    // File data is memory mapped
+    const SoundBankHeader *header;  // Sound bank header
+    const SoundBankEntry *entries;  // Sound bank index entries
+    const int *table;               // Sound bank hash table
+    const WaveParams *params;       // Sound bank wave parameters records
+    const unsigned char *pcm;       // Sound bank pre-rendered PCM data (NULL if not available)
+} SoundBank;
+
+// Job function to be called for every job index on parallel processing
+typedef void (*JobFunc)(void *userData, int index);
+
+// Jobs pool data, shared by all worker threads
+typedef struct JobPool {
+    JobFunc jobFunc;                // Job function to be called
+    void *userData;                 // User data provided to job function
+    int jobCount;                   // Number of jobs to process
+    int nextJob;                    // Next job index to process (protected by lock)
+    pthread_mutex_t lock;           // Jobs pool lock
+} JobPool;
+
+// Explore batch: wave parameters candidates generated from base parameters, rendered in parallel
+// NOTE: Candidate i is generated with seed + i, same base and seed always generate same candidates
+typedef struct ExploreBatch {
+    WaveParams base;                // Base wave parameters (mutations mode)
+    bool mutate;                    // Candidates are base mutations (or random sounds)
+    unsigned int seed;              // Candidates generation seed
+    int count;                      // Candidates count
+    int quality;                    // Candidates generation quality (SynthQuality)
+    WaveParams params[EXPLORE_MAX_CANDIDATES];  // Candidates wave parameters
+    Wave waves[EXPLORE_MAX_CANDIDATES];         // Candidates waves (WAVE_SAMPLE_RATE, 32 bit, mono), not kept on export
+    bool ready[EXPLORE_MAX_CANDIDATES];         // Candidates processed (protected by lock)
+    int readyCount;                 // Candidates processed count (protected by lock)
+    bool cancel;                    // Pending candidates are not processed (protected by lock)
+    const char *outDir;             // Candidates export directory (NULL if no export required)
+    const char *outType;            // Candidates export file type: wav, h
+    int sampleRate;                 // Candidates export sample rate
+    int sampleSize;                 // Candidates export sample size
+    int channels;                   // Candidates export channels number
+    pthread_t thread;               // Background thread rendering candidates (GUI)
+    bool threadActive;              // Background thread started
+    pthread_mutex_t lock;           // Candidates state lock
+} ExploreBatch;
+
+#if defined(VERSION_ONE) || defined(COMMAND_LINE_ONLY)
+// Batch input file state, used to check if output is up to date (incremental mode)
+typedef struct BatchFileState {
+    unsigned long long contentHash; // Input file content hash
+    unsigned long long optionsHash; // Export options hash (output format and generator version)
+    long long modTime;              // Input file modification time
+    long long fileSize;             // Input file size
+} BatchFileState;
+
+// Batch job: one input sound file to be exported
+typedef struct BatchJob {
+    char inFileName[256];           // Input file name (.rfx, .sfs)
+    char outFileName[256];          // Output file name (.wav, .h)
+    bool success;                   // Job processed successfully
+    bool upToDate;                  // Output was up to date, not exported again (incremental mode)
+    BatchFileState state;           // Input file state, saved to batch manifest
+    float duration;                 // Output wave duration in seconds, saved to batch manifest
+    long long outSize;              // Output file size, saved to batch manifest
+} BatchJob;
+
+// Batch manifest entry: input file state used to export one output file
+typedef struct BatchManifestEntry {
+    char outFileName[256];          // Output file name (without directory)
+    BatchFileState state;           // Input file state when output was exported
+    float duration;                 // Output wave duration in seconds
+    long long outSize;              // Output file size
+} BatchManifestEntry;
+
+// Batch processing data, shared by all worker threads
+typedef struct BatchConfig {
+    BatchJob *jobs;                 // Batch jobs list
+    int jobCount;                   // Batch jobs count
+    int sampleRate;                 // Output sample rate
+    int sampleSize;                 // Output sample size
+    int channels;                   // Output channels number
+    int quality;                    // Generation quality (SynthQuality)
+    bool analysis;                  // Save wave analysis sidecar file for every exported output
+    int codeMode;                   // Code file export mode (CodeExportMode)
+    int wavMode;                    // Wave file export mode (WavExportMode)
+    bool incremental;               // Incremental mode: outputs up to date are not exported again
+    BatchManifestEntry *manifest;   // Previous batch manifest entries, sorted by output file name
+    int manifestCount;              // Previous batch manifest entries count
+    long long manifestTime;         // Previous batch manifest modification time
+    int shardIndex;                 // Batch shard index (1 to shardCount)
+    int shardCount;                 // Batch shards count (0 = sharding disabled)
+} BatchConfig;
+
+// Benchmark preset: sound generation function to be measured
+typedef struct BenchPreset {
+    const char *name;                               // Preset name
+    WaveParams (*genFunc)(unsigned int seed);       // Sound generation function
+} BenchPreset;
+
+// Benchmark results for one preset (or all presets)
+typedef struct BenchResult {
+    const char *name;               // Preset name
+    int renderCount;                // Number of waves generated
+    long long sampleCount;          // Number of samples generated
+    double seconds;                 // Generation time
+    double latency[4];              // Generation latency in milliseconds: p50, p90, p99, max
+} BenchResult;
+
+// Dedup data, shared by all worker threads
+typedef struct DedupConfig {
+    BatchJob *jobs;                 // Input sound files
+    int jobCount;                   // Input sound files count
+    float (*fingerprints)[DEDUP_FINGERPRINT_SIZE];  // Sounds fingerprints (normalized)
+    float *durations;               // Sounds durations in seconds (0 if wave could not be generated)
+} DedupConfig;
+
+// Serve request type
+typedef enum {
+    SERVE_REQUEST_RENDER = 0,       // Render wave to output file, response provides file name
+    SERVE_REQUEST_PCM,              // Render wave, response provides PCM data
+    SERVE_REQUEST_PING,             // Check server is alive, responded immediately
+    SERVE_REQUEST_QUIT              // Stop reading requests, pending requests are finished
+} ServeRequestType;
+
+// Serve request: one request line, render requests are processed by worker threads
+typedef struct ServeRequest {
+    int type;                       // Request type (ServeRequestType)
+    char id[SERVE_ID_SIZE];         // Request id, provided by client and returned on response
+    char input[SERVE_MAX_LINE];     // Input: sound file name (.rfx, .sfs) or wave parameters as hex text (params:<hex>)
+    char outFileName[256];          // Output file name (.wav, .h), only for render requests
+    int sampleRate;                 // Output sample rate
+    int sampleSize;                 // Output sample size
+    int channels;                   // Output channels number
+    int quality;                    // Generation quality (SynthQuality)
+} ServeRequest;
+
+// Serve queue: render requests read from input, processed by worker threads
+// NOTE: Responses are written as requests are processed, clients match them by request id
+typedef struct ServeQueue {
+    ServeRequest *requests;         // Pending requests ring buffer, SERVE_QUEUE_SIZE requests (protected by lock)
+    int head;                       // First pending request index (protected by lock)
+    int count;                      // Pending requests count (protected by lock)
+    bool closed;                    // No more requests will be added (protected by lock)
+    pthread_mutex_t lock;           // Requests queue lock
+    pthread_cond_t notEmpty;        // Signaled when a request is added or queue is closed
+    pthread_cond_t notFull;         // Signaled when a request is removed
+    FILE *output;                   // Responses output (stdout, other output is redirected to stderr)
+    pthread_mutex_t outputLock;     // Responses output lock, every response is written at once
+} ServeQueue;
+
+#if defined(SYNTH_PROFILE)
+// Profile trace event: one measured stage event (Chrome trace complete event)
+typedef struct ProfileTraceEvent {
+    int stage;                      // Profile stage (SynthProfileStage)
+    int thread;                     // Thread index on trace (0 for main thread)
+    double startTime;               // Event start time in seconds
+    double duration;                // Event duration in seconds
+    unsigned long long count;       // Event count: waves or samples
+} ProfileTraceEvent;
+
+// Profile trace: measured events from all threads
+typedef struct ProfileTrace {
+    ProfileTraceEvent *events;      // Recorded events (protected by lock)
+    int eventCount;                 // Recorded events count (protected by lock)
+    int eventCapacity;              // Recorded events capacity (protected by lock)
+    pthread_t threads[MAX_JOB_THREADS + 1];     // Threads that recorded events, main thread first (protected by lock)
+    int threadCount;                // Threads that recorded events count (protected by lock)
+    double startTime;               // Trace start time in seconds
+    pthread_mutex_t lock;           // Trace lock
+} ProfileTrace;
+#endif
+#endif
+
+#if !defined(COMMAND_LINE_ONLY)
+// Wave regeneration slot: latest request and generated wave for one wave slot
+// NOTE: Only latest request is kept, new requests cancel previous ones (latest-wins)
+typedef struct RegenSlot {
+    WaveParams params;              // Latest requested wave parameters
+    int quality;                    // Latest requested generation quality (SynthQuality)
+    unsigned int requestId;         // Latest request id, incremented on every request
+    bool pending;                   // Latest request pending to be processed
+    bool play;                      // Latest request wave should be played when ready
+    int frameLimit;                 // Latest request max frames to generate, 0 for full wave (live preview)
+    Wave wave;                      // Generated wave ready to be swapped (data is NULL if not ready)
+    bool playWave;                  // Generated wave should be played when swapped
+    bool previewWave;               // Generated wave is a live preview (only first frames generated)
+} RegenSlot;
+
+// Wave regeneration worker, generates waves on a background thread
+typedef struct RegenWorker {
+    RegenSlot slots[MAX_WAVE_SLOTS];    // Regeneration slots, one per wave slot
+    bool running;                   // Worker thread running, cleared to stop thread
+    pthread_t thread;               // Worker thread
+    pthread_mutex_t lock;           // Regeneration slots lock
+    pthread_cond_t signal;          // Signaled on new requests or when stopping
+} RegenWorker;
+
+// Audio device loader: audio device is initialized on a background thread while window is shown
+typedef struct AudioDeviceLoader {
+    bool started;                   // Loader thread started, joined once initialization is done
+    bool done;                      // Audio device initialization done (protected by lock)
+    pthread_t thread;               // Loader thread
+    pthread_mutex_t lock;           // Done flag lock
+} AudioDeviceLoader;
+
+// Sound slot: double-buffered sounds for one wave slot, loaded on first update and sized to wave length
+// NOTE: New waves are copied in place into back sound while front sound could be read by audio mixer
+typedef struct SoundSlot {
+    Sound sounds[2];                // Front and back sounds, reloaded only when a wave does not fit
+    int capacity[2];                // Allocated frames on every sound (0 if not loaded)
+    int frameCount[2];              // Valid frames on every sound, remaining frames are silence
+    int front;                      // Front sound index, sound to be played
+    float *buffer;                  // Staging buffer (max sounds capacity), wave data in sounds format padded with silence
+    int bufferCapacity;             // Staging buffer allocated frames (SOUND_SLOT_CHANNELS samples per frame)
+    float volume;                   // Sounds volume, applied on sounds loading
+    double stopTime;                // Playback stop time, sound buffers are longer than wave
+} SoundSlot;
+
+// Parameters history: undo/redo steps for one wave slot, only changed parameters are stored
+// NOTE: Every step is stored as [mask][xor values of changed fields][mask], xor values are valid in both
+// directions and mask is repeated at step end to walk history backwards (a slider change takes 12 bytes)
+typedef struct ParamsHistory {
+    unsigned int *data;             // Steps data (32 bit words)
+    int position;                   // Current position (words), steps after it can be redone
+    int size;                       // Steps data size (words)
+    int capacity;                   // Steps data allocated size (words)
+} ParamsHistory;
+
+// Wave peaks: min/max pyramid of wave samples, used for wave drawing
+// NOTE: Level 0 keeps min/max for every WAVE_PEAKS_BLOCK_SIZE samples, every next level halves blocks count
+typedef struct WavePeaks {
+    const float *samples;           // Wave samples (not owned), used for ranges smaller than peaks blocks
+    int sampleCount;                // Wave samples count
+    int levelCount;                 // Pyramid levels count
+    int blockCount[WAVE_PEAKS_MAX_LEVELS];      // Blocks count for every level
+    float *minValues[WAVE_PEAKS_MAX_LEVELS];    // Blocks min values for every level
+    float *maxValues[WAVE_PEAKS_MAX_LEVELS];    // Blocks max values for every level
+    float *values;                  // Values buffer for all levels
+} WavePeaks;
+#endif
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
 
+#if !defined(COMMAND_LINE_ONLY)
 // Volume parameters
 static float volumeValue = 0.6f;        // Volume
 
 // Export WAV variables
 static int wavSampleSize = 16;          // Wave sample size in bits (bitrate)
 static int wavSampleRate = 44100;       // Wave sample rate (frequency)
+#endif
+
+// Render cache, shared by GUI and CLI generation
+static RenderCache renderCache = { 0 };
 
 #if defined(VERSION_ONE) && !defined(COMMAND_LINE_ONLY)
 // raygui style palettes
@@ -253,42 +641,186 @@ static const int paletteStyle[3][20] = {
 #if defined(VERSION_ONE) || defined(COMMAND_LINE_ONLY)
 static void ShowCommandLineInfo(void);                      // Show command line usage info
 static void ProcessCommandLine(int argc, char *argv[]);     // Process command line input
+
+// Batch processing functions
+static BatchJob *LoadBatchJobs(const char *input, const char *outDir, const char *outExt, int *jobCount);   // Load batch jobs from directory, pattern or list file
+static int SelectBatchShard(BatchJob *jobs, int jobCount, int shardIndex, int shardCount);    // Select batch jobs on shard (output file name hash), returns selected jobs count
+static void ProcessBatchJob(void *userData, int index);     // Process one batch job: load, generate, format and export
+static bool IsBatchJobUpToDate(BatchConfig *config, BatchJob *job);     // Check if batch job output is up to date (incremental mode)
+static unsigned long long GetBatchOptionsHash(const BatchConfig *config);   // Get batch export options hash, saved to batch manifest
+static int CompareBatchManifestEntries(const void *a, const void *b);   // Compare batch manifest entries by output file name (qsort, bsearch)
+static BatchManifestEntry *LoadBatchManifest(const char *fileName, int *count, long long *modTime);    // Load batch manifest, entries sorted by output file name
+static void SaveBatchManifest(const char *fileName, BatchConfig config);            // Save batch manifest for exported and up to date outputs
+static bool SaveBatchManifestEntries(const char *fileName, const BatchManifestEntry *entries, int count);  // Save batch manifest entries, one line per output
+static void MergeBatchManifests(const char *input, const char *outFileName);        // Merge batch shard manifests into one manifest
+static void SaveBatchDependencies(const char *fileName, BatchConfig config);        // Save batch dependencies file (Make/Ninja depfile)
+static bool GetFileContentHash(const char *fileName, unsigned long long *hash);     // Get file content hash, returns false if file can not be read
+
+// Benchmark functions
+static void RunBenchmark(const char *jsonFileName);         // Run synthesis benchmark over a fixed sounds corpus, results saved as JSON
+static void GetBenchLatencies(double *values, int count, double *percentiles);  // Get benchmark latency percentiles: p50, p90, p99 and max
+static int CompareDoubleValues(const void *a, const void *b);   // Compare double values (qsort)
+static double GetPreciseTime(void);                         // Get high resolution time in seconds (no window required)
+
+static void PackSoundBank(const char *input, const char *fileName, bool pcm, int sampleRate, int sampleSize, int channels, int quality);  // Pack sound files into a sound bank file (.rfxb)
+static void UnpackSoundBank(const char *fileName, const char *outDir);  // Unpack sound bank file (.rfxb) into sound files (.rfx)
+static void ShowSoundBankInfo(const char *fileName);        // Show sound bank info: sounds names, duration and pre-rendered PCM
+
+// Dedup functions
+static void RunDedup(const char *input, const char *outFileName, float similarity, int threadCount);   // Find near-duplicate sounds using fingerprints LSH index
+static void ProcessDedupJob(void *userData, int index);     // Process one dedup job: load sound, generate wave and compute fingerprint
+static void ComputeWaveFingerprint(Wave wave, float *fingerprint);  // Compute wave fingerprint: bands loudness envelope (normalized)
+static float GetFingerprintSimilarity(const float *a, const float *b);  // Get fingerprints similarity (cosine)
+static int CompareDedupBuckets(const void *a, const void *b);   // Compare dedup LSH buckets entries (qsort)
+static int CompareBatchJobs(const void *a, const void *b);  // Compare batch jobs by input file name (qsort)
+
+// Serve functions
+static void RunServe(int sampleRate, int sampleSize, int channels, int quality, int threadCount);  // Serve render requests from stdin until closed (line protocol)
+static const char *ParseServeRequest(const char *line, ServeRequest *request);  // Parse serve request line, returns error message (NULL if valid)
+static void *ServeWorkerThread(void *arg);                  // Serve worker thread: process queued requests until queue closed
+static void ProcessServeRequest(ServeQueue *queue, ServeRequest *request);  // Process render request: generate wave and send response
+static bool LoadServeParams(const char *input, WaveParams *params);    // Load wave parameters from serve request input (file or hex text)
+static void SendServeResponse(ServeQueue *queue, const char *id, const char *text, const void *data, int dataSize);   // Send response line (and data)
+
+#if defined(SYNTH_PROFILE)
+// Profile functions
+static void InitProfileTrace(ProfileTrace *trace);          // Init profile trace, synth profile events are recorded
+static void CloseProfileTrace(ProfileTrace *trace);         // Close profile trace, events recording stopped
+static void RecordProfileTraceEvent(int stage, double startTime, double duration, unsigned long long count, void *userData);   // Record synth profile event into trace (any thread)
+static void ShowProfileSummary(ProfileTrace *trace);        // Show profile summary table: stages count and time
+static void SaveProfileTrace(ProfileTrace *trace, const char *fileName);    // Save profile trace as Chrome trace file (.json)
+#endif
+#endif
+
+// Parallel jobs functions
+static void RunJobsParallel(JobFunc jobFunc, void *userData, int jobCount, int threadCount);   // Run jobs on a pool of worker threads
+static int GetCpuCoreCount(void);                           // Get number of available cpu cores
+
+// Explore functions
+static void InitExploreBatch(ExploreBatch *batch, WaveParams base, bool mutate, unsigned int seed, int count);    // Init explore batch, candidates parameters generated
+static void CloseExploreBatch(ExploreBatch *batch);         // Close explore batch, background rendering is cancelled
+static void ProcessExploreJob(void *userData, int index);   // Process one explore candidate: generate and export (optional)
+#if !defined(COMMAND_LINE_ONLY)
+static bool IsExploreCandidateReady(ExploreBatch *batch, int index);    // Check if explore candidate has been processed (GUI)
+static void StartExploreBatch(ExploreBatch *batch);         // Start explore batch rendering on a background thread (GUI)
+static void *ExploreBatchThread(void *arg);                 // Explore batch background thread, candidates rendered on jobs pool (GUI)
 #endif
 
-// Load/Save/Export data functions
-static WaveParams LoadWaveParams(const char *fileName);                 // Load wave parameters from file
-static void SaveWaveParams(WaveParams params, const char *fileName);    // Save wave parameters to file
-static void ResetWaveParams(WaveParams *params);                        // Reset wave parameters
-static Wave GenerateWave(WaveParams params);                            // Generate wave data from parameters
+// Render cache functions
+static bool InitRenderCache(const char *directory);                     // Init render cache, disk cache enabled if directory provided (fails if path too long)
+static void CloseRenderCache(void);                                     // Close render cache, unload cached waves
+static Wave GenerateWaveCached(WaveParams params, int sampleRate, int sampleSize, int channels, int quality, WaveAnalysis *analysis);   // Generate wave in desired format and quality, using render cache
+static bool GetRenderCacheWave(WaveParams params, int sampleRate, int sampleSize, int channels, int quality, Wave *wave, WaveAnalysis *analysis);  // Get wave copy from render cache memory, returns false if not cached
+static void AddRenderCacheWave(WaveParams params, int quality, Wave wave, const WaveAnalysis *analysis);     // Add wave copy to render cache memory
+static unsigned long long GetRenderCacheKey(WaveParams params, int sampleRate, int sampleSize, int channels, int quality);   // Get render cache key for parameters, format and quality
+static Wave LoadRenderCacheFile(const char *fileName, WaveParams params, int sampleRate, int sampleSize, int channels, int quality, WaveAnalysis *analysis);   // Load wave from render cache file (.rfxc)
+static void SaveRenderCacheFile(const char *fileName, WaveParams params, int quality, Wave wave, WaveAnalysis analysis);   // Save wave to render cache file (.rfxc)
+static unsigned long long ComputeHash64(const void *data, int size, unsigned long long hash);   // Compute FNV-1a 64 bit hash, data added to provided hash
+
+// Sound bank functions
+static SoundBank LoadSoundBank(const char *fileName);                   // Load sound bank file (.rfxb), file is memory mapped
+static void UnloadSoundBank(SoundBank bank);                            // Unload sound bank
+static bool SaveSoundBank(const char *fileName, const char **names, const WaveParams *params, int count, bool pcm, int sampleRate, int sampleSize, int channels, int quality);  // Save sound bank file (.rfxb)
+static int GetSoundBankIndex(SoundBank *bank, const char *name);        // Get sound index from sound bank by name (hash lookup), returns -1 if not found
+static WaveParams GetSoundBankParams(SoundBank *bank, int index);       // Get wave parameters from sound bank
+static Wave GetSoundBankWave(SoundBank *bank, int index);               // Get pre-rendered wave from sound bank (zero-copy, owned by bank)
 
+#if !defined(COMMAND_LINE_ONLY)
 static WaveParams DialogLoadSound(void);        // Show dialog: load sound parameters file
 static void DialogSaveSound(WaveParams params); // Show dialog: save sound parameters file
-static void DialogExportWave(Wave wave);        // Show dialog: export current sound as .wav
-
-// Sound generation functions
-static WaveParams GenPickupCoin(void);      // Generate sound: Pickup/Coin
-static WaveParams GenLaserShoot(void);      // Generate sound: Laser shoot
-static WaveParams GenExplosion(void);       // Generate sound: Explosion
-static WaveParams GenPowerup(void);         // Generate sound: Powerup
-static WaveParams GenHitHurt(void);         // Generate sound: Hit/Hurt
-static WaveParams GenJump(void);            // Generate sound: Jump
-static WaveParams GenBlipSelect(void);      // Generate sound: Blip/Select
-static WaveParams GenRandomize(void);       // Generate random sound
-static void WaveMutate(WaveParams *params); // Mutate current sound
+static void DialogExportWave(WaveParams params);    // Show dialog: export current sound as .wav or .qoa
+#endif
+static void ExportWaveFile(Wave wave, const char *fileName, int codeMode, int wavMode);  // Export wave as audio file (.wav, .qoa) or code file (.h), measured on profile
+static int ExportWaveStream(WaveParams params, int sampleRate, int channels, int quality, const char *fileName, int format, WaveAnalysis *analysis);   // Export wave as compressed audio file, encoded by blocks while generated
+static void ExportWaveCompressed(Wave wave, const char *fileName, int format);  // Export wave data as compressed audio file (.qoa, .wav IMA ADPCM)
+static int GetAudioFormat(const char *fileName, int wavMode);           // Get compressed audio format for output file (AUDIO_FORMAT_NONE if not compressed)
+static void ExportWaveParamsAsCode(WaveParams params, int sampleRate, int sampleSize, int channels, int quality, const char *fileName);   // Export wave parameters to code (.h), wave generated on load
+static void ExportWaveAsCodeAdpcm(Wave wave, const char *fileName);     // Export wave data to code (.h), compressed as IMA ADPCM with decoder
+static void GetCodeVarName(const char *fileName, char *varName);        // Get code variables name from file name (uppercase, no extension)
+
+static void SaveWaveAnalysis(WaveAnalysis analysis, Wave wave, const char *waveFileName);    // Save wave analysis sidecar file (.json) for exported wave file
+
+// IMA ADPCM functions
+static int GetAdpcmBlockFrames(int channels);                           // Get frames per IMA ADPCM block (ADPCM_BLOCK_SIZE per channel)
+static void EncodeAdpcmBlock(AdpcmState *state, const short *samples, int frameCount, int channels, unsigned char *block);   // Encode frames into one IMA ADPCM block
+static long long EncodeAdpcmChannel(AdpcmState *state, int channel, const short *samples, int frameCount, int channels, unsigned char *block);   // Encode one channel block samples, returns squared error
+static void GetWaveSamples16(Wave wave, int frame, int frameCount, int channels, short *samples);  // Get wave frames as 16 bit samples, mono wave copied to all channels
+
+// Compressed audio encoder functions (QOA, WAV IMA ADPCM)
+static bool InitAudioEncoder(AudioEncoder *encoder, const char *fileName, int format, int sampleRate, int channels, int frameCount);  // Init audio encoder, file header written for expected frames
+static void WriteAudioEncoder(AudioEncoder *encoder, const short *samples, int frameCount);   // Write frames to audio encoder, encoded as blocks are completed
+static int CloseAudioEncoder(AudioEncoder *encoder);                    // Close audio encoder, last block encoded and header updated, returns frames written
+static void FlushAudioEncoder(AudioEncoder *encoder);                   // Encode pending frames as one block and write it to file
+static void WriteAudioEncoderHeader(AudioEncoder *encoder);             // Write compressed audio file header for declared frames
+static int EncodeQoaFrame(QoaLms *lms, const short *samples, int frameCount, int channels, int sampleRate, unsigned char *frame);   // Encode frames into one QOA frame, returns frame size
+static void WriteQoaValue(unsigned char *data, int *position, unsigned long long value);     // Write 64 bit value to QOA data (big endian)
+
+#if defined(COMMAND_LINE_ONLY)
+// Headless functions, raylib functions replacements (raylib is not linked on COMMAND_LINE_ONLY)
+static bool IsFileExtension(const char *fileName, const char *ext);     // Check file extension (including dot)
+static const char *GetFileName(const char *filePath);                   // Get pointer to file name for a path
+static char **SplitText(char *text, char delimiter, int *strCount);     // Split text into multiple strings (memory allocated)
+static char **GetDirectoryFiles(const char *dirPath, int *count);       // Get file names in a directory path (memory allocated)
+static void ClearDirectoryFiles(void);                                  // Clear directory file names
+static Wave LoadWave(const char *fileName);                             // Load wave data from file (.wav, PCM 8/16 bit or 32 bit float)
+static Wave WaveCopy(Wave wave);                                        // Copy a wave to a new wave
+static void WaveFormat(Wave *wave, int sampleRate, int sampleSize, int channels);   // Convert wave data to desired format
+static void ExportWave(Wave wave, const char *fileName);                // Export wave data to file (.wav)
+static void ExportWaveAsCode(Wave wave, const char *fileName);          // Export wave sample data to code (.h)
+#endif
 
 #if !defined(COMMAND_LINE_ONLY)
+// Wave regeneration functions (GUI)
+static void InitRegenWorker(RegenWorker *worker);           // Init wave regeneration worker thread
+static void CloseRegenWorker(RegenWorker *worker);          // Close wave regeneration worker, in-flight generation is cancelled
+static void RequestRegenWave(RegenWorker *worker, int slot, WaveParams params, int quality, bool play, int frameLimit);   // Request wave regeneration for slot (latest-wins)
+static bool GetRegenWave(RegenWorker *worker, int slot, Wave *wave, bool *play, bool *preview);             // Get generated wave for slot if ready
+static void *RegenWorkerThread(void *arg);                  // Wave regeneration worker thread
+
+// Audio device loader functions (GUI)
+static void InitAudioDeviceAsync(AudioDeviceLoader *loader);    // Init audio device on a background thread
+static bool IsAudioDeviceLoaded(AudioDeviceLoader *loader);     // Check if audio device initialization is done (sounds can be loaded)
+static void CloseAudioDeviceAsync(AudioDeviceLoader *loader);   // Close audio device, waiting for initialization if required
+static void *AudioDeviceLoaderThread(void *arg);                // Audio device loader thread
+
+// Sound slot functions (GUI)
+static void InitSoundSlot(SoundSlot *slot);                 // Init sound slot, sounds are loaded on first update
+static void CloseSoundSlot(SoundSlot *slot);                // Close sound slot
+static void UpdateSoundSlot(SoundSlot *slot, Wave wave);    // Update sound slot with new wave, copied in place into back sound (reloaded if required)
+static void PlaySoundSlot(SoundSlot *slot);                 // Play sound slot front sound, stopped by time at wave end
+static void UpdateSoundSlotPlayback(SoundSlot *slot);       // Update sound slot playback, stopping it once wave has been played
+static void SetSoundSlotVolume(SoundSlot *slot, float volume);  // Set sound slot volume (also for sounds loaded later)
+
+// Parameters history functions (GUI)
+static void PushParamsHistory(ParamsHistory *history, WaveParams prev, WaveParams params);  // Add parameters change step, steps to redo are discarded
+static bool UndoParamsHistory(ParamsHistory *history, WaveParams *params);  // Undo last parameters change step
+static bool RedoParamsHistory(ParamsHistory *history, WaveParams *params);  // Redo next parameters change step
+static void UnloadParamsHistory(ParamsHistory *history);    // Unload parameters history
+static void ApplyParamsHistoryStep(const unsigned int *step, WaveParams *params);   // Apply history step xor values to parameters
+static int GetParamsHistoryStepSize(unsigned int mask);     // Get history step size (words) from step mask
+
+// Wave peaks functions (GUI)
+static WavePeaks LoadWavePeaks(Wave wave);                  // Load wave peaks (min/max pyramid) from wave
+static void UnloadWavePeaks(WavePeaks peaks);               // Unload wave peaks
+static void GetWavePeaksRange(WavePeaks *peaks, int start, int end, float *min, float *max);  // Get wave peaks min/max values for samples range
+
 // Auxiliar functions
-static void DrawWave(Wave *wave, Rectangle bounds, Color color);    // Draw wave data using lines
+static void DrawWave(WavePeaks *peaks, Rectangle bounds, Color color);   // Draw wave peaks using one line per column
 #endif
 
 #if defined(VERSION_ONE) || defined(COMMAND_LINE_ONLY)
-static void WaitTime(int ms);               // Simple time wait in milliseconds
+#if !defined(COMMAND_LINE_ONLY)
 static void PlayWaveCLI(Wave wave);         // Play provided wave through CLI
-
-#if !defined(_WIN32)
-static int kbhit(void);                         // Check if a key has been pressed
-static char getch(void) { return getchar(); }   // Get pressed character
+static void PlayWaveParamsCLI(WaveParams params, int quality);  // Play sound generated from parameters through CLI, streamed while generated
+static void InitPlaybackInput(void);        // Init console input for playback: no line buffering, no echo
+static void ClosePlaybackInput(void);       // Restore console input after playback
+static bool WaitPlaybackInput(int ms);      // Wait for playback stop key (ENTER, ESCAPE) up to ms milliseconds, no CPU used
+static void PrintPlaybackProgress(float timeMs, float totalTimeMs, int *prevPercent);   // Print console playback time bar (if changed)
 #endif
+
+static bool MatchFilePattern(const char *fileName, const char *pattern);  // Check if file name matches wildcard pattern (*, ?)
+static void MakeDirectory(const char *dirPath);                           // Create directory if it does not exist
+
 #endif  // defined(COMMAND_LINE_ONLY)
 
 //------------------------------------------------------------------------------------
@@ -302,9 +834,7 @@ int main(int argc, char *argv[])
     //--------------------------------------------------------------------------------------
     if (argc > 1)
     {
-        if ((argc == 2) &&
-            (strcmp(argv[1], "-h") != 0) &&
-            (strcmp(argv[1], "--help") != 0))       // One argument (file dropped over executable?)
+        if ((argc == 2) && (argv[1][0] != '-'))     // One argument (file dropped over executable?)
         {
             if (IsFileExtension(argv[1], ".rfx") ||
                 IsFileExtension(argv[1], ".sfs"))
@@ -312,7 +842,7 @@ int main(int argc, char *argv[])
                 strcpy(inFileName, argv[1]);        // Read input filename to open with gui interface
             }
         }
-#if defined(VERSION_ONE)
+#if defined(VERSION_ONE) || defined(COMMAND_LINE_ONLY)
         else
         {
             ProcessCommandLine(argc, argv);
@@ -321,7 +851,10 @@ int main(int argc, char *argv[])
 #endif      // VERSION_ONE
     }
 
-#if !defined(COMMAND_LINE_ONLY)
+#if defined(COMMAND_LINE_ONLY)
+    // Headless tool: no gui available, usage info is shown
+    ShowCommandLineInfo();
+#else
 #if (defined(VERSION_ONE) && (defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)))
     // WARNING (Windows): If program is compiled as Window application (instead of console),
     // no console is available to show output info... solution is compiling a console application
@@ -339,7 +872,15 @@ int main(int argc, char *argv[])
     InitWindow(screenWidth, screenHeight, FormatText("rFXGen v%s - A simple and easy-to-use fx sounds generator", TOOL_VERSION_TEXT));
     //SetExitKey(0);
 
-    InitAudioDevice();
+    AudioDeviceLoader audioLoader = { 0 };
+    InitAudioDeviceAsync(&audioLoader); // Audio device is initialized on background, window is shown meanwhile
+    bool audioReady = false;            // Audio device ready, sounds can be loaded and played
+    bool audioPlayPending = false;      // Active slot play requested before audio device was ready
+
+    InitRenderCache(NULL);          // Memory only render cache, unchanged sounds are not generated again
+
+    RegenWorker regenWorker = { 0 };
+    InitRegenWorker(&regenWorker);  // Waves are generated on a background thread, UI never waits for them
 
     // rFXGen Layout: controls initialization
     //----------------------------------------------------------------------------------------
@@ -347,8 +888,14 @@ int main(int argc, char *argv[])
     
     bool playOnChangeChecked = true;
 
+    Rectangle slidersRec = { 243, 48, 102, 362 };   // Sliders bounds, used to detect sliders changes
+    WaveParams previewParams = { 0 };               // Wave parameters of latest live preview
+    bool previewActive = false;                     // Live preview active, sliders are being dragged
+
     const char *waveTypeTextList[4] = { "Square", "Sawtooth", "Sinewave", "Noise" };
-    const char *slotTextList[4] = { "1", "2", "3", "4" };
+    char slotTexts[MAX_WAVE_SLOTS][4] = { 0 };
+    const char *slotTextList[MAX_WAVE_SLOTS] = { 0 };
+    for (int i = 0; i < MAX_WAVE_SLOTS; i++) { sprintf(slotTexts[i], "%i", i + 1); slotTextList[i] = slotTexts[i]; }
     
     const char *sampleRateTextList[2] = { "22050 Hz", "44100 Hz" };
     int sampleRateActive = 1;
@@ -358,6 +905,9 @@ int main(int argc, char *argv[])
     int fileTypeActive = 0;
     const char *visualStyleTextList[3] = { "Light", "Dark", "Candy" };
     int visualStyleActive = 0;
+    const char *qualityTextList[5] = { "Draft 1x", "Low 2x", "Good 4x", "Final 8x", "Adaptive" };
+    const int qualityValues[5] = { SYNTH_QUALITY_DRAFT, SYNTH_QUALITY_LOW, SYNTH_QUALITY_MEDIUM, SYNTH_QUALITY_FINAL, SYNTH_QUALITY_ADAPTIVE };
+    int qualityActive = 3;
     
     bool screenSizeActive = false;
     
@@ -371,59 +921,87 @@ int main(int argc, char *argv[])
     GuiWindowAboutState windowAboutState = InitGuiWindowAbout();
     //----------------------------------------------------------------------------------------
 
+    // Explore Window Layout: controls initialization
+    //----------------------------------------------------------------------------------------
+    bool exploreActive = false;                 // Explore window active
+    bool exploreRestart = false;                // Explore candidates generation required
+    bool exploreUse = false;                    // Explore selected candidate copy to active slot required
+    bool exploreRedraw = false;                 // Explore thumbnails redrawing required
+    int exploreSelected = -1;                   // Explore selected candidate (-1 if none)
+    int exploreReadyCount = 0;                  // Explore candidates ready to be played
+
+    const char *exploreModeTextList[2] = { "Mutate", "Randomize" };
+    int exploreModeActive = 0, prevExploreModeActive = 0;
+
+    Rectangle exploreRec = { 6, 24, 484, 446 };         // Explore window bounds
+    Rectangle exploreGridRec = { 16, 84, 464, 360 };    // Explore candidates grid bounds
+    const int exploreCellWidth = exploreGridRec.width/EXPLORE_GRID_COLUMNS;
+    const int exploreCellHeight = exploreGridRec.height/(EXPLORE_MAX_CANDIDATES/EXPLORE_GRID_COLUMNS);
+
+    ExploreBatch exploreBatch = { 0 };          // Explore candidates, rendered on a background jobs pool
+    WavePeaks explorePeaks[EXPLORE_MAX_CANDIDATES] = { 0 };     // Explore candidates peaks for thumbnails
+    bool explorePeaksReady[EXPLORE_MAX_CANDIDATES] = { 0 };     // Explore candidates peaks computed
+
+    // NOTE: Explore thumbnails are only redrawn when candidates or colors change, texture is loaded on first use
+    RenderTexture2D exploreTarget = { 0 };
+    //----------------------------------------------------------------------------------------
+
     // Wave parameters
     WaveParams params[MAX_WAVE_SLOTS] = { 0 }; // Wave parameters for generation
-    Wave wave[MAX_WAVE_SLOTS] = { 0 };
-    Sound sound[MAX_WAVE_SLOTS] = { 0 };
+    Wave wave[MAX_WAVE_SLOTS] = { 0 };        // Generated waves, slot wave is generated on first slot use
+    SoundSlot sound[MAX_WAVE_SLOTS] = { 0 };  // Sounds are loaded on first wave update, updated in place on wave changes
+    WavePeaks wavePeaks[MAX_WAVE_SLOTS] = { 0 };  // Wave peaks for drawing, computed on wave changes
+    bool waveRequested[MAX_WAVE_SLOTS] = { 0 };   // Slot wave generation requested at least once
+    ParamsHistory history[MAX_WAVE_SLOTS] = { 0 };    // Parameters undo/redo history, only changes are stored
+    WaveParams historyParams[MAX_WAVE_SLOTS] = { 0 }; // Parameters at history current position
 
     for (int i = 0; i < MAX_WAVE_SLOTS; i++)
     {
         // Reset generation parameters
         // NOTE: Random seed for generation is set
         ResetWaveParams(&params[i]);
+        params[i].randSeed = GetRandomValue(0x1, 0xFFFE);
 
-        // Default wave values
-        wave[i].sampleRate = 44100;
-        wave[i].sampleSize = 32;       // 32 bit -> float
-        wave[i].channels = 1;
-        wave[i].sampleCount = 10*wave[i].sampleRate*wave[i].channels;    // Max sampleCount for 10 seconds
-        wave[i].data = calloc(wave[i].sampleCount*wave[i].channels*wave[i].sampleSize/8, sizeof(char));
-
-        sound[i] = LoadSoundFromWave(wave[i]);
+        InitSoundSlot(&sound[i]);
     }
 
+    SoundSlot exploreSound = { 0 };             // Explore selected candidate sound
+    InitSoundSlot(&exploreSound);
+
     // Check if a wave parameters file has been provided on command line
-    if (inFileName[0] != '\0')
-    {
-        params[0] = LoadWaveParams(inFileName); // Load wave parameters from .rfx
-        UnloadWave(wave[0]);
-        wave[0] = GenerateWave(params[0]);      // Generate wave from parameters
-        UnloadSound(sound[0]);
-        sound[0] = LoadSoundFromWave(wave[0]);  // Load sound from new wave
-        PlaySound(sound[0]);                    // Play generated sound
-    }
+    if (inFileName[0] != '\0') params[0] = LoadWaveParamsEx(inFileName, &volumeValue);    // Load wave parameters from .rfx/.sfs
+
+    for (int i = 0; i < MAX_WAVE_SLOTS; i++) historyParams[i] = params[i];
+
+    // Only active slot wave is generated on startup (on background), provided sound is played once ready
+    RequestRegenWave(&regenWorker, 0, params[0], qualityValues[qualityActive], (inFileName[0] != '\0'), 0);
+    waveRequested[0] = true;
     
     float prevVolumeValue = volumeValue;
     int prevWaveTypeValue[MAX_WAVE_SLOTS] = { params[0].waveTypeValue };
     int prevVisualStyleActive = visualStyleActive;
+    int prevQualityActive = qualityActive;
     bool regenerate = false;                    // Wave regeneration required
     int prevSlotActive = 0, slotActive = 0;     // Wave slot tracking
 
     Rectangle waveRec = { 10, 416, 475, 50 };   // Wave drawing rectangle box
     
     // Set default sound volume
-    for (int i = 0; i < MAX_WAVE_SLOTS; i++) SetSoundVolume(sound[i], volumeValue);
+    for (int i = 0; i < MAX_WAVE_SLOTS; i++) SetSoundSlotVolume(&sound[i], volumeValue);
+    SetSoundSlotVolume(&exploreSound, volumeValue);
 
 #define RENDER_WAVE_TO_TEXTURE
 #if defined(RENDER_WAVE_TO_TEXTURE)
     // To avoid enabling MSXAAx4, we will render wave to a texture x2
-    RenderTexture2D waveTarget = LoadRenderTexture(waveRec.width*2, waveRec.height*2);
+    // NOTE: Wave texture is only redrawn when wave or colors change, texture is loaded with first wave
+    RenderTexture2D waveTarget = { 0 };
 #endif
+    bool waveRedraw = true;                     // Wave redrawing required
+    int prevWaveColors[2] = { 0 };              // Wave drawing colors tracking (background, lines)
 
     // Render texture to draw full screen, enables screen scaling
-    // NOTE: If screen is scaled, mouse input should be scaled proportionally
-    RenderTexture2D screenTarget = LoadRenderTexture(512, 512);
-    SetTextureFilter(screenTarget.texture, FILTER_POINT);
+    // NOTE: If screen is scaled, mouse input should be scaled proportionally, texture is loaded on first scaling
+    RenderTexture2D screenTarget = { 0 };
 
     SetTargetFPS(60);
     //----------------------------------------------------------------------------------------
@@ -442,7 +1020,7 @@ int main(int argc, char *argv[])
             if (IsFileExtension(droppedFiles[0], ".rfx") ||
                 IsFileExtension(droppedFiles[0], ".sfs"))
             {
-                params[slotActive] = LoadWaveParams(droppedFiles[0]);
+                params[slotActive] = LoadWaveParamsEx(droppedFiles[0], &volumeValue);
                 regenerate = true;
 
                 //SetWindowTitle(FormatText("rFXGen v%s - %s", TOOL_VERSION_TEXT, GetFileName(droppedFiles[0])));
@@ -454,29 +1032,167 @@ int main(int argc, char *argv[])
 
         // Keyboard shortcuts
         //------------------------------------------------------------------------------------
-        if (IsKeyPressed(KEY_SPACE)) PlaySound(sound[slotActive]);  // Play current sound
+        if (IsKeyPressed(KEY_SPACE) && !exploreActive) PlaySoundSlot(&sound[slotActive]);    // Play current sound
         if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_S)) DialogSaveSound(params[slotActive]);  // Show dialog: save sound (.rfx)
         if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_O))     // Show dialog: load sound (.rfx, .sfs)
         {
             params[slotActive] = DialogLoadSound();
             regenerate = true;
         }
-        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_E)) DialogExportWave(wave[slotActive]); // Show dialog: export wave (.wav)
+        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_E)) DialogExportWave(params[slotActive]); // Show dialog: export wave (.wav)
+
+        // Undo (Ctrl+Z) / redo (Ctrl+Y, Ctrl+Shift+Z) active slot parameters changes
+        // NOTE: Previous waves are usually reused from render cache, no generation required
+        if (IsKeyDown(KEY_LEFT_CONTROL) && (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_Y)) && !exploreActive)
+        {
+            bool redo = IsKeyPressed(KEY_Y) || IsKeyDown(KEY_LEFT_SHIFT);
+
+            // Changes not yet added to history are added first, they can be redone
+            PushParamsHistory(&history[slotActive], historyParams[slotActive], params[slotActive]);
+
+            if (redo? RedoParamsHistory(&history[slotActive], &params[slotActive]) : UndoParamsHistory(&history[slotActive], &params[slotActive]))
+            {
+                historyParams[slotActive] = params[slotActive];
+                prevWaveTypeValue[slotActive] = params[slotActive].waveTypeValue;
+                regenerate = true;
+            }
+        }
 
         if (IsKeyPressed(KEY_F1)) windowAboutState.active = !windowAboutState.active;
+        if (IsKeyPressed(KEY_F2)) { exploreActive = !exploreActive; exploreRestart = exploreActive; }
+        //----------------------------------------------------------------------------------
+
+        // Explore window logic
+        //----------------------------------------------------------------------------------
+        if (exploreActive)
+        {
+            if (exploreTarget.id == 0) exploreTarget = LoadRenderTexture(exploreGridRec.width, exploreGridRec.height);
+
+            if (exploreModeActive != prevExploreModeActive) exploreRestart = true;
+            prevExploreModeActive = exploreModeActive;
+
+            // Generate new candidates from active slot sound, previous candidates rendering is cancelled
+            if (exploreRestart)
+            {
+                if (exploreBatch.count > 0) CloseExploreBatch(&exploreBatch);
+
+                for (int i = 0; i < EXPLORE_MAX_CANDIDATES; i++)
+                {
+                    if (explorePeaksReady[i]) UnloadWavePeaks(explorePeaks[i]);
+                    explorePeaksReady[i] = false;
+                }
+
+                InitExploreBatch(&exploreBatch, params[slotActive], (exploreModeActive == 0), GetRandomValue(0x1, 0xFFFE), EXPLORE_MAX_CANDIDATES);
+                exploreBatch.quality = qualityValues[qualityActive];
+                StartExploreBatch(&exploreBatch);
+
+                exploreSelected = -1;
+                exploreReadyCount = 0;
+                exploreRedraw = true;
+                exploreRestart = false;
+            }
+
+            // Load thumbnails peaks for candidates rendered since last frame
+            for (int i = 0; i < exploreBatch.count; i++)
+            {
+                if (!explorePeaksReady[i] && IsExploreCandidateReady(&exploreBatch, i))
+                {
+                    explorePeaks[i] = LoadWavePeaks(exploreBatch.waves[i]);
+                    explorePeaksReady[i] = true;
+                    exploreReadyCount++;
+                    exploreRedraw = true;
+                }
+            }
+
+            // Select candidate with mouse or arrow keys, selected candidate is played
+            int selected = exploreSelected;
+            Vector2 mousePosition = GetMousePosition();
+
+            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePosition, exploreGridRec))
+            {
+                selected = ((int)(mousePosition.y - exploreGridRec.y)/exploreCellHeight)*EXPLORE_GRID_COLUMNS + (int)(mousePosition.x - exploreGridRec.x)/exploreCellWidth;
+            }
+
+            if (IsKeyPressed(KEY_RIGHT)) selected++;
+            else if (IsKeyPressed(KEY_LEFT)) selected--;
+            else if (IsKeyPressed(KEY_DOWN)) selected += EXPLORE_GRID_COLUMNS;
+            else if (IsKeyPressed(KEY_UP)) selected -= EXPLORE_GRID_COLUMNS;
+
+            if (selected >= exploreBatch.count) selected = exploreBatch.count - 1;
+            if ((selected < 0) && (exploreSelected != -1)) selected = 0;
+
+            if (audioReady && (selected >= 0) && ((selected != exploreSelected) || IsKeyPressed(KEY_SPACE)) && explorePeaksReady[selected])
+            {
+                UpdateSoundSlot(&exploreSound, exploreBatch.waves[selected]);
+                PlaySoundSlot(&exploreSound);
+            }
+
+            exploreSelected = selected;
+
+            if (IsKeyPressed(KEY_ENTER)) exploreUse = true;
+
+            // Copy selected candidate parameters to active slot
+            if (exploreUse && (exploreSelected >= 0))
+            {
+                params[slotActive] = exploreBatch.params[exploreSelected];
+                regenerate = true;
+                exploreActive = false;
+            }
+
+            exploreUse = false;
+        }
+
+        // Explore window closed, candidates rendering cancelled and memory released
+        if (!exploreActive && (exploreBatch.count > 0))
+        {
+            CloseExploreBatch(&exploreBatch);
+
+            for (int i = 0; i < EXPLORE_MAX_CANDIDATES; i++)
+            {
+                if (explorePeaksReady[i]) UnloadWavePeaks(explorePeaks[i]);
+                explorePeaksReady[i] = false;
+            }
+
+            StopSound(exploreSound.sounds[exploreSound.front]);
+        }
         //----------------------------------------------------------------------------------
 
         // Basic program flow logic
         //----------------------------------------------------------------------------------
         
+        // Load sounds for already generated waves once audio device is ready
+        if (!audioReady && IsAudioDeviceLoaded(&audioLoader))
+        {
+            audioReady = true;
+
+            for (int i = 0; i < MAX_WAVE_SLOTS; i++) if (wave[i].data != NULL) UpdateSoundSlot(&sound[i], wave[i]);
+            if (audioPlayPending) PlaySoundSlot(&sound[slotActive]);
+        }
+
         // Check for changed gui values
-        if (volumeValue != prevVolumeValue) SetSoundVolume(sound[slotActive], volumeValue);
+        if (volumeValue != prevVolumeValue)
+        {
+            SetSoundSlotVolume(&sound[slotActive], volumeValue);
+            SetSoundSlotVolume(&exploreSound, volumeValue);
+        }
         prevVolumeValue = volumeValue;
 
         if (params[slotActive].waveTypeValue != prevWaveTypeValue[slotActive]) regenerate = true;
         prevWaveTypeValue[slotActive] = params[slotActive].waveTypeValue;
         
-        if (slotActive != prevSlotActive) { PlaySound(sound[slotActive]); prevSlotActive = slotActive; }
+        // Slot wave is generated on first slot selection, played once ready
+        if (slotActive != prevSlotActive)
+        {
+            if (!waveRequested[slotActive])
+            {
+                RequestRegenWave(&regenWorker, slotActive, params[slotActive], qualityValues[qualityActive], true, 0);
+                waveRequested[slotActive] = true;
+            }
+            else PlaySoundSlot(&sound[slotActive]);
+
+            prevSlotActive = slotActive;
+            waveRedraw = true;
+        }
         
 #if defined(VERSION_ONE)
         // Set new gui style if changed
@@ -489,25 +1205,80 @@ int main(int argc, char *argv[])
         prevVisualStyleActive = visualStyleActive;
 #endif
 
+        // Regenerate all used slots waves if generation quality changed, only active slot is played
+        if (qualityActive != prevQualityActive)
+        {
+            for (int i = 0; i < MAX_WAVE_SLOTS; i++) if (waveRequested[i]) RequestRegenWave(&regenWorker, i, params[i], qualityValues[qualityActive], (i == slotActive), 0);
+            prevQualityActive = qualityActive;
+        }
+
+        // Live preview: while sliders are dragged, only first PREVIEW_LENGTH_MS of wave are generated on every change
+        // NOTE: Sliders are updated on drawing, changes are detected on next frame
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) previewParams = params[slotActive];
+
+        if (!exploreActive && IsMouseButtonDown(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), slidersRec) &&
+            (memcmp(&params[slotActive], &previewParams, sizeof(WaveParams)) != 0))
+        {
+            RequestRegenWave(&regenWorker, slotActive, params[slotActive], qualityValues[qualityActive], false, PREVIEW_LENGTH_MS*WAVE_SAMPLE_RATE/1000);
+
+            previewParams = params[slotActive];
+            previewActive = true;
+        }
+
         // Consider two possible cases to regenerate wave and update sound:
         // CASE1: regenerate flag is true (set by sound buttons functions)
-        // CASE2: Mouse is moving sliders and mouse is released (checks against all sliders box - a bit crappy solution...)
-        if (regenerate || ((CheckCollisionPointRec(GetMousePosition(), (Rectangle){ 243, 48, 102, 362 })) && (IsMouseButtonReleased(MOUSE_LEFT_BUTTON))))
+        // CASE2: Mouse is moving sliders and mouse is released (checks against all sliders box or live preview active)
+        if (regenerate || (!exploreActive && (previewActive || CheckCollisionPointRec(GetMousePosition(), slidersRec)) && (IsMouseButtonReleased(MOUSE_LEFT_BUTTON))))
         {
-            UnloadWave(wave[slotActive]);
-            wave[slotActive] = GenerateWave(params[slotActive]);        // Generate new wave from parameters
-
-            UnloadSound(sound[slotActive]);
-            sound[slotActive] = LoadSoundFromWave(wave[slotActive]);    // Reload sound from new wave
-            //UpdateSound(sound[slotActive], wave[slotActive].data, wave[slotActive].sampleCount);    // Update sound buffer with new data --> CRASHES RANDOMLY!
+            // Request new full wave generation on background thread, previous request for slot is cancelled
+            RequestRegenWave(&regenWorker, slotActive, params[slotActive], qualityValues[qualityActive], (regenerate || playOnChangeChecked), 0);
+            waveRequested[slotActive] = true;
 
-            if (regenerate || playOnChangeChecked) PlaySound(sound[slotActive]);
-            
-            strcpy(soundInfoText, FormatText("SOUND INFO: Num samples: %i", wave[slotActive].sampleCount));
-            strcpy(durationText, FormatText("Duration: %i ms", wave[slotActive].sampleCount*1000/(wave[slotActive].sampleRate*wave[slotActive].channels)));
-            strcpy(waveSizeText, FormatText("Wave size: %i bytes", wave[slotActive].sampleCount*wavSampleSize/8));
+            // Add parameters change to slot history, nothing is added if parameters did not change
+            PushParamsHistory(&history[slotActive], historyParams[slotActive], params[slotActive]);
+            historyParams[slotActive] = params[slotActive];
 
             regenerate = false;
+            previewActive = false;
+        }
+
+        // Stop sounds playback at wave end
+        for (int i = 0; i < MAX_WAVE_SLOTS; i++) UpdateSoundSlotPlayback(&sound[i]);
+        UpdateSoundSlotPlayback(&exploreSound);
+
+        // Swap generated waves when ready
+        // NOTE: Sounds must be updated on main thread
+        for (int i = 0; i < MAX_WAVE_SLOTS; i++)
+        {
+            Wave regenWave = { 0 };
+            bool playWave = false;
+            bool previewWave = false;
+
+            if (GetRegenWave(&regenWorker, i, &regenWave, &playWave, &previewWave))
+            {
+                UnloadWave(wave[i]);
+                wave[i] = regenWave;
+
+                // NOTE: Sounds are only reloaded if wave does not fit, they are loaded once audio device is ready
+                if (audioReady) UpdateSoundSlot(&sound[i], wave[i]);
+
+                UnloadWavePeaks(wavePeaks[i]);
+                wavePeaks[i] = LoadWavePeaks(wave[i]);
+                if (i == slotActive) waveRedraw = true;
+
+                if (i == slotActive)
+                {
+                    if (playWave && audioReady) PlaySoundSlot(&sound[i]);
+                    else if (playWave) audioPlayPending = true;
+
+                    // NOTE: Live preview wave is partial, full wave info is computed from parameters
+                    int sampleCount = previewWave? GetWaveSampleCount(params[i]) : (int)wave[i].sampleCount;
+
+                    strcpy(soundInfoText, FormatText("SOUND INFO: Num samples: %i", sampleCount));
+                    strcpy(durationText, FormatText("Duration: %i ms", sampleCount*1000/(wave[i].sampleRate*wave[i].channels)));
+                    strcpy(waveSizeText, FormatText("Wave size: %i bytes", sampleCount*wavSampleSize/8));
+                }
+            }
         }
 
         // Check gui combo box selected options
@@ -521,6 +1292,12 @@ int main(int argc, char *argv[])
         // Change window size to x2
         if (screenSizeActive)
         {
+            if (screenTarget.id == 0)
+            {
+                screenTarget = LoadRenderTexture(512, 512);
+                SetTextureFilter(screenTarget.texture, FILTER_POINT);
+            }
+
             if (GetScreenWidth() < screenWidth*2)
             {
                 SetWindowSize(screenWidth*2, screenHeight*2);
@@ -542,27 +1319,64 @@ int main(int argc, char *argv[])
         BeginDrawing();
 
 #if defined(RENDER_WAVE_TO_TEXTURE)
-            BeginTextureMode(waveTarget);
-                ClearBackground(GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
-                DrawWave(&wave[slotActive], (Rectangle){ 0, 0, waveTarget.texture.width, waveTarget.texture.height }, GetColor(GuiGetStyle(DEFAULT, TEXT_COLOR_PRESSED)));
-            EndTextureMode();
+            // Redraw wave texture if wave or style colors changed
+            if ((GuiGetStyle(DEFAULT, BACKGROUND_COLOR) != prevWaveColors[0]) || (GuiGetStyle(DEFAULT, TEXT_COLOR_PRESSED) != prevWaveColors[1]))
+            {
+                prevWaveColors[0] = GuiGetStyle(DEFAULT, BACKGROUND_COLOR);
+                prevWaveColors[1] = GuiGetStyle(DEFAULT, TEXT_COLOR_PRESSED);
+                waveRedraw = true;
+                exploreRedraw = true;
+            }
+
+            if (waveRedraw && ((wavePeaks[slotActive].sampleCount > 0) || (waveTarget.id > 0)))
+            {
+                if (waveTarget.id == 0) waveTarget = LoadRenderTexture(waveRec.width*2, waveRec.height*2);
+
+                BeginTextureMode(waveTarget);
+                    ClearBackground(GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
+                    DrawWave(&wavePeaks[slotActive], (Rectangle){ 0, 0, waveTarget.texture.width, waveTarget.texture.height }, GetColor(GuiGetStyle(DEFAULT, TEXT_COLOR_PRESSED)));
+                EndTextureMode();
+
+                waveRedraw = false;
+            }
 #endif
-            // Render all screen to a texture (for scaling)
-            BeginTextureMode(screenTarget);
+            // Redraw explore thumbnails if candidates or style colors changed
+            if (exploreActive && exploreRedraw)
+            {
+                BeginTextureMode(exploreTarget);
+                    ClearBackground(GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
+
+                    for (int i = 0; i < exploreBatch.count; i++)
+                    {
+                        Rectangle cellRec = { (i%EXPLORE_GRID_COLUMNS)*exploreCellWidth + 1, (i/EXPLORE_GRID_COLUMNS)*exploreCellHeight + 1, exploreCellWidth - 2, exploreCellHeight - 2 };
+
+                        if (explorePeaksReady[i]) DrawWave(&explorePeaks[i], cellRec, GetColor(GuiGetStyle(DEFAULT, TEXT_COLOR_PRESSED)));
+                        DrawRectangleLines(cellRec.x, cellRec.y, cellRec.width, cellRec.height, GetColor(GuiGetStyle(DEFAULT, LINES_COLOR)));
+                    }
+                EndTextureMode();
+
+                exploreRedraw = false;
+            }
+
+            // Render all screen to a texture if scaled
+            bool screenScaled = screenSizeActive && (screenTarget.id > 0);
+            if (screenScaled) BeginTextureMode(screenTarget);
             ClearBackground(GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
 
             // rFXGen Layout: controls drawing
             //----------------------------------------------------------------------------------
+            if (exploreActive) GuiLock();   // Explore window is modal
+
             DrawText("rFXGen", 29, 19, 20, GetColor(GuiGetStyle(DEFAULT, TEXT_COLOR_PRESSED)));
             GuiLabel((Rectangle){ 86, 14, 10, 10 }, FormatText("v%s", TOOL_VERSION_TEXT));
             
-            if (GuiButton((Rectangle){ 10, 45, 95, 20 }, "Pickup/Coin")) { params[slotActive] = GenPickupCoin(); regenerate = true; }
-            if (GuiButton((Rectangle){ 10, 70, 95, 20 }, "Laser/Shoot")) { params[slotActive] = GenLaserShoot(); regenerate = true; }
-            if (GuiButton((Rectangle){ 10, 95, 95, 20 }, "Explosion")) { params[slotActive] = GenExplosion(); regenerate = true; }
-            if (GuiButton((Rectangle){ 10, 120, 95, 20 }, "Powerup")) { params[slotActive] = GenPowerup(); regenerate = true; }
-            if (GuiButton((Rectangle){ 10, 145, 95, 20 }, "Hit/Hurt")) { params[slotActive] = GenHitHurt(); regenerate = true; }
-            if (GuiButton((Rectangle){ 10, 170, 95, 20 }, "Jump")) { params[slotActive] = GenJump(); regenerate = true; }
-            if (GuiButton((Rectangle){ 10, 195, 95, 20 }, "Blip/Select")) { params[slotActive] = GenBlipSelect(); regenerate = true; }
+            if (GuiButton((Rectangle){ 10, 45, 95, 20 }, "Pickup/Coin")) { params[slotActive] = GenPickupCoin(GetRandomValue(0x1, 0xFFFE)); regenerate = true; }
+            if (GuiButton((Rectangle){ 10, 70, 95, 20 }, "Laser/Shoot")) { params[slotActive] = GenLaserShoot(GetRandomValue(0x1, 0xFFFE)); regenerate = true; }
+            if (GuiButton((Rectangle){ 10, 95, 95, 20 }, "Explosion")) { params[slotActive] = GenExplosion(GetRandomValue(0x1, 0xFFFE)); regenerate = true; }
+            if (GuiButton((Rectangle){ 10, 120, 95, 20 }, "Powerup")) { params[slotActive] = GenPowerup(GetRandomValue(0x1, 0xFFFE)); regenerate = true; }
+            if (GuiButton((Rectangle){ 10, 145, 95, 20 }, "Hit/Hurt")) { params[slotActive] = GenHitHurt(GetRandomValue(0x1, 0xFFFE)); regenerate = true; }
+            if (GuiButton((Rectangle){ 10, 170, 95, 20 }, "Jump")) { params[slotActive] = GenJump(GetRandomValue(0x1, 0xFFFE)); regenerate = true; }
+            if (GuiButton((Rectangle){ 10, 195, 95, 20 }, "Blip/Select")) { params[slotActive] = GenBlipSelect(GetRandomValue(0x1, 0xFFFE)); regenerate = true; }
 
             GuiLine((Rectangle){ 10, 220, 95, 20 }, 1);
             
@@ -570,8 +1384,8 @@ int main(int argc, char *argv[])
             
             GuiLine((Rectangle){ 10, 340, 95, 15 }, 1);
             
-            if (GuiButton((Rectangle){ 10, 360, 95, 20 }, "Mutate")) { WaveMutate(&params[slotActive]); regenerate = true; } 
-            if (GuiButton((Rectangle){ 10, 385, 95, 20 }, "Randomize")) { params[slotActive] = GenRandomize(); regenerate = true; }
+            if (GuiButton((Rectangle){ 10, 360, 95, 20 }, "Mutate")) { WaveMutate(&params[slotActive], GetRandomValue(0x1, 0xFFFE)); regenerate = true; } 
+            if (GuiButton((Rectangle){ 10, 385, 95, 20 }, "Randomize")) { params[slotActive] = GenRandomize(GetRandomValue(0x1, 0xFFFE)); regenerate = true; }
 
             GuiGroupBox((Rectangle){ paramsAnchor.x, paramsAnchor.y + 2, 265, 24 }, "");
             GuiGroupBox((Rectangle){ paramsAnchor.x, paramsAnchor.y + 25, 265, 66 }, "");
@@ -611,11 +1425,11 @@ int main(int argc, char *argv[])
             //--------------------------------------------------------------------------------
             
             playOnChangeChecked = GuiCheckBoxEx((Rectangle){ 390, 20, 10, 10 }, playOnChangeChecked, "Play on change");
-            if (GuiButton((Rectangle){ 390, 40, 95, 20 }, "Play Sound")) PlaySound(sound[slotActive]); 
+            if (GuiButton((Rectangle){ 390, 40, 95, 20 }, "Play Sound")) PlaySoundSlot(&sound[slotActive]);
 
             GuiLabel((Rectangle){ 390, 65, 25, 25 }, "Slot:");
             
-            slotActive = GuiToggleGroupEx((Rectangle){ 419, 70, 15, 15 }, slotTextList, 4, slotActive, 2, 4);
+            slotActive = GuiToggleGroupEx((Rectangle){ 419, 70, 15, 15 }, slotTextList, MAX_WAVE_SLOTS, slotActive, 2, 4);
             
             GuiLine((Rectangle){ 390, 90, 95, 20 }, 1);
             
@@ -627,11 +1441,11 @@ int main(int argc, char *argv[])
             sampleRateActive = GuiComboBox((Rectangle){ 390, 180, 95, 20 }, sampleRateTextList, 3, sampleRateActive);
             sampleSizeActive = GuiComboBox((Rectangle){ 390, 205, 95, 20 }, sampleSizeTextList, 3, sampleSizeActive);
             fileTypeActive = GuiComboBox((Rectangle){ 390, 230, 95, 20 }, fileTypeTextList, 3, fileTypeActive);
-            if (GuiButton((Rectangle){ 390, 255, 95, 20 }, "Export Wave")) DialogExportWave(wave[slotActive]);
+            if (GuiButton((Rectangle){ 390, 255, 95, 20 }, "Export Wave")) DialogExportWave(params[slotActive]);
 
             GuiLine((Rectangle){ 390, 275, 95, 20 }, 1);
             
-            GuiLabel((Rectangle){ 390, 290, 96, 25 }, "Visual Style:");
+            qualityActive = GuiComboBox((Rectangle){ 390, 290, 95, 20 }, qualityTextList, 5, qualityActive);
 #if !defined(VERSION_ONE)
             GuiDisable();
 #endif
@@ -639,9 +1453,8 @@ int main(int argc, char *argv[])
             GuiEnable();
             screenSizeActive = GuiToggle((Rectangle){ 390, 340, 95, 20 }, "Screen Size x2", screenSizeActive);
             
-            GuiLine((Rectangle){ 390, 360, 95, 20 }, 1);
-            
-            if (GuiButton((Rectangle){ 390, 380, 95, 25 }, "ABOUT")) windowAboutState.active = true; 
+            if (GuiButton((Rectangle){ 390, 360, 95, 20 }, "Explore")) { exploreActive = true; exploreRestart = true; }
+            if (GuiButton((Rectangle){ 390, 385, 95, 20 }, "ABOUT")) windowAboutState.active = true; 
 
             // Draw status bar
             GuiStatusBar((Rectangle){ 0, 476, 201, 20 }, soundInfoText, 10);
@@ -652,9 +1465,9 @@ int main(int argc, char *argv[])
             // Draw Wave form
             //--------------------------------------------------------------------------------
         #if defined(RENDER_WAVE_TO_TEXTURE)
-            DrawTextureEx(waveTarget.texture, (Vector2){ waveRec.x, waveRec.y }, 0.0f, 0.5f, WHITE);
+            if (waveTarget.id > 0) DrawTextureEx(waveTarget.texture, (Vector2){ waveRec.x, waveRec.y }, 0.0f, 0.5f, WHITE);
         #else
-            DrawWave(&wave[slotActive], waveRec, GetColor(GuiGetStyle(DEFAULT, LINES_COLOR)));
+            DrawWave(&wavePeaks[slotActive], waveRec, GetColor(GuiGetStyle(DEFAULT, LINES_COLOR)));
         #endif
 
             // TODO: Draw playing progress rectangle
@@ -663,16 +1476,49 @@ int main(int argc, char *argv[])
             DrawRectangleLines(waveRec.x, waveRec.y, waveRec.width, waveRec.height, GetColor(GuiGetStyle(DEFAULT, LINES_COLOR)));
             //--------------------------------------------------------------------------------
 
+            GuiUnlock();
+
+            // Explore Window Layout: controls drawing
+            //--------------------------------------------------------------------------------
+            if (exploreActive)
+            {
+                DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)), 0.85f));
+
+                exploreActive = !GuiWindowBox(exploreRec, FormatText("Explore sounds: %i candidates", exploreBatch.count));
+
+                exploreModeActive = GuiToggleGroup((Rectangle){ exploreRec.x + 10, exploreRec.y + 32, 70, 20 }, exploreModeTextList, 2, exploreModeActive);
+                if (GuiButton((Rectangle){ exploreRec.x + 165, exploreRec.y + 32, 80, 20 }, "Regenerate")) exploreRestart = true;
+
+                if (exploreSelected < 0) GuiDisable();
+                if (GuiButton((Rectangle){ exploreRec.x + 250, exploreRec.y + 32, 90, 20 }, "Use Selected")) exploreUse = true;
+                GuiEnable();
+
+                GuiLabel((Rectangle){ exploreRec.x + 350, exploreRec.y + 32, 124, 20 }, FormatText("Ready: %i/%i", exploreReadyCount, exploreBatch.count));
+
+                // NOTE: Render texture must be y-flipped
+                DrawTextureRec(exploreTarget.texture, (Rectangle){ 0, 0, exploreTarget.texture.width, -exploreTarget.texture.height }, (Vector2){ exploreGridRec.x, exploreGridRec.y }, WHITE);
+
+                if (exploreSelected >= 0)
+                {
+                    DrawRectangleLinesEx((Rectangle){ exploreGridRec.x + (exploreSelected%EXPLORE_GRID_COLUMNS)*exploreCellWidth, exploreGridRec.y + (exploreSelected/EXPLORE_GRID_COLUMNS)*exploreCellHeight,
+                                         exploreCellWidth, exploreCellHeight }, 2, GetColor(GuiGetStyle(DEFAULT, BORDER_COLOR_PRESSED)));
+                }
+
+                GuiLabel((Rectangle){ exploreRec.x + 10, exploreRec.y + 422, 464, 20 }, "Click or arrows: play candidate - Enter or Use Selected: copy to slot");
+            }
+            //--------------------------------------------------------------------------------
+
             // About Window Layout: controls drawing
             //--------------------------------------------------------------------------------
             GuiWindowAbout(&windowAboutState);
             //--------------------------------------------------------------------------------
 
-            EndTextureMode();
-
             // Draw render texture to screen
-            if (screenSizeActive) DrawTexturePro(screenTarget.texture, (Rectangle){ 0, 0, screenTarget.texture.width, -screenTarget.texture.height }, (Rectangle){ 0, 0, screenTarget.texture.width*2, screenTarget.texture.height*2 }, (Vector2){ 0, 0 }, 0.0f, WHITE);
-            else DrawTextureRec(screenTarget.texture, (Rectangle){ 0, 0, screenTarget.texture.width, -screenTarget.texture.height }, (Vector2){ 0, 0 }, WHITE);
+            if (screenScaled)
+            {
+                EndTextureMode();
+                DrawTexturePro(screenTarget.texture, (Rectangle){ 0, 0, screenTarget.texture.width, -screenTarget.texture.height }, (Rectangle){ 0, 0, screenTarget.texture.width*2, screenTarget.texture.height*2 }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+            }
 
         EndDrawing();
         //------------------------------------------------------------------------------------
@@ -682,16 +1528,26 @@ int main(int argc, char *argv[])
     //----------------------------------------------------------------------------------------
     for (int i = 0; i < MAX_WAVE_SLOTS; i++)
     {
-        UnloadSound(sound[i]);
+        CloseSoundSlot(&sound[i]);
+        UnloadWavePeaks(wavePeaks[i]);
         UnloadWave(wave[i]);
+        UnloadParamsHistory(&history[i]);
     }
 
-    UnloadRenderTexture(screenTarget);
+    if (exploreBatch.count > 0) CloseExploreBatch(&exploreBatch);
+    for (int i = 0; i < EXPLORE_MAX_CANDIDATES; i++) if (explorePeaksReady[i]) UnloadWavePeaks(explorePeaks[i]);
+    CloseSoundSlot(&exploreSound);
+    if (exploreTarget.id > 0) UnloadRenderTexture(exploreTarget);
+
+    CloseRegenWorker(&regenWorker);
+    CloseRenderCache();
+
+    if (screenTarget.id > 0) UnloadRenderTexture(screenTarget);
 #if defined(RENDER_WAVE_TO_TEXTURE)
-    UnloadRenderTexture(waveTarget);
+    if (waveTarget.id > 0) UnloadRenderTexture(waveTarget);
 #endif
 
-    CloseAudioDevice();
+    CloseAudioDeviceAsync(&audioLoader);
     CloseWindow();          // Close window and OpenGL context
     //----------------------------------------------------------------------------------------
 
@@ -720,14 +1576,36 @@ static void ShowCommandLineInfo(void)
 
     printf("USAGE:\n\n");
     printf("    > rfxgen [--help] --input <filename.ext> [--output <filename.ext>]\n");
+#if defined(COMMAND_LINE_ONLY)
+    printf("             [--format <sample_rate> <sample_size> <channels>]\n");
+#else
     printf("             [--format <sample_rate> <sample_size> <channels>] [--play <filename.ext>]\n");
+#endif
+    printf("    > rfxgen [--help] --info <filename.ext> [--format <sample_rate> <sample_size> <channels>]\n");
+    printf("    > rfxgen [--help] --bench [<results.json>]\n");
+    printf("    > rfxgen [--help] --batch <directory|pattern|list.txt> [--outdir <directory>]\n");
+    printf("             [--type <wav|qoa|h>] [--format <sample_rate> <sample_size> <channels>] [--jobs <count>]\n");
+    printf("             [--cache <directory>] [--incremental] [--shard <index>/<count>]\n");
+    printf("    > rfxgen [--help] --merge <directory|pattern> [--output <filename.manifest>]\n");
+    printf("    > rfxgen [--help] --pack <directory|pattern|list.txt> [--output <filename.rfxb>]\n");
+    printf("             [--pcm] [--format <sample_rate> <sample_size> <channels>]\n");
+    printf("    > rfxgen [--help] --unpack <filename.rfxb> [--outdir <directory>]\n");
+    printf("    > rfxgen [--help] --dedup <directory|pattern|list.txt> [--similarity <value>] [--output <filename.txt>]\n");
+    printf("             [--jobs <count>] [--cache <directory>]\n");
+    printf("    > rfxgen [--help] --explore <count> [--input <filename.ext>] [--seed <value>] [--outdir <directory>]\n");
+    printf("             [--type <wav|qoa|h>] [--format <sample_rate> <sample_size> <channels>] [--jobs <count>]\n");
+    printf("    > rfxgen [--help] <any mode options> --profile [<trace.json>]\n");
+    printf("    > rfxgen [--help] <input or batch mode options> --analysis\n");
+    printf("    > rfxgen [--help] <input or batch mode options> --wav <pcm|adpcm>\n");
 
     printf("\nOPTIONS:\n\n");
     printf("    -h, --help                      : Show tool version and command line usage help\n");
     printf("    -i, --input <filename.ext>      : Define input file.\n");
     printf("                                      Supported extensions: .rfx, .sfs, .wav\n");
+    printf("                                      Sound bank sounds: <filename.rfxb>:<name>\n");
     printf("    -o, --output <filename.ext>     : Define output file.\n");
-    printf("                                      Supported extensions: .wav, .h\n");
+    printf("                                      Supported extensions: .wav, .qoa, .h, .rfxb (pack mode), .txt (dedup mode),\n");
+    printf("                                      .manifest (merge mode)\n");
     printf("                                      NOTE: If not specified, defaults to: output.wav\n\n");
     printf("    -f, --format <sample_rate>,<sample_size>,<channels>\n");
     printf("                                    : Define output wave format. Comma separated values.\n");
@@ -736,19 +1614,148 @@ static void ShowCommandLineInfo(void)
     printf("                                          Sample size:      8, 16, 32\n");
     printf("                                          Channels:         1 (mono), 2 (stereo)\n");
     printf("                                      NOTE: If not specified, defaults to: 44100, 16, 1\n\n");
+    printf("    -q, --quality <value>           : Define generation quality (subsamples per sample).\n");
+    printf("                                      Supported values: 1 (draft), 2, 4, 8 (final), adaptive\n");
+    printf("                                      NOTE: If not specified, defaults to: 8 (final)\n");
+    printf("    -n, --info <filename.ext>       : Show sound info (samples, duration, size), no wave is generated.\n");
+    printf("                                      Supported extensions: .rfx, .sfs, .rfxb (sounds list)\n");
+#if !defined(COMMAND_LINE_ONLY)
     printf("    -p, --play <filename.ext>       : Play provided sound.\n");
-    printf("                                      Supported extensions: .wav, .ogg, .flac, .mp3\n");
+    printf("                                      Supported extensions: .rfx, .sfs (generated while played), .wav, .ogg, .flac, .mp3\n");
+#endif
+    printf("    -b, --batch <input>             : Process multiple sound files in one run.\n");
+    printf("                                      Input can be a directory, a wildcard pattern or\n");
+    printf("                                      a list file (.txt) with one file name per line.\n");
+    printf("                                      Supported extensions: .rfx, .sfs\n");
+    printf("    -d, --outdir <directory>        : Define output directory for batch mode.\n");
+    printf("                                      NOTE: If not specified, defaults to current directory\n");
+    printf("    -t, --type <wav|qoa|h>          : Define output file type for batch mode.\n");
+    printf("                                      NOTE: If not specified, defaults to: wav\n");
+    printf("    -j, --jobs <count>              : Define number of worker threads for batch mode.\n");
+    printf("                                      NOTE: If not specified, defaults to cpu cores count\n");
+    printf("    -c, --cache <directory>         : Define render cache directory. Generated waves are\n");
+    printf("                                      reused while sound parameters and format don't change.\n");
+    printf("    -u, --incremental               : Batch mode only exports outputs not up to date.\n");
+    printf("                                      Input files state is saved to <outdir>/%s\n", BATCH_MANIFEST_FILE);
+    printf("                                      and dependencies to <outdir>/%s (Make/Ninja format).\n", BATCH_DEPS_FILE);
+    printf("    -a, --shard <index>/<count>     : Batch mode only processes shard <index> (1 to <count>) of input files.\n");
+    printf("                                      Files are assigned to shards by output file name hash, so every\n");
+    printf("                                      file is always processed by the same shard on any machine.\n");
+    printf("                                      Shard manifest is saved to <outdir>/%s\n", BATCH_SHARD_MANIFEST_FILE);
+    printf("                                      Invalid shard fails with exit code 1, no file is processed.\n");
+    printf("    -z, --merge <input>             : Merge batch shard manifests into one manifest (hashes, durations, sizes).\n");
+    printf("                                      Input can be a directory (files matching %s)\n", BATCH_SHARD_MANIFEST_PATTERN);
+    printf("                                      or a wildcard pattern.\n");
+    printf("                                      NOTE: If output not specified, defaults to: <input>/%s\n", BATCH_MANIFEST_FILE);
+    printf("    -m, --bench [<results.json>]    : Run synthesis benchmark over a fixed sounds corpus (all presets\n");
+    printf("                                      and random sounds), optionally saving results as JSON.\n");
+    printf("    -k, --pack <input>              : Pack multiple sound files into one sound bank file (.rfxb).\n");
+    printf("                                      Input can be a directory, a wildcard pattern or a list file.\n");
+    printf("                                      NOTE: If output not specified, defaults to: sounds.rfxb\n");
+    printf("    -r, --pcm                       : Include pre-rendered PCM data on sound bank (--format).\n");
+    printf("    -x, --unpack <filename.rfxb>    : Unpack sound bank into sound files (.rfx) in --outdir.\n");
+    printf("                                      Pre-rendered PCM data (if available) is exported as .wav\n");
+    printf("    -g, --dedup <input>             : Find near-duplicate sounds, sounds are compared by spectral fingerprint.\n");
+    printf("                                      Input can be a directory, a wildcard pattern or a list file.\n");
+    printf("                                      Duplicates list (one file per line) is saved to --output (.txt)\n");
+    printf("    -y, --similarity <value>        : Define dedup similarity for duplicated sounds (0.0 to 1.0).\n");
+    printf("                                      NOTE: If not specified, defaults to: %.2f\n", DEDUP_SIMILARITY);
+    printf("    -e, --explore <count>           : Generate <count> sound candidates (max %i) in parallel, exported as\n", EXPLORE_MAX_CANDIDATES);
+    printf("                                      explore_<index>.rfx and .wav (or .h) files in --outdir.\n");
+    printf("                                      Candidates are mutations of --input sound (.rfx, .sfs) or\n");
+    printf("                                      random sounds if no input provided.\n");
+    printf("    -s, --seed <value>              : Define explore candidates generation seed.\n");
+    printf("                                      NOTE: If not specified, a random seed is used\n");
+    printf("    -l, --profile [<trace.json>]    : Measure generation stages and wave export time, summary is shown\n");
+    printf("                                      at exit and events are saved as Chrome trace (chrome://tracing).\n");
+    printf("                                      NOTE: If not specified, trace defaults to: %s\n", PROFILE_TRACE_FILE);
+    printf("                                      Requires tool compiled with SYNTH_PROFILE defined\n");
+    printf("    -v, --analysis                  : Save wave analysis (peak, RMS, clipped samples, loudness and length)\n");
+    printf("                                      for every exported wave as <output>%s, measured on generation.\n", ANALYSIS_FILE_EXT);
+    printf("                                      Loudness is integrated loudness in LUFS (ITU-R BS.1770).\n");
+    printf("    --code <pcm|params|adpcm>       : Define code file (.h) export mode for input and batch modes:\n");
+    printf("                                          pcm:    Wave samples as array of bytes\n");
+    printf("                                          params: Sound parameters (%i bytes), wave is generated on load\n", (int)sizeof(WaveParams));
+    printf("                                                  by embedded synth library (rfxgen_synth.h)\n");
+    printf("                                          adpcm:  Wave samples compressed as IMA ADPCM (4 bit), decoder included\n");
+    printf("                                      NOTE: If not specified, defaults to: pcm\n");
+    printf("    --wav <pcm|adpcm>               : Define wave file (.wav) export mode for input and batch modes:\n");
+    printf("                                          pcm:    Wave samples as PCM (--format sample size)\n");
+    printf("                                          adpcm:  Wave samples compressed as IMA ADPCM (4 bit)\n");
+    printf("                                      Compressed audio (.qoa, IMA ADPCM .wav) uses 16 bit samples, it is\n");
+    printf("                                      encoded by blocks while generated, no full wave is generated.\n");
+    printf("                                      NOTE: If not specified, defaults to: pcm\n");
+    printf("    -w, --serve                     : Serve render requests from stdin (one request per line) until stdin\n");
+    printf("                                      is closed or quit request. Requests are rendered in parallel (--jobs)\n");
+    printf("                                      and responded on stdout as soon as ready, tagged by request <id>:\n");
+    printf("                                          <id> render <input> <output.ext> [<format>] [<quality>]\n");
+    printf("                                              Response: <id> ok <output.ext> <samples>\n");
+    printf("                                          <id> pcm <input> [<format>] [<quality>]\n");
+    printf("                                              Response: <id> pcm <bytes> <sample_rate> <sample_size> <channels>\n");
+    printf("                                              followed by <bytes> of PCM data (interleaved, little endian)\n");
+    printf("                                          <id> ping\n");
+    printf("                                              Response: <id> ok\n");
+    printf("                                          quit\n");
+    printf("                                      Input can be a sound file (.rfx, .sfs) or params:<hex> (.rfx wave\n");
+    printf("                                      parameters data as hex text), output can be .wav, .qoa or .h.\n");
+    printf("                                      Failed requests response: <id> error <message>\n");
+    printf("                                      NOTE: Format and quality default to --format and --quality values\n");
 
     printf("\nEXAMPLES:\n\n");
     printf("    > rfxgen --input sound.rfx --output jump.wav\n");
     printf("        Process <sound.rfx> to generate <sound.wav> at 44100 Hz, 32 bit, Mono\n\n");
     printf("    > rfxgen --input sound.rfx --output jump.wav --format 22050 16 2\n");
     printf("        Process <sound.rfx> to generate <jump.wav> at 22050 Hz, 16 bit, Stereo\n\n");
+#if !defined(COMMAND_LINE_ONLY)
     printf("    > rfxgen --input sound.rfx --play output.wav\n");
     printf("        Process <sound.rfx> to generate <output.wav> and play <output.wav>\n\n");
+    printf("    > rfxgen --play sound.rfx --quality adaptive\n");
+    printf("        Play <sound.rfx>, wave is generated while played (no wave file exported)\n\n");
+#endif
+    printf("    > rfxgen --batch sounds --outdir build/sounds --quality adaptive\n");
+    printf("        Process all sound files in <sounds>, subsamples per sample are reduced for\n");
+    printf("        low frequency waves (faster generation, same sound).\n\n");
+#if !defined(COMMAND_LINE_ONLY)
     printf("    > rfxgen --input sound.wav --output jump.wav --format 22050,8,1 --play jump.wav\n");
     printf("        Process <sound.wav> to generate <jump.wav> at 22050 Hz, 8 bit, Stereo.\n");
-    printf("        Plays generated sound <jump.wav>.\n");
+    printf("        Plays generated sound <jump.wav>.\n\n");
+#endif
+    printf("    > rfxgen --batch sounds/*.rfx --outdir build/sounds --format 22050,16,1\n");
+    printf("        Process all <.rfx> files in <sounds> to generate <.wav> files in <build/sounds>\n");
+        printf("        at 22050 Hz, 16 bit, Mono, using all available cpu cores.\n\n");
+    printf("    > rfxgen --batch sounds --outdir build/sounds --cache build/cache\n");
+    printf("        Process all sound files in <sounds>, only sounds not found in <build/cache>\n");
+    printf("        are generated again.\n\n");
+    printf("    > rfxgen --batch sounds --outdir build/sounds --incremental\n");
+    printf("        Process only sound files in <sounds> changed since last export to <build/sounds>.\n\n");
+    printf("    > rfxgen --batch sounds --outdir build/sounds --shard 2/4\n");
+    printf("        Process second quarter of sound files in <sounds>, shards can run on different machines.\n\n");
+    printf("    > rfxgen --batch sounds --outdir build/sounds --type h --code params\n");
+    printf("        Process all sound files in <sounds> to generate <.h> files with sound parameters,\n");
+    printf("        waves are generated on game load with <rfxgen_synth.h>.\n\n");
+    printf("    > rfxgen --batch sounds --outdir build/sounds --type qoa --format 22050,16,1\n");
+    printf("        Process all sound files in <sounds> to generate <.qoa> files at 22050 Hz, Mono,\n");
+    printf("        waves are encoded while generated, no separate encoder pass required.\n\n");
+    printf("    > rfxgen --batch sounds --outdir build/sounds --analysis\n");
+    printf("        Process all sound files in <sounds>, every <.wav> file gets a <.wav.json> file with\n");
+    printf("        its peak, RMS and loudness, so exported files don't need to be analyzed again.\n\n");
+    printf("    > rfxgen --merge build/sounds\n");
+    printf("        Merge shard manifests in <build/sounds> into <build/sounds/%s>.\n\n", BATCH_MANIFEST_FILE);
+    printf("    > rfxgen --pack sounds --output game.rfxb --pcm --format 22050,16,1\n");
+    printf("        Pack all sound files in <sounds> into <game.rfxb>, including sounds pre-rendered\n");
+    printf("        at 22050 Hz, 16 bit, Mono.\n\n");
+    printf("    > rfxgen --dedup sounds --similarity 0.99 --output duplicates.txt\n");
+    printf("        Find near-duplicate sounds in <sounds>, duplicates (all sounds but first on every\n");
+    printf("        group) are listed in <duplicates.txt>.\n\n");
+    printf("    > rfxgen --explore 64 --input jump.rfx --seed 1234 --outdir explore\n");
+    printf("        Generate 64 mutations of <jump.rfx> using all cpu cores, every candidate is exported\n");
+    printf("        to <explore> as parameters (.rfx) and wave (.wav) files.\n\n");
+    printf("    > rfxgen --batch sounds --outdir build/sounds --profile export.json\n");
+    printf("        Process all sound files in <sounds>, time spent on every generation stage and on\n");
+    printf("        export is shown at exit, events are saved to <export.json>.\n\n");
+    printf("    > rfxgen --serve --format 22050,16,1 --cache build/cache\n");
+    printf("        Keep tool running, rendering requests received on stdin. Generated waves are reused\n");
+    printf("        from memory or <build/cache> if requested again.\n");
 }
 
 // Process command line input
@@ -759,11 +1766,39 @@ static void ProcessCommandLine(int argc, char *argv[])
 
     char inFileName[256] = { 0 };   // Input file name
     char outFileName[256] = { 0 };  // Output file name
+#if !defined(COMMAND_LINE_ONLY)
     char playFileName[256] = { 0 }; // Play file name
+#endif
+    char infoFileName[256] = { 0 }; // Sound info file name
+    char batchInput[256] = { 0 };   // Batch input: directory, wildcard pattern or list file
+    char outDirName[256] = { 0 };   // Batch output directory
+    char outFileType[8] = "wav";    // Batch output file type
+    char cacheDirName[256] = { 0 }; // Render cache directory (disk cache disabled if empty)
+    int jobsCount = 0;              // Batch worker threads (0 = cpu cores count)
+    bool incremental = false;       // Batch incremental mode, outputs up to date are not exported again
+    int shardIndex = 0;             // Batch shard index (1 to shardCount)
+    int shardCount = 0;             // Batch shards count (0 = all input files processed)
+    char mergeInput[256] = { 0 };   // Merge input: shard manifests directory or wildcard pattern
+    bool runBenchmark = false;      // Run synthesis benchmark
+    char benchFileName[256] = { 0 };    // Benchmark results file name (.json)
+    char packInput[256] = { 0 };    // Sound bank pack input: directory, wildcard pattern or list file
+    char unpackFileName[256] = { 0 };   // Sound bank file to unpack (.rfxb)
+    bool packPcm = false;           // Sound bank includes pre-rendered PCM data
+    char dedupInput[256] = { 0 };   // Dedup input: directory, wildcard pattern or list file
+    float dedupSimilarity = DEDUP_SIMILARITY;   // Dedup similarity for duplicated sounds
+    int exploreCount = 0;           // Explore candidates to generate (0 = explore disabled)
+    unsigned int exploreSeed = 0;   // Explore candidates seed (0 = random seed)
+    bool profile = false;           // Measure generation stages and export (SYNTH_PROFILE required)
+    char traceFileName[256] = { 0 };    // Profile trace file name (.json)
+    bool serve = false;             // Serve render requests from stdin
+    bool analysis = false;          // Save wave analysis sidecar file (.json) for every exported wave
+    int codeMode = CODE_EXPORT_PCM; // Code file export mode (.h)
+    int wavMode = WAV_EXPORT_PCM;   // Wave file export mode (.wav)
 
     int sampleRate = 44100;         // Default conversion sample rate
     int sampleSize = 16;            // Default conversion sample size
     int channels = 1;               // Default conversion channels number
+    int quality = SYNTH_QUALITY_FINAL;  // Default generation quality
 
     // Process command line arguments
     for (int i = 1; i < argc; i++)
@@ -775,10 +1810,12 @@ static void ProcessCommandLine(int argc, char *argv[])
         else if ((strcmp(argv[i], "-i") == 0) || (strcmp(argv[i], "--input") == 0))
         {
             // Check for valid argumment and valid file extension
+            // NOTE: Sound bank sounds are provided as <filename.rfxb>:<name>
             if (((i + 1) < argc) && (argv[i + 1][0] != '-') &&
                 (IsFileExtension(argv[i + 1], ".rfx") ||
                  IsFileExtension(argv[i + 1], ".sfs") ||
-                 IsFileExtension(argv[i + 1], ".wav")))
+                 IsFileExtension(argv[i + 1], ".wav") ||
+                 (strstr(argv[i + 1], ".rfxb:") != NULL)))
             {
                 strcpy(inFileName, argv[i + 1]);    // Read input filename
                 i++;
@@ -789,7 +1826,11 @@ static void ProcessCommandLine(int argc, char *argv[])
         {
             if (((i + 1) < argc) && (argv[i + 1][0] != '-') &&
                 (IsFileExtension(argv[i + 1], ".wav") ||
-                 IsFileExtension(argv[i + 1], ".h")))
+                 IsFileExtension(argv[i + 1], ".qoa") ||
+                 IsFileExtension(argv[i + 1], ".h") ||
+                 IsFileExtension(argv[i + 1], ".rfxb") ||
+                 IsFileExtension(argv[i + 1], ".txt") ||
+                 IsFileExtension(argv[i + 1], ".manifest")))
             {
                 strcpy(outFileName, argv[i + 1]);   // Read output filename
                 i++;
@@ -836,10 +1877,31 @@ static void ProcessCommandLine(int argc, char *argv[])
             }
             else printf("WARNING: Format parameters provided not valid\n");
         }
+        else if ((strcmp(argv[i], "-q") == 0) || (strcmp(argv[i], "--quality") == 0))
+        {
+            if (((i + 1) < argc) && (strcmp(argv[i + 1], "adaptive") == 0))
+            {
+                quality = SYNTH_QUALITY_ADAPTIVE;
+                i++;
+            }
+            else if (((i + 1) < argc) && ((atoi(argv[i + 1]) == 1) || (atoi(argv[i + 1]) == 2) || (atoi(argv[i + 1]) == 4) || (atoi(argv[i + 1]) == 8)))
+            {
+                quality = atoi(argv[i + 1]);    // Read subsamples per sample
+                i++;
+            }
+            else printf("WARNING: Quality not supported. Default: 8 (final)\n");
+        }
         else if ((strcmp(argv[i], "-p") == 0) || (strcmp(argv[i], "--play") == 0))
         {
+#if defined(COMMAND_LINE_ONLY)
+            // NOTE: Headless tool has no audio device, play option is not available (argument is skipped)
+            printf("WARNING: Sound playing not available, tool compiled with COMMAND_LINE_ONLY (no audio device)\n");
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-')) i++;
+#else
             if (((i + 1) < argc) && (argv[i + 1][0] != '-') &&
-                (IsFileExtension(argv[i + 1], ".wav") ||
+                (IsFileExtension(argv[i + 1], ".rfx") ||
+                 IsFileExtension(argv[i + 1], ".sfs") ||
+                 IsFileExtension(argv[i + 1], ".wav") ||
                  IsFileExtension(argv[i + 1], ".ogg") ||
                  IsFileExtension(argv[i + 1], ".flac") ||
                  IsFileExtension(argv[i + 1], ".mp3")))
@@ -848,1039 +1910,4812 @@ static void ProcessCommandLine(int argc, char *argv[])
                 i++;
             }
             else printf("WARNING: Play file extension not supported\n");
+#endif
         }
-    }
-
-    // Process input file if provided
-    if (inFileName[0] != '\0')
-    {
-        if (outFileName[0] == '\0') strcpy(outFileName, "output.wav");  // Set a default name for output in case not provided
-
-        printf("\nInput file:       %s", inFileName);
-        printf("\nOutput file:      %s", outFileName);
-        printf("\nOutput format:    %i Hz, %i bits, %s\n\n", sampleRate, sampleSize, (channels == 1) ? "Mono" : "Stereo");
-
-        Wave wave = { 0 };
-
-        if (IsFileExtension(inFileName, ".rfx") || IsFileExtension(inFileName, ".sfs"))
+        else if ((strcmp(argv[i], "-n") == 0) || (strcmp(argv[i], "--info") == 0))
         {
-            WaveParams params = LoadWaveParams(inFileName);
-            wave = GenerateWave(params);
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-') &&
+                (IsFileExtension(argv[i + 1], ".rfx") ||
+                 IsFileExtension(argv[i + 1], ".sfs") ||
+                 IsFileExtension(argv[i + 1], ".rfxb")))
+            {
+                strcpy(infoFileName, argv[i + 1]);  // Read sound info filename
+                i++;
+            }
+            else printf("WARNING: Info file extension not supported\n");
         }
-        else if (IsFileExtension(inFileName, ".wav")) wave = LoadWave(inFileName);
-
-        // Format wave data to desired sampleRate, sampleSize and channels
-        WaveFormat(&wave, sampleRate, sampleSize, channels);
-
-        // Export wave data as audio file (.wav) or code file (.h)
-        if (IsFileExtension(outFileName, ".wav")) ExportWave(wave, outFileName);
-        else if (IsFileExtension(outFileName, ".h")) ExportWaveAsCode(wave, outFileName);
-
-        UnloadWave(wave);
-    }
-
-    // Play audio file if provided
-    if (playFileName[0] != '\0')
-    {
-        Wave wave = LoadWave(playFileName);
-        PlayWaveCLI(wave);
-        UnloadWave(wave);
-    }
-
-    if (showUsageInfo) ShowCommandLineInfo();
-}
-#endif      // VERSION_ONE
-
-//--------------------------------------------------------------------------------------------
-// Load/Save/Export functions
-//--------------------------------------------------------------------------------------------
-
-// Reset wave parameters
-static void ResetWaveParams(WaveParams *params)
-{
-    // NOTE: Random seed is set to a random value
-    params->randSeed = GetRandomValue(0x1, 0xFFFE);
-    srand(params->randSeed);
-
-    // Wave type
-    params->waveTypeValue = 0;
-
-    // Wave envelope params
-    params->attackTimeValue = 0.0f;
-    params->sustainTimeValue = 0.3f;
-    params->sustainPunchValue = 0.0f;
-    params->decayTimeValue = 0.4f;
-
-    // Frequency params
-    params->startFrequencyValue = 0.3f;
-    params->minFrequencyValue = 0.0f;
-    params->slideValue = 0.0f;
-    params->deltaSlideValue = 0.0f;
-    params->vibratoDepthValue = 0.0f;
-    params->vibratoSpeedValue = 0.0f;
-    //params->vibratoPhaseDelay = 0.0f;
-
-    // Tone change params
-    params->changeAmountValue = 0.0f;
-    params->changeSpeedValue = 0.0f;
-
-    // Square wave params
-    params->squareDutyValue = 0.0f;
-    params->dutySweepValue = 0.0f;
-
-    // Repeat params
-    params->repeatSpeedValue = 0.0f;
-
-    // Phaser params
-    params->phaserOffsetValue = 0.0f;
-    params->phaserSweepValue = 0.0f;
-
-    // Filter params
-    params->lpfCutoffValue = 1.0f;
-    params->lpfCutoffSweepValue = 0.0f;
-    params->lpfResonanceValue = 0.0f;
-    params->hpfCutoffValue = 0.0f;
-    params->hpfCutoffSweepValue = 0.0f;
-}
-
-// Generates new wave from wave parameters
-// NOTE: By default wave is generated as 44100Hz, 32bit float, mono
-static Wave GenerateWave(WaveParams params)
-{
-    #define MAX_WAVE_LENGTH_SECONDS  10     // Max length for wave: 10 seconds
-    #define WAVE_SAMPLE_RATE      44100     // Default sample rate
-
-    // NOTE: GetRandomValue() is provided by raylib and seed is initialized at InitWindow()
-    #define GetRandomFloat(range) ((float)GetRandomValue(0, 10000)/10000.0f*range)
-
-    if (params.randSeed != 0) srand(params.randSeed);   // Initialize seed if required
-
-    // Configuration parameters for generation
-    // NOTE: Those parameters are calculated from selected values
-    int phase = 0;
-    double fperiod = 0.0;
-    double fmaxperiod = 0.0;
-    double fslide = 0.0;
-    double fdslide = 0.0;
-    int period = 0;
-    float squareDuty = 0.0f;
-    float squareSlide = 0.0f;
-    int envelopeStage = 0;
-    int envelopeTime = 0;
-    int envelopeLength[3] = { 0 };
-    float envelopeVolume = 0.0f;
-    float fphase = 0.0f;
-    float fdphase = 0.0f;
-    int iphase = 0;
-    float phaserBuffer[1024] = { 0.0f };
-    int ipp = 0;
-    float noiseBuffer[32] = { 0.0f };       // Required for noise wave, depends on random seed!
-    float fltp = 0.0f;
-    float fltdp = 0.0f;
-    float fltw = 0.0f;
-    float fltwd = 0.0f;
-    float fltdmp = 0.0f;
-    float fltphp = 0.0f;
-    float flthp = 0.0f;
-    float flthpd = 0.0f;
-    float vibratoPhase = 0.0f;
-    float vibratoSpeed = 0.0f;
-    float vibratoAmplitude = 0.0f;
-    int repeatTime = 0;
-    int repeatLimit = 0;
-    int arpeggioTime = 0;
-    int arpeggioLimit = 0;
-    double arpeggioModulation = 0.0;
-
-    // HACK: Security check to avoid crash (why?)
-    if (params.minFrequencyValue > params.startFrequencyValue) params.minFrequencyValue = params.startFrequencyValue;
-    if (params.slideValue < params.deltaSlideValue) params.slideValue = params.deltaSlideValue;
-
-    // Reset sample parameters
-    //----------------------------------------------------------------------------------------
-    fperiod = 100.0/(params.startFrequencyValue*params.startFrequencyValue + 0.001);
-    period = (int)fperiod;
-    fmaxperiod = 100.0/(params.minFrequencyValue*params.minFrequencyValue + 0.001);
-    fslide = 1.0 - pow((double)params.slideValue, 3.0)*0.01;
-    fdslide = -pow((double)params.deltaSlideValue, 3.0)*0.000001;
-    squareDuty = 0.5f - params.squareDutyValue*0.5f;
-    squareSlide = -params.dutySweepValue*0.00005f;
-
-    if (params.changeAmountValue >= 0.0f) arpeggioModulation = 1.0 - pow((double)params.changeAmountValue, 2.0)*0.9;
-    else arpeggioModulation = 1.0 + pow((double)params.changeAmountValue, 2.0)*10.0;
-
-    arpeggioLimit = (int)(pow(1.0f - params.changeSpeedValue, 2.0f)*20000 + 32);
+        else if ((strcmp(argv[i], "-b") == 0) || (strcmp(argv[i], "--batch") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                strcpy(batchInput, argv[i + 1]);    // Read batch input
+                i++;
+            }
+            else printf("WARNING: Batch input not provided\n");
+        }
+        else if ((strcmp(argv[i], "-d") == 0) || (strcmp(argv[i], "--outdir") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                strcpy(outDirName, argv[i + 1]);    // Read output directory
+                i++;
+            }
+            else printf("WARNING: Output directory not provided\n");
+        }
+        else if ((strcmp(argv[i], "-t") == 0) || (strcmp(argv[i], "--type") == 0))
+        {
+            if (((i + 1) < argc) && ((strcmp(argv[i + 1], "wav") == 0) || (strcmp(argv[i + 1], "qoa") == 0) || (strcmp(argv[i + 1], "h") == 0)))
+            {
+                strcpy(outFileType, argv[i + 1]);   // Read output file type
+                i++;
+            }
+            else printf("WARNING: Output file type not supported. Default: wav\n");
+        }
+        else if ((strcmp(argv[i], "-j") == 0) || (strcmp(argv[i], "--jobs") == 0))
+        {
+            if (((i + 1) < argc) && (atoi(argv[i + 1]) > 0))
+            {
+                jobsCount = atoi(argv[i + 1]);      // Read worker threads count
+                i++;
+            }
+            else printf("WARNING: Jobs count not valid. Default: cpu cores count\n");
+        }
+        else if ((strcmp(argv[i], "-c") == 0) || (strcmp(argv[i], "--cache") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                if (strlen(argv[i + 1]) >= sizeof(cacheDirName))
+                {
+                    printf("ERROR: Cache directory path too long (max %i characters)\n", (int)sizeof(cacheDirName) - 1);
+                    exit(1);
+                }
+
+                strcpy(cacheDirName, argv[i + 1]);  // Read render cache directory
+                i++;
+            }
+            else printf("WARNING: Cache directory not provided\n");
+        }
+        else if ((strcmp(argv[i], "-u") == 0) || (strcmp(argv[i], "--incremental") == 0))
+        {
+            incremental = true;
+        }
+        else if ((strcmp(argv[i], "-a") == 0) || (strcmp(argv[i], "--shard") == 0))
+        {
+            int index = 0, count = 0, length = 0;
+
+            // NOTE: Invalid shard is an error, processing all input files would overlap other shards outputs
+            if (((i + 1) < argc) && (sscanf(argv[i + 1], "%d/%d%n", &index, &count, &length) == 2) && (argv[i + 1][length] == '\0') &&
+                (count > 0) && (index >= 1) && (index <= count))
+            {
+                shardIndex = index;     // Read shard index and count
+                shardCount = count;
+                i++;
+            }
+            else
+            {
+                printf("ERROR: Shard not valid, expected <index>/<count> with <index> from 1 to <count>\n");
+                exit(1);
+            }
+        }
+        else if ((strcmp(argv[i], "-z") == 0) || (strcmp(argv[i], "--merge") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                strcpy(mergeInput, argv[i + 1]);    // Read merge input
+                i++;
+            }
+            else printf("WARNING: Merge input not provided\n");
+        }
+        else if ((strcmp(argv[i], "-m") == 0) || (strcmp(argv[i], "--bench") == 0))
+        {
+            runBenchmark = true;
 
-    if (params.changeSpeedValue == 1.0f) arpeggioLimit = 0;     // WATCH OUT: float comparison
+            // Results file is optional
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-') && IsFileExtension(argv[i + 1], ".json"))
+            {
+                strcpy(benchFileName, argv[i + 1]); // Read benchmark results filename
+                i++;
+            }
+        }
+        else if ((strcmp(argv[i], "-k") == 0) || (strcmp(argv[i], "--pack") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                strcpy(packInput, argv[i + 1]);     // Read sound bank pack input
+                i++;
+            }
+            else printf("WARNING: Pack input not provided\n");
+        }
+        else if ((strcmp(argv[i], "-r") == 0) || (strcmp(argv[i], "--pcm") == 0))
+        {
+            packPcm = true;
+        }
+        else if ((strcmp(argv[i], "-x") == 0) || (strcmp(argv[i], "--unpack") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-') && IsFileExtension(argv[i + 1], ".rfxb"))
+            {
+                strcpy(unpackFileName, argv[i + 1]);    // Read sound bank filename to unpack
+                i++;
+            }
+            else printf("WARNING: Unpack file extension not supported\n");
+        }
+        else if ((strcmp(argv[i], "-g") == 0) || (strcmp(argv[i], "--dedup") == 0))
+        {
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-'))
+            {
+                strcpy(dedupInput, argv[i + 1]);    // Read dedup input
+                i++;
+            }
+            else printf("WARNING: Dedup input not provided\n");
+        }
+        else if ((strcmp(argv[i], "-y") == 0) || (strcmp(argv[i], "--similarity") == 0))
+        {
+            if (((i + 1) < argc) && (atof(argv[i + 1]) > 0.0) && (atof(argv[i + 1]) <= 1.0))
+            {
+                dedupSimilarity = (float)atof(argv[i + 1]);     // Read dedup similarity
+                i++;
+            }
+            else printf("WARNING: Similarity value not valid. Default: %.2f\n", DEDUP_SIMILARITY);
+        }
+        else if ((strcmp(argv[i], "-e") == 0) || (strcmp(argv[i], "--explore") == 0))
+        {
+            if (((i + 1) < argc) && (atoi(argv[i + 1]) > 0))
+            {
+                exploreCount = atoi(argv[i + 1]);   // Read explore candidates count
+                i++;
 
-    // Reset filter parameters
-    fltw = pow(params.lpfCutoffValue, 3.0f)*0.1f;
-    fltwd = 1.0f + params.lpfCutoffSweepValue*0.0001f;
-    fltdmp = 5.0f/(1.0f + pow(params.lpfResonanceValue, 2.0f)*20.0f)*(0.01f + fltw);
-    if (fltdmp > 0.8f) fltdmp = 0.8f;
-    flthp = pow(params.hpfCutoffValue, 2.0f)*0.1f;
-    flthpd = 1.0 + params.hpfCutoffSweepValue*0.0003f;
+                if (exploreCount > EXPLORE_MAX_CANDIDATES)
+                {
+                    printf("WARNING: Explore candidates count not supported. Max: %i\n", EXPLORE_MAX_CANDIDATES);
+                    exploreCount = EXPLORE_MAX_CANDIDATES;
+                }
+            }
+            else printf("WARNING: Explore candidates count not valid\n");
+        }
+        else if ((strcmp(argv[i], "-s") == 0) || (strcmp(argv[i], "--seed") == 0))
+        {
+            if (((i + 1) < argc) && (strtoul(argv[i + 1], NULL, 10) > 0))
+            {
+                exploreSeed = (unsigned int)strtoul(argv[i + 1], NULL, 10);     // Read explore seed
+                i++;
+            }
+            else printf("WARNING: Seed value not valid. Default: random seed\n");
+        }
+        else if ((strcmp(argv[i], "-w") == 0) || (strcmp(argv[i], "--serve") == 0))
+        {
+            serve = true;
+        }
+        else if ((strcmp(argv[i], "-v") == 0) || (strcmp(argv[i], "--analysis") == 0))
+        {
+            analysis = true;
+        }
+        else if (strcmp(argv[i], "--code") == 0)
+        {
+            if (((i + 1) < argc) && (strcmp(argv[i + 1], "pcm") == 0)) codeMode = CODE_EXPORT_PCM;
+            else if (((i + 1) < argc) && (strcmp(argv[i + 1], "params") == 0)) codeMode = CODE_EXPORT_PARAMS;
+            else if (((i + 1) < argc) && (strcmp(argv[i + 1], "adpcm") == 0)) codeMode = CODE_EXPORT_ADPCM;
+            else
+            {
+                printf("WARNING: Code export mode not supported. Default: pcm\n");
+                continue;
+            }
 
-    // Reset vibrato
-    vibratoSpeed = pow(params.vibratoSpeedValue, 2.0f)*0.01f;
-    vibratoAmplitude = params.vibratoDepthValue*0.5f;
+            i++;    // Code export mode read
+        }
+        else if (strcmp(argv[i], "--wav") == 0)
+        {
+            if (((i + 1) < argc) && (strcmp(argv[i + 1], "pcm") == 0)) wavMode = WAV_EXPORT_PCM;
+            else if (((i + 1) < argc) && (strcmp(argv[i + 1], "adpcm") == 0)) wavMode = WAV_EXPORT_ADPCM;
+            else
+            {
+                printf("WARNING: Wave export mode not supported. Default: pcm\n");
+                continue;
+            }
 
-    // Reset envelope
-    envelopeLength[0] = (int)(params.attackTimeValue*params.attackTimeValue*100000.0f);
-    envelopeLength[1] = (int)(params.sustainTimeValue*params.sustainTimeValue*100000.0f);
-    envelopeLength[2] = (int)(params.decayTimeValue*params.decayTimeValue*100000.0f);
+            i++;    // Wave export mode read
+        }
+        else if ((strcmp(argv[i], "-l") == 0) || (strcmp(argv[i], "--profile") == 0))
+        {
+            profile = true;
 
-    fphase = pow(params.phaserOffsetValue, 2.0f)*1020.0f;
-    if (params.phaserOffsetValue < 0.0f) fphase = -fphase;
+            // Trace file is optional
+            if (((i + 1) < argc) && (argv[i + 1][0] != '-') && IsFileExtension(argv[i + 1], ".json"))
+            {
+                strcpy(traceFileName, argv[i + 1]); // Read profile trace filename
+                i++;
+            }
+        }
+    }
 
-    fdphase = pow(params.phaserSweepValue, 2.0f)*1.0f;
-    if (params.phaserSweepValue < 0.0f) fdphase = -fdphase;
+#if defined(SYNTH_PROFILE)
+    ProfileTrace trace = { 0 };
+    if (profile) InitProfileTrace(&trace);
+#else
+    if (profile) printf("WARNING: Profile not available, tool must be compiled with SYNTH_PROFILE defined\n");
+#endif
 
-    iphase = abs((int)fphase);
+    // Init render cache, generated waves are reused if parameters and format do not change
+    if (cacheDirName[0] != '\0') MakeDirectory(cacheDirName);
+    if (!InitRenderCache(cacheDirName))
+    {
+        printf("ERROR: Cache directory path too long (max %i characters)\n", (int)sizeof(renderCache.directory) - 1);
+        exit(1);
+    }
 
-    for (int i = 0; i < 32; i++) noiseBuffer[i] = GetRandomFloat(2.0f) - 1.0f;      // WATCH OUT: GetRandomFloat()
+    // Process input file if provided, on explore mode input file is used as candidates base
+    if ((inFileName[0] != '\0') && (exploreCount == 0))
+    {
+        if (outFileName[0] == '\0') strcpy(outFileName, "output.wav");  // Set a default name for output in case not provided
 
-    repeatLimit = (int)(pow(1.0f - params.repeatSpeedValue, 2.0f)*20000 + 32);
+        printf("\nInput file:       %s", inFileName);
+        printf("\nOutput file:      %s", outFileName);
+        printf("\nOutput format:    %i Hz, %i bits, %s\n\n", sampleRate, sampleSize, (channels == 1) ? "Mono" : "Stereo");
 
-    if (params.repeatSpeedValue == 0.0f) repeatLimit = 0;
-    //----------------------------------------------------------------------------------------
+        Wave wave = { 0 };
+        WaveAnalysis waveAnalysis = { 0 };
 
-    // NOTE: We reserve enough space for up to 10 seconds of wave audio at given sample rate
-    // By default we use float size samples, they are converted to desired sample size at the end
-    float *buffer = (float *)calloc(MAX_WAVE_LENGTH_SECONDS*WAVE_SAMPLE_RATE, sizeof(float));
-    bool generatingSample = true;
-    int sampleCount = 0;
+        // Parameters code export requires sound parameters, generated wave is only required for analysis
+        bool paramsCode = (codeMode == CODE_EXPORT_PARAMS) && IsFileExtension(outFileName, ".h");
 
-    for (int i = 0; i < MAX_WAVE_LENGTH_SECONDS*WAVE_SAMPLE_RATE; i++)
-    {
-        if (!generatingSample)
+        if (paramsCode && !IsFileExtension(inFileName, ".rfx") && !IsFileExtension(inFileName, ".sfs"))
         {
-            sampleCount = i;
-            break;
+            printf("WARNING: Parameters code export requires a sound parameters file (.rfx, .sfs), wave data exported\n");
+            paramsCode = false;
         }
 
-        // Generate sample using selected parameters
-        //------------------------------------------------------------------------------------
-        repeatTime++;
+        // Compressed audio is encoded while generated from sound parameters, no full wave is generated
+        int format = GetAudioFormat(outFileName, wavMode);
+        bool streamExport = (format != AUDIO_FORMAT_NONE) && (IsFileExtension(inFileName, ".rfx") || IsFileExtension(inFileName, ".sfs"));
+
+        if (IsFileExtension(inFileName, ".rfx") || IsFileExtension(inFileName, ".sfs"))
+        {
+            // Generate wave in desired sampleRate, sampleSize and channels
+            WaveParams params = LoadWaveParams(inFileName);
+
+            if (paramsCode) ExportWaveParamsAsCode(params, sampleRate, sampleSize, channels, quality, outFileName);
 
-        if ((repeatLimit != 0) && (repeatTime >= repeatLimit))
+            if (streamExport)
+            {
+                // NOTE: Wave only describes exported samples format (for analysis), no samples data
+                wave.sampleCount = ExportWaveStream(params, sampleRate, channels, quality, outFileName, format, analysis? &waveAnalysis : NULL);
+                wave.sampleRate = sampleRate;
+                wave.sampleSize = 16;
+                wave.channels = channels;
+            }
+            else if (!paramsCode || analysis) wave = GenerateWaveCached(params, sampleRate, sampleSize, channels, quality, analysis? &waveAnalysis : NULL);
+        }
+        else if (IsFileExtension(inFileName, ".wav"))
+        {
+            // Format wave data to desired sampleRate, sampleSize and channels
+            wave = LoadWave(inFileName);
+#if defined(SYNTH_PROFILE)
+            double formatTime = GetSynthProfileTime();
+            WaveFormat(&wave, sampleRate, sampleSize, channels);
+            AddSynthProfileEvent(SYNTH_PROFILE_FORMAT, formatTime, GetSynthProfileTime() - formatTime, 1);
+#else
+            WaveFormat(&wave, sampleRate, sampleSize, channels);
+#endif
+        }
+        else if (strstr(inFileName, ".rfxb:") != NULL)
         {
-            // Reset sample parameters (only some of them)
-            repeatTime = 0;
+            // Split sound bank file name and sound name
+            char bankFileName[256] = { 0 };
+            char *soundName = strstr(inFileName, ".rfxb:") + 6;
+            strncpy(bankFileName, inFileName, soundName - inFileName - 1);
 
-            fperiod = 100.0/(params.startFrequencyValue*params.startFrequencyValue + 0.001);
-            period = (int)fperiod;
-            fmaxperiod = 100.0/(params.minFrequencyValue*params.minFrequencyValue + 0.001);
-            fslide = 1.0 - pow((double)params.slideValue, 3.0)*0.01;
-            fdslide = -pow((double)params.deltaSlideValue, 3.0)*0.000001;
-            squareDuty = 0.5f - params.squareDutyValue*0.5f;
-            squareSlide = -params.dutySweepValue*0.00005f;
+            SoundBank bank = LoadSoundBank(bankFileName);
+            int index = GetSoundBankIndex(&bank, soundName);
 
-            if (params.changeAmountValue >= 0.0f) arpeggioModulation = 1.0 - pow((double)params.changeAmountValue, 2.0)*0.9;
-            else arpeggioModulation = 1.0 + pow((double)params.changeAmountValue, 2.0)*10.0;
+            if (index != -1)
+            {
+                // Pre-rendered wave is used if available in desired format
+                Wave bankWave = GetSoundBankWave(&bank, index);
 
-            arpeggioTime = 0;
-            arpeggioLimit = (int)(pow(1.0f - params.changeSpeedValue, 2.0f)*20000 + 32);
+                if ((bankWave.data != NULL) && ((int)bankWave.sampleRate == sampleRate) &&
+                    ((int)bankWave.sampleSize == sampleSize) && ((int)bankWave.channels == channels)) wave = WaveCopy(bankWave);
+                else wave = GenerateWaveCached(GetSoundBankParams(&bank, index), sampleRate, sampleSize, channels, quality, analysis? &waveAnalysis : NULL);
+            }
+            else if (bank.header != NULL) printf("[%s] Sound not found in sound bank: %s\n", bankFileName, soundName);
 
-            if (params.changeSpeedValue == 1.0f) arpeggioLimit = 0;     // WATCH OUT: float comparison
+            UnloadSoundBank(bank);
         }
 
-        // Frequency envelopes/arpeggios
-        arpeggioTime++;
+        // Export wave data as audio file (.wav, .qoa) or code file (.h)
+        if (!paramsCode && !streamExport) ExportWaveFile(wave, outFileName, codeMode, wavMode);
 
-        if ((arpeggioLimit != 0) && (arpeggioTime >= arpeggioLimit))
+        // NOTE: Analysis is only measured on generated waves (not available for .wav input or pre-rendered sound bank waves)
+        if (analysis)
         {
-            arpeggioLimit = 0;
-            fperiod *= arpeggioModulation;
+            if (waveAnalysis.sampleCount > 0) SaveWaveAnalysis(waveAnalysis, wave, outFileName);
+            else printf("WARNING: Wave analysis only available for generated sounds (.rfx, .sfs, .rfxb)\n");
         }
 
-        fslide += fdslide;
-        fperiod *= fslide;
+        UnloadWave(wave);
+    }
 
-        if (fperiod > fmaxperiod)
+    // Process batch input if provided
+    if (batchInput[0] != '\0')
+    {
+        if (outDirName[0] == '\0') strcpy(outDirName, ".");     // Set current directory for output in case not provided
+        if (jobsCount == 0) jobsCount = GetCpuCoreCount();
+
+        BatchConfig config = { 0 };
+        config.jobs = LoadBatchJobs(batchInput, outDirName, outFileType, &config.jobCount);
+        config.sampleRate = sampleRate;
+        config.sampleSize = sampleSize;
+        config.channels = channels;
+        config.quality = quality;
+        config.analysis = analysis;
+        config.codeMode = codeMode;
+        config.wavMode = wavMode;
+        config.incremental = incremental;
+        config.shardIndex = shardIndex;
+        config.shardCount = shardCount;
+
+        int inputCount = config.jobCount;
+        if (shardCount > 0) config.jobCount = SelectBatchShard(config.jobs, config.jobCount, shardIndex, shardCount);
+
+        // Incremental mode: previous batch manifest is required to check outputs
+        // NOTE: Every shard uses its own manifest and dependencies file, shard manifests can be merged later
+        char manifestFileName[512] = { 0 };
+        char depsFileName[512] = { 0 };
+        char shardFileName[64] = { 0 };
+
+        if (shardCount > 0) snprintf(shardFileName, 64, BATCH_SHARD_MANIFEST_FILE, shardIndex, shardCount);
+        snprintf(manifestFileName, 512, "%s/%s", outDirName, (shardCount > 0)? shardFileName : BATCH_MANIFEST_FILE);
+
+        if (shardCount > 0) snprintf(shardFileName, 64, BATCH_SHARD_DEPS_FILE, shardIndex, shardCount);
+        snprintf(depsFileName, 512, "%s/%s", outDirName, (shardCount > 0)? shardFileName : BATCH_DEPS_FILE);
+
+        if (incremental) config.manifest = LoadBatchManifest(manifestFileName, &config.manifestCount, &config.manifestTime);
+
+        printf("\nBatch input:      %s (%i files)", batchInput, inputCount);
+        if (shardCount > 0) printf("\nBatch shard:      %i/%i (%i files)", shardIndex, shardCount, config.jobCount);
+        printf("\nOutput directory: %s", outDirName);
+        printf("\nOutput format:    %i Hz, %i bits, %s", sampleRate, sampleSize, (channels == 1) ? "Mono" : "Stereo");
+        printf("\nWorker threads:   %i\n\n", (jobsCount < config.jobCount) ? jobsCount : config.jobCount);
+
+        if (config.jobCount > 0)
         {
-            fperiod = fmaxperiod;
+            MakeDirectory(outDirName);
 
-            if (params.minFrequencyValue > 0.0f) generatingSample = false;
-        }
+            RunJobsParallel(ProcessBatchJob, &config, config.jobCount, jobsCount);
+
+            // Jobs sorted by input file name, manifest and dependencies file do not depend on directory listing order
+            qsort(config.jobs, config.jobCount, sizeof(BatchJob), CompareBatchJobs);
+
+            int failedCount = 0;
+            int upToDateCount = 0;
+
+            for (int i = 0; i < config.jobCount; i++)
+            {
+                if (!config.jobs[i].success) failedCount++;
+                else if (config.jobs[i].upToDate) upToDateCount++;
+            }
 
-        float rfperiod = fperiod;
+            printf("\nBatch processed: %i files exported, %i up to date, %i failed\n", config.jobCount - failedCount - upToDateCount, upToDateCount, failedCount);
+            if (cacheDirName[0] != '\0') printf("Render cache: %i reused, %i generated\n", renderCache.hitCount, renderCache.missCount);
 
-        if (vibratoAmplitude > 0.0f)
+            // Shard manifest is always saved, it is required to merge shards
+            if (incremental || (shardCount > 0)) SaveBatchManifest(manifestFileName, config);
+            if (incremental) SaveBatchDependencies(depsFileName, config);
+        }
+        else if (inputCount > 0)
         {
-            vibratoPhase += vibratoSpeed;
-            rfperiod = fperiod*(1.0 + sinf(vibratoPhase)*vibratoAmplitude);
+            // Empty shard, manifest is saved anyway so all shards are available to merge
+            MakeDirectory(outDirName);
+            SaveBatchManifest(manifestFileName, config);
         }
+        else printf("WARNING: No .rfx or .sfs files found for batch input\n");
+
+        free(config.manifest);
+        free(config.jobs);
+    }
+
+    // Merge batch shard manifests if required, output file is only used for merged manifest
+    if (mergeInput[0] != '\0')
+    {
+        char mergeFileName[512] = { 0 };
+
+        if (IsFileExtension(outFileName, ".manifest")) strcpy(mergeFileName, outFileName);
+        else if ((strchr(mergeInput, '*') == NULL) && (strchr(mergeInput, '?') == NULL)) snprintf(mergeFileName, 512, "%s/%s", mergeInput, BATCH_MANIFEST_FILE);
+        else strcpy(mergeFileName, BATCH_MANIFEST_FILE);
 
-        period = (int)rfperiod;
+        MergeBatchManifests(mergeInput, mergeFileName);
+    }
+
+    // Find near-duplicate sounds if required, output file is only used for duplicates list
+    if (dedupInput[0] != '\0')
+    {
+        RunDedup(dedupInput, IsFileExtension(outFileName, ".txt")? outFileName : NULL, dedupSimilarity, (jobsCount > 0)? jobsCount : GetCpuCoreCount());
+    }
 
-        if (period < 8) period=8;
+    // Explore sound candidates if required, mutations of input sound or random sounds
+    if (exploreCount > 0)
+    {
+        if (outDirName[0] == '\0') strcpy(outDirName, ".");     // Set current directory for output in case not provided
+        if (jobsCount == 0) jobsCount = GetCpuCoreCount();
+        if (exploreSeed == 0) exploreSeed = (unsigned int)time(NULL);
 
-        squareDuty += squareSlide;
+        bool mutate = (IsFileExtension(inFileName, ".rfx") || IsFileExtension(inFileName, ".sfs"));
+        if ((inFileName[0] != '\0') && !mutate) printf("WARNING: Explore input must be a sound parameters file, random sounds generated\n");
 
-        if (squareDuty < 0.0f) squareDuty = 0.0f;
-        if (squareDuty > 0.5f) squareDuty = 0.5f;
+        WaveParams base = { 0 };
+        if (mutate) base = LoadWaveParams(inFileName);
 
-        // Volume envelope
-        envelopeTime++;
+        ExploreBatch *batch = (ExploreBatch *)malloc(sizeof(ExploreBatch));
+        InitExploreBatch(batch, base, mutate, exploreSeed, exploreCount);
+        batch->outDir = outDirName;
+        batch->outType = outFileType;
+        batch->sampleRate = sampleRate;
+        batch->sampleSize = sampleSize;
+        batch->channels = channels;
+        batch->quality = quality;
 
-        if (envelopeTime > envelopeLength[envelopeStage])
-        {
-            envelopeTime = 0;
-            envelopeStage++;
+        printf("\nExplore base:     %s", mutate? inFileName : "random sounds");
+        printf("\nExplore seed:     %u (%i candidates)", exploreSeed, batch->count);
+        printf("\nOutput directory: %s", outDirName);
+        printf("\nOutput format:    %i Hz, %i bits, %s", sampleRate, sampleSize, (channels == 1) ? "Mono" : "Stereo");
+        printf("\nWorker threads:   %i\n\n", (jobsCount < batch->count) ? jobsCount : batch->count);
 
-            if (envelopeStage == 3) generatingSample = false;
-        }
+        MakeDirectory(outDirName);
+
+        double startTime = GetPreciseTime();
+        RunJobsParallel(ProcessExploreJob, batch, batch->count, jobsCount);
 
-        if (envelopeStage == 0) envelopeVolume = (float)envelopeTime/envelopeLength[0];
-        if (envelopeStage == 1) envelopeVolume = 1.0f + pow(1.0f - (float)envelopeTime/envelopeLength[1], 1.0f)*2.0f*params.sustainPunchValue;
-        if (envelopeStage == 2) envelopeVolume = 1.0f - (float)envelopeTime/envelopeLength[2];
+        printf("\nExplore processed: %i candidates exported in %.3f s\n", batch->readyCount, GetPreciseTime() - startTime);
 
-        // Phaser step
-        fphase += fdphase;
-        iphase = abs((int)fphase);
+        CloseExploreBatch(batch);
+        free(batch);
+    }
+
+    // Pack sound bank if required, output file is only used for sound bank
+    if (packInput[0] != '\0')
+    {
+        PackSoundBank(packInput, IsFileExtension(outFileName, ".rfxb")? outFileName : "sounds.rfxb", packPcm, sampleRate, sampleSize, channels, quality);
+    }
+
+    // Serve render requests if required, it returns when stdin is closed
+    if (serve) RunServe(sampleRate, sampleSize, channels, quality, (jobsCount > 0)? jobsCount : GetCpuCoreCount());
+
+    // Unpack sound bank if required
+    if (unpackFileName[0] != '\0') UnpackSoundBank(unpackFileName, (outDirName[0] != '\0')? outDirName : ".");
+
+    // Show sound bank info if provided
+    if (IsFileExtension(infoFileName, ".rfxb")) ShowSoundBankInfo(infoFileName);
+
+    // Show sound info if provided, wave length is computed from parameters
+    else if (infoFileName[0] != '\0')
+    {
+        WaveParams params = LoadWaveParams(infoFileName);
+
+        int sampleCount = GetWaveSampleCount(params);
+        int outSampleCount = (int)((long long)sampleCount*sampleRate/WAVE_SAMPLE_RATE);
 
-        if (iphase > 1023) iphase = 1023;
+        printf("\nSound file:       %s", infoFileName);
+        printf("\nNum samples:      %i (%i Hz)", sampleCount, WAVE_SAMPLE_RATE);
+        printf("\nDuration:         %.3f s", GetWaveDuration(params));
+        printf("\nWave size:        %i bytes (%i Hz, %i bits, %s)\n", outSampleCount*channels*sampleSize/8,
+               sampleRate, sampleSize, (channels == 1) ? "Mono" : "Stereo");
+    }
 
-        if (flthpd != 0.0f)     // WATCH OUT!
+#if !defined(COMMAND_LINE_ONLY)
+    // Play audio file if provided, sound parameters files are generated while played (no wave file required)
+    if (playFileName[0] != '\0')
+    {
+        if (IsFileExtension(playFileName, ".rfx") || IsFileExtension(playFileName, ".sfs")) PlayWaveParamsCLI(LoadWaveParams(playFileName), quality);
+        else
         {
-            flthp *= flthpd;
-            if (flthp < 0.00001f) flthp = 0.00001f;
-            if (flthp > 0.1f) flthp = 0.1f;
+            Wave wave = LoadWave(playFileName);
+            PlayWaveCLI(wave);
+            UnloadWave(wave);
         }
+    }
+#endif
 
-        float ssample = 0.0f;
+    // Run synthesis benchmark if required
+    if (runBenchmark) RunBenchmark(benchFileName);
 
-        #define MAX_SUPERSAMPLING   8
+    if (showUsageInfo) ShowCommandLineInfo();
 
-        // Supersampling x8
-        for (int si = 0; si < MAX_SUPERSAMPLING; si++)
-        {
-            float sample = 0.0f;
-            phase++;
+#if defined(SYNTH_PROFILE)
+    if (profile)
+    {
+        CloseProfileTrace(&trace);
+        ShowProfileSummary(&trace);
+        SaveProfileTrace(&trace, (traceFileName[0] != '\0')? traceFileName : PROFILE_TRACE_FILE);
 
-            if (phase >= period)
-            {
-                //phase = 0;
-                phase %= period;
+        free(trace.events);
+    }
+#endif
 
-                if (params.waveTypeValue == 3)
-                {
-                    for (int i = 0;i < 32; i++) noiseBuffer[i] = GetRandomFloat(2.0f) - 1.0f;   // WATCH OUT: GetRandomFloat()
-                }
-            }
+    CloseRenderCache();
+}
+
+// Load batch jobs from directory, wildcard pattern or list file (.txt)
+// NOTE: Output file names are generated from input file names, placed in outDir with outExt
+static BatchJob *LoadBatchJobs(const char *input, const char *outDir, const char *outExt, int *jobCount)
+{
+    BatchJob *jobs = NULL;
+    int count = 0;
+    int capacity = 0;
+
+    char **inFileNames = NULL;
+    int inFileCount = 0;
+
+    if (IsFileExtension(input, ".txt"))
+    {
+        // List file: one input file name per line, empty lines and lines starting with '#' are skipped
+        FILE *listFile = fopen(input, "rt");
 
-            // base waveform
-            float fp = (float)phase/period;
+        if (listFile != NULL)
+        {
+            char line[256] = { 0 };
 
-            switch (params.waveTypeValue)
+            while (fgets(line, 256, listFile) != NULL)
             {
-                case 0: // Square wave
-                {
-                    if (fp < squareDuty) sample = 0.5f;
-                    else sample = -0.5f;
+                int len = strlen(line);
+                while ((len > 0) && isspace((unsigned char)line[len - 1])) line[--len] = '\0';
+
+                if ((len == 0) || (line[0] == '#')) continue;
 
-                } break;
-                case 1: sample = 1.0f - fp*2; break;    // Sawtooth wave
-                case 2: sample = sinf(fp*2*PI); break;  // Sine wave
-                case 3: sample = noiseBuffer[phase*32/period]; break; // Noise wave
-                default: break;
+                inFileNames = (char **)realloc(inFileNames, (inFileCount + 1)*sizeof(char *));
+                inFileNames[inFileCount] = (char *)calloc(len + 1, 1);
+                strcpy(inFileNames[inFileCount], line);
+                inFileCount++;
             }
 
-            // LP filter
-            float pp = fltp;
-            fltw *= fltwd;
+            fclose(listFile);
+        }
+        else printf("WARNING: Batch list file could not be opened: %s\n", input);
+    }
+    else
+    {
+        // Directory or wildcard pattern: split into directory path and file name pattern
+        char dirPath[256] = { 0 };
+        const char *pattern = "*";
 
-            if (fltw < 0.0f) fltw = 0.0f;
-            if (fltw > 0.1f) fltw = 0.1f;
+        if ((strchr(input, '*') != NULL) || (strchr(input, '?') != NULL))
+        {
+            const char *separator = strrchr(input, '/');
+            if (strrchr(input, '\\') > separator) separator = strrchr(input, '\\');
 
-            if (params.lpfCutoffValue != 1.0f)  // WATCH OUT!
+            if (separator != NULL)
             {
-                fltdp += (sample-fltp)*fltw;
-                fltdp -= fltdp*fltdmp;
+                strncpy(dirPath, input, separator - input);
+                pattern = separator + 1;
             }
             else
             {
-                fltp = sample;
-                fltdp = 0.0f;
+                strcpy(dirPath, ".");
+                pattern = input;
+            }
+        }
+        else strcpy(dirPath, input);
+
+        int dirFileCount = 0;
+        char **dirFiles = GetDirectoryFiles(dirPath, &dirFileCount);
+
+        for (int i = 0; i < dirFileCount; i++)
+        {
+            if ((IsFileExtension(dirFiles[i], ".rfx") || IsFileExtension(dirFiles[i], ".sfs")) &&
+                MatchFilePattern(dirFiles[i], pattern))
+            {
+                inFileNames = (char **)realloc(inFileNames, (inFileCount + 1)*sizeof(char *));
+                inFileNames[inFileCount] = (char *)calloc(strlen(dirPath) + strlen(dirFiles[i]) + 2, 1);
+                sprintf(inFileNames[inFileCount], "%s/%s", dirPath, dirFiles[i]);
+                inFileCount++;
             }
+        }
 
-            fltp += fltdp;
+        ClearDirectoryFiles();
+    }
+
+    for (int i = 0; i < inFileCount; i++)
+    {
+        if (IsFileExtension(inFileNames[i], ".rfx") || IsFileExtension(inFileNames[i], ".sfs"))
+        {
+            if (count >= capacity)
+            {
+                capacity = (capacity == 0)? 64 : capacity*2;
+                jobs = (BatchJob *)realloc(jobs, capacity*sizeof(BatchJob));
+            }
 
-            // HP filter
-            fltphp += fltp - pp;
-            fltphp -= fltphp*flthp;
-            sample = fltphp;
+            BatchJob *job = &jobs[count];
+            memset(job, 0, sizeof(BatchJob));
+            strncpy(job->inFileName, inFileNames[i], 255);
 
-            // Phaser
-            phaserBuffer[ipp & 1023] = sample;
-            sample += phaserBuffer[(ipp - iphase + 1024) & 1023];
-            ipp = (ipp + 1) & 1023;
+            // Output file name: input file name without extension, on output directory
+            char baseName[256] = { 0 };
+            strncpy(baseName, GetFileName(inFileNames[i]), 255);
+            char *ext = strrchr(baseName, '.');
+            if (ext != NULL) *ext = '\0';
 
-            // Final accumulation and envelope application
-            ssample += sample*envelopeVolume;
+            snprintf(job->outFileName, 256, "%s/%s.%s", outDir, baseName, outExt);
+            count++;
         }
+        else printf("WARNING: Batch input file extension not recognized: %s\n", inFileNames[i]);
 
-        #define SAMPLE_SCALE_COEFICIENT 0.2f    // NOTE: Used to scale sample value to [-1..1]
+        free(inFileNames[i]);
+    }
 
-        ssample = (ssample/MAX_SUPERSAMPLING)*SAMPLE_SCALE_COEFICIENT;
-        //------------------------------------------------------------------------------------
+    free(inFileNames);
+
+    *jobCount = count;
+    return jobs;
+}
+
+// Select batch jobs on shard, jobs not on shard are removed from list (jobs order is kept)
+// NOTE: Shard is selected by output file name hash (without directory), it does not depend on
+// input files order or input directory, so same file is always processed by same shard
+static int SelectBatchShard(BatchJob *jobs, int jobCount, int shardIndex, int shardCount)
+{
+    int count = 0;
+
+    for (int i = 0; i < jobCount; i++)
+    {
+        const char *name = GetFileName(jobs[i].outFileName);
+        unsigned long long hash = ComputeHash64(name, (int)strlen(name), 0);
+
+        // Mix hash bits (64 bit finalizer), FNV-1a low bits are not well distributed for similar names
+        hash ^= (hash >> 33);
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= (hash >> 33);
+
+        if ((int)(hash%(unsigned long long)shardCount) == (shardIndex - 1))
+        {
+            if (count != i) jobs[count] = jobs[i];
+            count++;
+        }
+    }
+
+    return count;
+}
+
+// Process one batch job: load, generate, format and export
+// NOTE: Called from worker threads, only thread-safe functions should be used
+static void ProcessBatchJob(void *userData, int index)
+{
+    BatchConfig *config = (BatchConfig *)userData;
+    BatchJob *job = &config->jobs[index];
+
+    // Incremental mode: output up to date is not exported again
+    if (config->incremental && IsBatchJobUpToDate(config, job))
+    {
+        job->upToDate = true;
+        job->success = true;
+        return;
+    }
+
+    // Shard manifest requires input file state, also when not in incremental mode
+    if (!config->incremental && (config->shardCount > 0))
+    {
+        struct stat inStat = { 0 };
+
+        if (stat(job->inFileName, &inStat) == 0)
+        {
+            job->state.modTime = (long long)inStat.st_mtime;
+            job->state.fileSize = (long long)inStat.st_size;
+        }
+
+        job->state.optionsHash = GetBatchOptionsHash(config);
+        GetFileContentHash(job->inFileName, &job->state.contentHash);
+    }
+
+    WaveParams params = LoadWaveParams(job->inFileName);
+
+    // Previous output is removed, output file is checked after export (failed export is never up to date)
+    remove(job->outFileName);
+
+    // Parameters code export: wave is generated on load by exported code, it is only generated here for analysis
+    bool paramsCode = (config->codeMode == CODE_EXPORT_PARAMS) && IsFileExtension(job->outFileName, ".h");
+    if (paramsCode) ExportWaveParamsAsCode(params, config->sampleRate, config->sampleSize, config->channels, config->quality, job->outFileName);
 
-        // Accumulate samples in the buffer
-        if (ssample > 1.0f) ssample = 1.0f;
-        if (ssample < -1.0f) ssample = -1.0f;
+    // Compressed audio: wave is encoded while generated, no full wave is generated (render cache not used)
+    int format = GetAudioFormat(job->outFileName, config->wavMode);
 
-        buffer[i] = ssample;
+    // Generate wave in desired sampleRate, sampleSize and channels
+    // NOTE: Generation is re-entrant (noise is generated from params.randSeed) and render cache is thread-safe
+    WaveAnalysis analysis = { 0 };
+    Wave wave = { 0 };
+
+    if (format != AUDIO_FORMAT_NONE)
+    {
+        wave.sampleCount = ExportWaveStream(params, config->sampleRate, config->channels, config->quality, job->outFileName, format, config->analysis? &analysis : NULL);
+        wave.sampleRate = config->sampleRate;
+        wave.sampleSize = 16;
+        wave.channels = config->channels;
+    }
+    else if (!paramsCode || config->analysis) wave = GenerateWaveCached(params, config->sampleRate, config->sampleSize, config->channels, config->quality, config->analysis? &analysis : NULL);
+    else
+    {
+        wave.sampleCount = GetWaveSampleCount(params);
+        wave.sampleRate = WAVE_SAMPLE_RATE;
     }
 
-    Wave genWave;
-    genWave.sampleCount = sampleCount;
-    genWave.sampleRate = WAVE_SAMPLE_RATE; // By default 44100 Hz
-    genWave.sampleSize = 32;               // By default 32 bit float samples
-    genWave.channels = 1;                  // By default 1 channel (mono)
+    if (wave.sampleCount > 0)
+    {
+        // Export wave data as audio file (.wav, .qoa) or code file (.h)
+        if (!paramsCode && (format == AUDIO_FORMAT_NONE)) ExportWaveFile(wave, job->outFileName, config->codeMode, config->wavMode);
+        if (config->analysis) SaveWaveAnalysis(analysis, wave, job->outFileName);
+
+        struct stat outStat = { 0 };
+
+        if ((stat(job->outFileName, &outStat) == 0) && S_ISREG(outStat.st_mode))
+        {
+            job->outSize = (long long)outStat.st_size;
+            job->duration = (float)wave.sampleCount/wave.sampleRate;
+
+            job->success = true;
+            printf("[%s] Exported: %s\n", job->inFileName, job->outFileName);
+        }
+        else printf("[%s] WARNING: Output file could not be saved: %s\n", job->inFileName, job->outFileName);
+    }
+    else printf("[%s] WARNING: Wave could not be generated\n", job->inFileName);
 
-    // NOTE: Wave can be converted to desired format after generation
+    UnloadWave(wave);
+}
+
+// Compare batch manifest entries by output file name (qsort, bsearch)
+static int CompareBatchManifestEntries(const void *a, const void *b)
+{
+    return strcmp(((const BatchManifestEntry *)a)->outFileName, ((const BatchManifestEntry *)b)->outFileName);
+}
+
+// Check if batch job output is up to date (incremental mode)
+// NOTE: Job input file state is always updated, file content is only hashed
+// if modification time or size changed since output was exported
+static bool IsBatchJobUpToDate(BatchConfig *config, BatchJob *job)
+{
+    struct stat inStat = { 0 };
+    struct stat outStat = { 0 };
+
+    if (stat(job->inFileName, &inStat) != 0) return false;
+
+    job->state.optionsHash = GetBatchOptionsHash(config);
+    job->state.modTime = (long long)inStat.st_mtime;
+    job->state.fileSize = (long long)inStat.st_size;
+
+    // Look for output file in previous batch manifest
+    // NOTE: Output file names that do not fit on manifest entries are never up to date (never saved to manifest)
+    BatchManifestEntry key = { 0 };
+    int nameLength = snprintf(key.outFileName, sizeof(key.outFileName), "%s", GetFileName(job->outFileName));
+    if ((nameLength < 0) || (nameLength >= (int)sizeof(key.outFileName))) return false;
+
+    BatchManifestEntry *entry = NULL;
+    if (config->manifestCount > 0) entry = (BatchManifestEntry *)bsearch(&key, config->manifest, config->manifestCount, sizeof(BatchManifestEntry), CompareBatchManifestEntries);
+
+    bool exported = (entry != NULL) && (entry->state.optionsHash == job->state.optionsHash) && (stat(job->outFileName, &outStat) == 0);
+
+    // Output info is kept from previous export, only saved again to manifest
+    if (exported)
+    {
+        job->duration = entry->duration;
+        job->outSize = (long long)outStat.st_size;
+    }
+
+    // Input file not modified since export, no need to read it
+    // NOTE: Modification time is only trusted if older than manifest (file could be modified again in same second)
+    if (exported && (entry->state.modTime == job->state.modTime) && (entry->state.fileSize == job->state.fileSize) &&
+        (job->state.modTime < config->manifestTime))
+    {
+        job->state.contentHash = entry->state.contentHash;
+        return true;
+    }
+
+    // Input file modified (or touched), check if content changed
+    if (!GetFileContentHash(job->inFileName, &job->state.contentHash)) return false;
+
+    return (exported && (entry->state.contentHash == job->state.contentHash));
+}
+
+// Get batch export options hash, saved to batch manifest
+// NOTE: Any option changing exported files (outputs or analysis sidecars) must be hashed
+static unsigned long long GetBatchOptionsHash(const BatchConfig *config)
+{
+    int options[8] = { RENDER_CACHE_VERSION, config->sampleRate, config->sampleSize, config->channels, config->quality, config->codeMode, config->wavMode, config->analysis };
+
+    return ComputeHash64(options, sizeof(options), 0);
+}
+
+// Load batch manifest, entries sorted by output file name
+// NOTE: Manifest is a text file, one line per output:
+// <contentHash> <optionsHash> <modTime> <fileSize> <duration> <outSize> <outFileName>
+static BatchManifestEntry *LoadBatchManifest(const char *fileName, int *count, long long *modTime)
+{
+    BatchManifestEntry *entries = NULL;
+    int capacity = 0;
+    *count = 0;
+    *modTime = 0;
+
+    struct stat manifestStat = { 0 };
+    if (stat(fileName, &manifestStat) == 0) *modTime = (long long)manifestStat.st_mtime;
+
+    FILE *manifestFile = fopen(fileName, "rt");
+
+    if (manifestFile != NULL)
+    {
+        char line[512] = { 0 };
+
+        while (fgets(line, 512, manifestFile) != NULL)
+        {
+            if (line[0] == '#') continue;       // Skip comment lines
+
+            BatchManifestEntry entry = { 0 };
+            int nameOffset = 0;
+
+            if (sscanf(line, "%llx %llx %lld %lld %f %lld %n", &entry.state.contentHash, &entry.state.optionsHash,
+                       &entry.state.modTime, &entry.state.fileSize, &entry.duration, &entry.outSize, &nameOffset) < 6) continue;
+
+            // Output file name is the rest of the line (it could contain spaces)
+            // NOTE: Names that do not fit are skipped, a truncated name could match a different output file
+            char *name = line + nameOffset;
+            int len = strlen(name);
+            while ((len > 0) && ((name[len - 1] == '\n') || (name[len - 1] == '\r'))) name[--len] = '\0';
+
+            if ((len == 0) || (len >= (int)sizeof(entry.outFileName))) continue;
+            strcpy(entry.outFileName, name);
+
+            if (*count >= capacity)
+            {
+                capacity = (capacity == 0)? 256 : capacity*2;
+                entries = (BatchManifestEntry *)realloc(entries, capacity*sizeof(BatchManifestEntry));
+            }
+
+            entries[*count] = entry;
+            (*count)++;
+        }
+
+        fclose(manifestFile);
+    }
+
+    if (*count > 0) qsort(entries, *count, sizeof(BatchManifestEntry), CompareBatchManifestEntries);
+
+    return entries;
+}
+
+// Save batch manifest for exported and up to date outputs
+// NOTE: Failed jobs are not saved, so they are processed again on next batch
+static void SaveBatchManifest(const char *fileName, BatchConfig config)
+{
+    BatchManifestEntry *entries = (BatchManifestEntry *)calloc((config.jobCount > 0)? config.jobCount : 1, sizeof(BatchManifestEntry));
+    int count = 0;
+
+    for (int i = 0; i < config.jobCount; i++)
+    {
+        BatchJob *job = &config.jobs[i];
+
+        // NOTE: Output file names that do not fit on manifest entries are not saved (never up to date)
+        if (job->success && (strlen(GetFileName(job->outFileName)) < sizeof(entries[count].outFileName)))
+        {
+            strcpy(entries[count].outFileName, GetFileName(job->outFileName));
+            entries[count].state = job->state;
+            entries[count].duration = job->duration;
+            entries[count].outSize = job->outSize;
+            count++;
+        }
+    }
+
+    if (!SaveBatchManifestEntries(fileName, entries, count)) printf("WARNING: Batch manifest could not be saved: %s\n", fileName);
+
+    free(entries);
+}
+
+// Save batch manifest entries, one line per output
+static bool SaveBatchManifestEntries(const char *fileName, const BatchManifestEntry *entries, int count)
+{
+    FILE *manifestFile = fopen(fileName, "wt");
+
+    if (manifestFile == NULL) return false;
+
+    fprintf(manifestFile, "# rFXGen v%s batch manifest\n", TOOL_VERSION_TEXT);
+    fprintf(manifestFile, "# <contentHash> <optionsHash> <modTime> <fileSize> <duration> <outSize> <outFileName>\n");
+
+    for (int i = 0; i < count; i++)
+    {
+        fprintf(manifestFile, "%016llx %016llx %lld %lld %.6f %lld %s\n", entries[i].state.contentHash, entries[i].state.optionsHash,
+                entries[i].state.modTime, entries[i].state.fileSize, entries[i].duration, entries[i].outSize, entries[i].outFileName);
+    }
+
+    fclose(manifestFile);
+
+    return true;
+}
+
+// Merge batch shard manifests into one manifest, entries sorted by output file name
+// NOTE: Input can be a directory (shard manifests are selected by name) or a wildcard pattern,
+// outputs found on several manifests are only saved once
+static void MergeBatchManifests(const char *input, const char *outFileName)
+{
+    char dirPath[256] = { 0 };
+    const char *pattern = BATCH_SHARD_MANIFEST_PATTERN;
+
+    if ((strchr(input, '*') != NULL) || (strchr(input, '?') != NULL))
+    {
+        const char *separator = strrchr(input, '/');
+        if (strrchr(input, '\\') > separator) separator = strrchr(input, '\\');
+
+        if (separator != NULL)
+        {
+            strncpy(dirPath, input, separator - input);
+            pattern = separator + 1;
+        }
+        else
+        {
+            strcpy(dirPath, ".");
+            pattern = input;
+        }
+    }
+    else strcpy(dirPath, input);
+
+    // Shard manifests are sorted by name, so merge result does not depend on directory listing order
+    int dirFileCount = 0;
+    char **dirFiles = GetDirectoryFiles(dirPath, &dirFileCount);
+
+    char (*manifestFiles)[256] = (char (*)[256])calloc((dirFileCount > 0)? dirFileCount : 1, 256);
+    int manifestCount = 0;
+
+    for (int i = 0; i < dirFileCount; i++)
+    {
+        if (MatchFilePattern(dirFiles[i], pattern) && (strcmp(dirFiles[i], GetFileName(outFileName)) != 0))
+        {
+            snprintf(manifestFiles[manifestCount], 256, "%s/%s", dirPath, dirFiles[i]);
+            manifestCount++;
+        }
+    }
+
+    ClearDirectoryFiles();
+
+    qsort(manifestFiles, manifestCount, 256, (int (*)(const void *, const void *))strcmp);
+
+    BatchManifestEntry *entries = NULL;
+    int count = 0;
+
+    for (int i = 0; i < manifestCount; i++)
+    {
+        int shardEntryCount = 0;
+        long long shardModTime = 0;
+        BatchManifestEntry *shardEntries = LoadBatchManifest(manifestFiles[i], &shardEntryCount, &shardModTime);
+
+        printf("[%s] Manifest entries: %i\n", manifestFiles[i], shardEntryCount);
+
+        if (shardEntryCount > 0)
+        {
+            entries = (BatchManifestEntry *)realloc(entries, (count + shardEntryCount)*sizeof(BatchManifestEntry));
+            memcpy(entries + count, shardEntries, shardEntryCount*sizeof(BatchManifestEntry));
+            count += shardEntryCount;
+        }
+
+        free(shardEntries);
+    }
+
+    if (manifestCount > 0)
+    {
+        // Outputs processed by several shards (stale shard manifests) are only saved once, newest input state is kept
+        qsort(entries, count, sizeof(BatchManifestEntry), CompareBatchManifestEntries);
+
+        int mergedCount = 0;
+        int duplicatedCount = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            if ((mergedCount > 0) && (strcmp(entries[mergedCount - 1].outFileName, entries[i].outFileName) == 0))
+            {
+                duplicatedCount++;
+                if (entries[i].state.modTime > entries[mergedCount - 1].state.modTime) entries[mergedCount - 1] = entries[i];
+            }
+            else entries[mergedCount++] = entries[i];
+        }
+
+        double totalDuration = 0.0;
+        long long totalSize = 0;
+
+        for (int i = 0; i < mergedCount; i++)
+        {
+            totalDuration += entries[i].duration;
+            totalSize += entries[i].outSize;
+        }
+
+        if (SaveBatchManifestEntries(outFileName, entries, mergedCount))
+        {
+            printf("\nManifests merged: %i shards, %i outputs (%i duplicated)\n", manifestCount, mergedCount, duplicatedCount);
+            printf("Total duration: %.2f seconds, total size: %lld bytes\n", totalDuration, totalSize);
+            printf("Merged manifest saved: %s\n", outFileName);
+        }
+        else printf("WARNING: Merged manifest could not be saved: %s\n", outFileName);
+    }
+    else printf("WARNING: No shard manifests found for merge input: %s\n", input);
+
+    free(entries);
+    free(manifestFiles);
+}
+
+// Save batch dependencies file (Make/Ninja depfile)
+// NOTE: One rule per output file: <outFileName>: <inFileName>, spaces are escaped
+static void SaveBatchDependencies(const char *fileName, BatchConfig config)
+{
+    FILE *depsFile = fopen(fileName, "wt");
+
+    if (depsFile != NULL)
+    {
+        for (int i = 0; i < config.jobCount; i++)
+        {
+            if (!config.jobs[i].success) continue;
+
+            const char *paths[2] = { config.jobs[i].outFileName, config.jobs[i].inFileName };
+
+            for (int p = 0; p < 2; p++)
+            {
+                for (const char *c = paths[p]; *c != '\0'; c++)
+                {
+                    if ((*c == ' ') || (*c == '#')) fputc('\\', depsFile);
+                    else if (*c == '$') fputc('$', depsFile);
+
+                    fputc(*c, depsFile);
+                }
+
+                fputs((p == 0)? ": " : "\n", depsFile);
+            }
+        }
+
+        fclose(depsFile);
+    }
+    else printf("WARNING: Batch dependencies could not be saved: %s\n", fileName);
+}
+
+// Get file content hash, returns false if file can not be read
+static bool GetFileContentHash(const char *fileName, unsigned long long *hash)
+{
+    FILE *file = fopen(fileName, "rb");
+
+    if (file == NULL) return false;
+
+    unsigned char buffer[4096];
+    int bytesRead = 0;
+
+    *hash = 0;
+    while ((bytesRead = fread(buffer, 1, 4096, file)) > 0) *hash = ComputeHash64(buffer, bytesRead, *hash);
+
+    fclose(file);
+
+    return true;
+}
+
+// Run synthesis benchmark over a fixed sounds corpus, results saved as JSON if file name provided
+// NOTE: Corpus covers all presets plus random sounds, BENCH_SOUNDS seeds per preset, every sound
+// is generated BENCH_RUNS times. Same corpus is always generated, so results can be compared between versions
+static void RunBenchmark(const char *jsonFileName)
+{
+    static const BenchPreset presets[BENCH_PRESETS] = {
+        { "PickupCoin", GenPickupCoin }, { "LaserShoot", GenLaserShoot }, { "Explosion", GenExplosion },
+        { "Powerup", GenPowerup }, { "HitHurt", GenHitHurt }, { "Jump", GenJump },
+        { "BlipSelect", GenBlipSelect }, { "Randomize", GenRandomize }
+    };
+
+    const int renderCount = BENCH_SOUNDS*BENCH_RUNS;
+
+    BenchResult results[BENCH_PRESETS + 1] = { 0 };
+    double *latencies = (double *)malloc(renderCount*sizeof(double));
+    double *allLatencies = (double *)malloc(BENCH_PRESETS*renderCount*sizeof(double));
+
+    printf("\nBenchmark corpus: %i presets, %i sounds per preset, %i runs per sound", BENCH_PRESETS, BENCH_SOUNDS, BENCH_RUNS);
+    printf("\nWave oscillator:  %s\n\n", SYNTH_OSCILLATOR_NAME);
+    printf("%-12s %8s %12s %14s %10s %9s %9s %9s %9s\n", "PRESET", "RENDERS", "SAMPLES", "SAMPLES/SEC", "NS/SAMPLE", "P50 MS", "P90 MS", "P99 MS", "MAX MS");
+
+    for (int p = 0; p < BENCH_PRESETS; p++)
+    {
+        BenchResult *result = &results[p];
+        result->name = presets[p].name;
+
+        // Warm-up: first generation of every sound is not measured
+        for (int s = 0; s < BENCH_SOUNDS; s++) UnloadWave(GenerateWave(presets[p].genFunc(s + 1)));
+
+        for (int run = 0; run < BENCH_RUNS; run++)
+        {
+            for (int s = 0; s < BENCH_SOUNDS; s++)
+            {
+                WaveParams params = presets[p].genFunc(s + 1);
+
+                double startTime = GetPreciseTime();
+                Wave wave = GenerateWave(params);
+                double elapsedTime = GetPreciseTime() - startTime;
+
+                latencies[result->renderCount] = elapsedTime*1000.0;
+                allLatencies[p*renderCount + result->renderCount] = elapsedTime*1000.0;
+                result->renderCount++;
+                result->sampleCount += wave.sampleCount;
+                result->seconds += elapsedTime;
+
+                UnloadWave(wave);
+            }
+        }
+
+        GetBenchLatencies(latencies, result->renderCount, result->latency);
+
+        results[BENCH_PRESETS].renderCount += result->renderCount;
+        results[BENCH_PRESETS].sampleCount += result->sampleCount;
+        results[BENCH_PRESETS].seconds += result->seconds;
+    }
+
+    results[BENCH_PRESETS].name = "Total";
+    GetBenchLatencies(allLatencies, results[BENCH_PRESETS].renderCount, results[BENCH_PRESETS].latency);
+
+    for (int i = 0; i <= BENCH_PRESETS; i++)
+    {
+        BenchResult *result = &results[i];
+        double seconds = (result->seconds > 0.0)? result->seconds : 1e-9;
+
+        if (i == BENCH_PRESETS) printf("\n");
+        printf("%-12s %8i %12lld %14.0f %10.2f %9.3f %9.3f %9.3f %9.3f\n", result->name, result->renderCount, result->sampleCount,
+               result->sampleCount/seconds, seconds*1e9/((result->sampleCount > 0)? result->sampleCount : 1),
+               result->latency[0], result->latency[1], result->latency[2], result->latency[3]);
+    }
+
+    // Quality benchmark: full corpus generated once per quality tier, compared against final quality
+    static const int qualities[BENCH_QUALITIES] = { SYNTH_QUALITY_DRAFT, SYNTH_QUALITY_LOW, SYNTH_QUALITY_MEDIUM, SYNTH_QUALITY_FINAL, SYNTH_QUALITY_ADAPTIVE };
+    static const char *qualityNames[BENCH_QUALITIES] = { "Draft", "Low", "Medium", "Final", "Adaptive" };
+    BenchResult qualityResults[BENCH_QUALITIES] = { 0 };
+
+    printf("\n");
+
+    for (int q = 0; q < BENCH_QUALITIES; q++)
+    {
+        BenchResult *result = &qualityResults[q];
+        result->name = qualityNames[q];
+
+        for (int p = 0; p < BENCH_PRESETS; p++)
+        {
+            for (int s = 0; s < BENCH_SOUNDS; s++)
+            {
+                WaveParams params = presets[p].genFunc(s + 1);
+
+                double startTime = GetPreciseTime();
+                Wave wave = GenerateWavePro(params, WAVE_SAMPLE_RATE, 32, 1, qualities[q]);
+                double elapsedTime = GetPreciseTime() - startTime;
+
+                result->renderCount++;
+                result->sampleCount += wave.sampleCount;
+                result->seconds += elapsedTime;
+
+                UnloadWave(wave);
+            }
+        }
+    }
+
+    for (int q = 0; q < BENCH_QUALITIES; q++)
+    {
+        BenchResult *result = &qualityResults[q];
+        double seconds = (result->seconds > 0.0)? result->seconds : 1e-9;
+
+        printf("Quality %-9s %10.2f ns/sample, x%.2f final quality speed\n", result->name, seconds*1e9/((result->sampleCount > 0)? result->sampleCount : 1),
+               qualityResults[3].seconds/seconds);
+    }
+
+    // Quality tiers check: generation cost must decrease with quality (Draft < Low < Medium < Final)
+    // NOTE: All tiers generate same samples count, generation time can be compared directly
+    bool qualityMonotonic = true;
+
+    for (int q = 0; q < (BENCH_QUALITIES - 2); q++)
+    {
+        if (qualityResults[q].seconds >= qualityResults[q + 1].seconds)
+        {
+            printf("WARNING: Quality %s is not faster than quality %s\n", qualityResults[q].name, qualityResults[q + 1].name);
+            qualityMonotonic = false;
+        }
+    }
+
+    if (qualityMonotonic) printf("Quality tiers check: generation cost decreases with quality\n");
+
+    // Mixer benchmark: voices are started every block, voices pool is kept full (voice stealing)
+    SynthMixer mixer = { 0 };
+    BenchResult mixerResult = { 0 };
+    mixerResult.name = "Mixer";
+    int mixerStolen = 0;
+
+    if (InitSynthMixer(&mixer, BENCH_MIXER_VOICES, BENCH_MIXER_VOICES*BENCH_MIXER_PLAYS))
+    {
+        float *buffer = (float *)malloc(BENCH_MIXER_FRAMES*sizeof(float));
+        double *blockLatencies = (double *)malloc(BENCH_MIXER_BLOCKS*sizeof(double));
+        long long voiceFrames = 0;
+
+        for (int block = 0; block < BENCH_MIXER_BLOCKS; block++)
+        {
+            for (int i = 0; i < BENCH_MIXER_PLAYS; i++)
+            {
+                int sound = block*BENCH_MIXER_PLAYS + i;
+                PlaySynthMixerVoice(&mixer, presets[sound%BENCH_PRESETS].genFunc(sound/BENCH_PRESETS%BENCH_SOUNDS + 1), 1.0f/BENCH_MIXER_PLAYS);
+            }
+
+            double startTime = GetPreciseTime();
+            int voices = RenderSynthMixer(&mixer, buffer, BENCH_MIXER_FRAMES);
+            double elapsedTime = GetPreciseTime() - startTime;
+
+            blockLatencies[block] = elapsedTime*1000.0;
+            voiceFrames += (long long)voices*BENCH_MIXER_FRAMES;
+            mixerResult.renderCount++;
+            mixerResult.sampleCount += BENCH_MIXER_FRAMES;
+            mixerResult.seconds += elapsedTime;
+        }
+
+        mixerStolen = mixer.stolenCount;
+
+        GetBenchLatencies(blockLatencies, mixerResult.renderCount, mixerResult.latency);
+
+        double seconds = (mixerResult.seconds > 0.0)? mixerResult.seconds : 1e-9;
+        printf("\nMixer: %i voices, %i blocks of %i frames, %i voices started per block, %i voices stolen\n",
+               BENCH_MIXER_VOICES, BENCH_MIXER_BLOCKS, BENCH_MIXER_FRAMES, BENCH_MIXER_PLAYS, mixerStolen);
+        printf("Mixer: %.0f ns/block, %.2f ns/voice sample, realtime x%.1f, block P50 %.3f ms, P99 %.3f ms, max %.3f ms\n",
+               seconds*1e9/mixerResult.renderCount, seconds*1e9/((voiceFrames > 0)? voiceFrames : 1),
+               (double)mixerResult.sampleCount/WAVE_SAMPLE_RATE/seconds, mixerResult.latency[0], mixerResult.latency[2], mixerResult.latency[3]);
+
+        free(buffer);
+        free(blockLatencies);
+        CloseSynthMixer(&mixer);
+    }
+
+    // Save benchmark results as JSON
+    if ((jsonFileName != NULL) && (jsonFileName[0] != '\0'))
+    {
+        FILE *jsonFile = fopen(jsonFileName, "wt");
+
+        if (jsonFile != NULL)
+        {
+            fprintf(jsonFile, "{\n");
+            fprintf(jsonFile, "    \"tool\": \"rFXGen\",\n");
+            fprintf(jsonFile, "    \"version\": \"%s\",\n", TOOL_VERSION_TEXT);
+            fprintf(jsonFile, "    \"oscillator\": \"%s\",\n", SYNTH_OSCILLATOR_NAME);
+            fprintf(jsonFile, "    \"sampleRate\": %i,\n", WAVE_SAMPLE_RATE);
+            fprintf(jsonFile, "    \"soundsPerPreset\": %i,\n", BENCH_SOUNDS);
+            fprintf(jsonFile, "    \"runsPerSound\": %i,\n", BENCH_RUNS);
+            fprintf(jsonFile, "    \"results\": [\n");
+
+            for (int i = 0; i <= BENCH_PRESETS; i++)
+            {
+                BenchResult *result = &results[i];
+                double seconds = (result->seconds > 0.0)? result->seconds : 1e-9;
+
+                fprintf(jsonFile, "        { \"preset\": \"%s\", \"renders\": %i, \"samples\": %lld, \"seconds\": %.6f, ", result->name, result->renderCount, result->sampleCount, result->seconds);
+                fprintf(jsonFile, "\"samplesPerSecond\": %.0f, \"nsPerSample\": %.3f, ", result->sampleCount/seconds, seconds*1e9/((result->sampleCount > 0)? result->sampleCount : 1));
+                fprintf(jsonFile, "\"latencyMs\": { \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f } }%s\n",
+                        result->latency[0], result->latency[1], result->latency[2], result->latency[3], (i < BENCH_PRESETS)? "," : "");
+            }
+
+            fprintf(jsonFile, "    ],\n");
+            fprintf(jsonFile, "    \"quality\": [\n");
+
+            for (int q = 0; q < BENCH_QUALITIES; q++)
+            {
+                BenchResult *result = &qualityResults[q];
+                double seconds = (result->seconds > 0.0)? result->seconds : 1e-9;
+
+                fprintf(jsonFile, "        { \"quality\": \"%s\", \"renders\": %i, \"samples\": %lld, \"seconds\": %.6f, \"nsPerSample\": %.3f }%s\n", result->name,
+                        result->renderCount, result->sampleCount, result->seconds, seconds*1e9/((result->sampleCount > 0)? result->sampleCount : 1), (q < (BENCH_QUALITIES - 1))? "," : "");
+            }
+
+            fprintf(jsonFile, "    ],\n");
+            fprintf(jsonFile, "    \"qualityMonotonic\": %s,\n", qualityMonotonic? "true" : "false");
+            fprintf(jsonFile, "    \"mixer\": { \"voices\": %i, \"blocks\": %i, \"framesPerBlock\": %i, \"stolen\": %i, \"seconds\": %.6f, ",
+                    BENCH_MIXER_VOICES, mixerResult.renderCount, BENCH_MIXER_FRAMES, mixerStolen, mixerResult.seconds);
+            fprintf(jsonFile, "\"blockLatencyMs\": { \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f } }\n",
+                    mixerResult.latency[0], mixerResult.latency[1], mixerResult.latency[2], mixerResult.latency[3]);
+            fprintf(jsonFile, "}\n");
+
+            fclose(jsonFile);
+
+            printf("\nBenchmark results saved: %s\n", jsonFileName);
+        }
+        else printf("WARNING: Benchmark results could not be saved: %s\n", jsonFileName);
+    }
+
+    free(latencies);
+    free(allLatencies);
+}
+
+// Get benchmark latency percentiles: p50, p90, p99 and max (values array is sorted)
+// NOTE: Nearest-rank percentiles
+static void GetBenchLatencies(double *values, int count, double *percentiles)
+{
+    static const double ranks[4] = { 50.0, 90.0, 99.0, 100.0 };
+
+    if (count <= 0) return;
+
+    qsort(values, count, sizeof(double), CompareDoubleValues);
+
+    for (int i = 0; i < 4; i++)
+    {
+        int index = (int)ceil(ranks[i]/100.0*count) - 1;
+        if (index < 0) index = 0;
+
+        percentiles[i] = values[index];
+    }
+}
+
+// Compare double values (qsort)
+static int CompareDoubleValues(const void *a, const void *b)
+{
+    double valueA = *(const double *)a;
+    double valueB = *(const double *)b;
+
+    return (valueA > valueB) - (valueA < valueB);
+}
+
+// Get high resolution time in seconds (no window required)
+static double GetPreciseTime(void)
+{
+#if defined(_WIN32)
+    unsigned long long frequency = 0, counter = 0;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return (double)counter/(double)frequency;
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+#endif
+}
+
+// Pack sound files into a sound bank file (.rfxb), sounds are named by file name (without extension)
+static void PackSoundBank(const char *input, const char *fileName, bool pcm, int sampleRate, int sampleSize, int channels, int quality)
+{
+    int count = 0;
+    BatchJob *jobs = LoadBatchJobs(input, ".", "rfx", &count);
+
+    char (*names)[SOUND_BANK_NAME_SIZE] = calloc((count > 0)? count : 1, SOUND_BANK_NAME_SIZE);
+    const char **namesList = (const char **)calloc((count > 0)? count : 1, sizeof(const char *));
+    WaveParams *params = (WaveParams *)calloc((count > 0)? count : 1, sizeof(WaveParams));
+
+    for (int i = 0; i < count; i++)
+    {
+        strncpy(names[i], GetFileName(jobs[i].inFileName), SOUND_BANK_NAME_SIZE - 1);
+
+        char *ext = strrchr(names[i], '.');
+        if (ext != NULL) *ext = '\0';
+
+        namesList[i] = names[i];
+        params[i] = LoadWaveParams(jobs[i].inFileName);
+    }
+
+    printf("\nPack input:       %s (%i files)", input, count);
+    printf("\nSound bank file:  %s", fileName);
+    if (pcm) printf("\nPCM format:       %i Hz, %i bits, %s\n\n", sampleRate, sampleSize, (channels == 1) ? "Mono" : "Stereo");
+    else printf("\nPCM format:       not included\n\n");
+
+    if (count > 0)
+    {
+        if (SaveSoundBank(fileName, namesList, params, count, pcm, sampleRate, sampleSize, channels, quality)) printf("Sound bank packed successfully\n");
+    }
+    else printf("WARNING: No .rfx or .sfs files found for pack input\n");
+
+    free(params);
+    free(namesList);
+    free(names);
+    free(jobs);
+}
+
+// Unpack sound bank file (.rfxb) into sound files (.rfx), pre-rendered PCM is exported as .wav (if available)
+static void UnpackSoundBank(const char *fileName, const char *outDir)
+{
+    SoundBank bank = LoadSoundBank(fileName);
+
+    if (bank.header == NULL) return;
+
+    MakeDirectory(outDir);
+
+    printf("\nSound bank file:  %s (%i sounds)", fileName, bank.header->soundCount);
+    printf("\nOutput directory: %s\n\n", outDir);
+
+    char outFileName[512] = { 0 };
+
+    for (int i = 0; i < bank.header->soundCount; i++)
+    {
+        snprintf(outFileName, 512, "%s/%s.rfx", outDir, bank.entries[i].name);
+        SaveWaveParams(GetSoundBankParams(&bank, i), outFileName);
+        printf("[%s] Unpacked\n", outFileName);
+
+        Wave wave = GetSoundBankWave(&bank, i);
+
+        if (wave.data != NULL)
+        {
+            snprintf(outFileName, 512, "%s/%s.wav", outDir, bank.entries[i].name);
+            ExportWaveFile(wave, outFileName, CODE_EXPORT_PCM, WAV_EXPORT_PCM);
+        }
+    }
+
+    UnloadSoundBank(bank);
+}
+
+// Show sound bank info: sounds names, duration and pre-rendered PCM
+static void ShowSoundBankInfo(const char *fileName)
+{
+    SoundBank bank = LoadSoundBank(fileName);
+
+    if (bank.header == NULL) return;
+
+    printf("\nSound bank file:  %s", fileName);
+    printf("\nNum sounds:       %i", bank.header->soundCount);
+    if (bank.pcm != NULL) printf("\nPCM format:       %i Hz, %i bits, %s\n\n", bank.header->sampleRate, bank.header->sampleSize, (bank.header->channels == 1) ? "Mono" : "Stereo");
+    else printf("\nPCM format:       not included\n\n");
+
+    for (int i = 0; i < bank.header->soundCount; i++)
+    {
+        printf("    %-32s %.3f s", bank.entries[i].name, GetWaveDuration(GetSoundBankParams(&bank, i)));
+        if (bank.pcm != NULL) printf(" (%i samples)", bank.entries[i].pcmSampleCount);
+        printf("\n");
+    }
+
+    UnloadSoundBank(bank);
+}
+
+// Find near-duplicate sounds: sounds are rendered and fingerprinted in parallel, similar fingerprints found by LSH index
+// NOTE: Only fingerprints sharing a LSH bucket are compared, first sound (by file name) of every group is kept
+static void RunDedup(const char *input, const char *outFileName, float similarity, int threadCount)
+{
+    DedupConfig config = { 0 };
+    config.jobs = LoadBatchJobs(input, ".", "rfx", &config.jobCount);
+
+    int count = config.jobCount;
+
+    // Sounds sorted by file name, groups keepers do not depend on directory listing order
+    if (count > 0) qsort(config.jobs, count, sizeof(BatchJob), CompareBatchJobs);
+
+    printf("\nDedup input:      %s (%i files)", input, count);
+    printf("\nSimilarity:       %.3f", similarity);
+    printf("\nWorker threads:   %i\n\n", (threadCount < count) ? threadCount : count);
+
+    if (count <= 0)
+    {
+        printf("WARNING: No .rfx or .sfs files found for dedup input\n");
+        free(config.jobs);
+        return;
+    }
+
+    config.fingerprints = calloc(count, sizeof(*config.fingerprints));
+    config.durations = (float *)calloc(count, sizeof(float));
+
+    double startTime = GetPreciseTime();
+    RunJobsParallel(ProcessDedupJob, &config, count, threadCount);
+    double fingerprintTime = GetPreciseTime() - startTime;
+
+    // Mean fingerprint is removed for LSH signatures, otherwise all fingerprints (positive values) fall in few buckets
+    float mean[DEDUP_FINGERPRINT_SIZE] = { 0 };
+
+    for (int i = 0; i < count; i++)
+    {
+        for (int k = 0; k < DEDUP_FINGERPRINT_SIZE; k++) mean[k] += config.fingerprints[i][k]/count;
+    }
+
+    // LSH index: every table keeps fingerprints sorted by random hyperplanes signature (bucket key)
+    // NOTE: Hyperplanes are generated from a fixed seed, index is the same on every run
+    float (*planes)[DEDUP_FINGERPRINT_SIZE] = calloc(DEDUP_LSH_BITS, sizeof(*planes));
+    unsigned long long *buckets = (unsigned long long *)malloc(DEDUP_LSH_TABLES*count*sizeof(unsigned long long));
+    int *positions = (int *)malloc(DEDUP_LSH_TABLES*count*sizeof(int));
+
+    for (int table = 0; table < DEDUP_LSH_TABLES; table++)
+    {
+        unsigned long long *tableBuckets = &buckets[table*count];
+
+        for (int bit = 0; bit < DEDUP_LSH_BITS; bit++)
+        {
+            for (int k = 0; k < DEDUP_FINGERPRINT_SIZE; k++)
+            {
+                // Approximated normal distribution: sum of 4 uniform values
+                unsigned int seed[3] = { table, bit, k };
+                unsigned long long hash = ComputeHash64(seed, sizeof(seed), 0xcbf29ce484222325ULL);
+
+                planes[bit][k] = 0.0f;
+                for (int u = 0; u < 4; u++) planes[bit][k] += (float)((hash >> (u*16)) & 0xFFFF)/65535.0f - 0.5f;
+            }
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            unsigned int signature = 0;
+
+            for (int bit = 0; bit < DEDUP_LSH_BITS; bit++)
+            {
+                float dot = 0.0f;
+                for (int k = 0; k < DEDUP_FINGERPRINT_SIZE; k++) dot += (config.fingerprints[i][k] - mean[k])*planes[bit][k];
+
+                if (dot >= 0.0f) signature |= (1u << bit);
+            }
+
+            tableBuckets[i] = ((unsigned long long)signature << 32) | (unsigned int)i;
+        }
+
+        qsort(tableBuckets, count, sizeof(unsigned long long), CompareDedupBuckets);
+
+        for (int p = 0; p < count; p++) positions[table*count + (int)(tableBuckets[p] & 0xFFFFFFFF)] = p;
+    }
+
+    // Group sounds in input order: every sound is compared with previous groups keepers sharing any bucket,
+    // sound joins most similar keeper group or it becomes a new group keeper
+    // NOTE: Sounds are only compared with keepers, similar sounds are not chained into one group
+    int *groups = (int *)malloc(count*sizeof(int));
+    int *lastCompared = (int *)malloc(count*sizeof(int));
+    float *groupSimilarity = (float *)calloc(count, sizeof(float));
+    long long pairCount = 0;
+
+    for (int i = 0; i < count; i++) { groups[i] = i; lastCompared[i] = -1; }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (config.durations[i] <= 0.0f) continue;
+
+        int bestKeeper = -1;
+        float bestSimilarity = similarity;
+
+        for (int table = 0; table < DEDUP_LSH_TABLES; table++)
+        {
+            unsigned long long *tableBuckets = &buckets[table*count];
+            int start = positions[table*count + i];
+            int end = start;
+
+            while ((start > 0) && ((tableBuckets[start - 1] >> 32) == (tableBuckets[end] >> 32))) start--;
+            while (((end + 1) < count) && ((tableBuckets[end + 1] >> 32) == (tableBuckets[start] >> 32))) end++;
+
+            for (int p = start; p <= end; p++)
+            {
+                int keeper = (int)(tableBuckets[p] & 0xFFFFFFFF);
+
+                if ((keeper >= i) || (groups[keeper] != keeper) || (lastCompared[keeper] == i) || (config.durations[keeper] <= 0.0f)) continue;
+                lastCompared[keeper] = i;
+
+                if (fabsf(config.durations[keeper] - config.durations[i]) > DEDUP_DURATION_TOLERANCE*fmaxf(config.durations[keeper], config.durations[i])) continue;
+
+                pairCount++;
+
+                float value = GetFingerprintSimilarity(config.fingerprints[keeper], config.fingerprints[i]);
+
+                if (value >= bestSimilarity)
+                {
+                    bestKeeper = keeper;
+                    bestSimilarity = value;
+                }
+            }
+        }
+
+        if (bestKeeper != -1)
+        {
+            groups[i] = bestKeeper;
+            groupSimilarity[i] = bestSimilarity;
+        }
+    }
+
+    // Show duplicates groups, duplicates list optionally saved (one file name per line)
+    FILE *outFile = ((outFileName != NULL) && (outFileName[0] != '\0'))? fopen(outFileName, "wt") : NULL;
+    int groupCount = 0;
+    int duplicateCount = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        bool keepShown = false;
+
+        for (int j = i + 1; (j < count) && (groups[i] == i); j++)
+        {
+            if (groups[j] != i) continue;
+
+            if (!keepShown)
+            {
+                groupCount++;
+                printf("[group %i] keep: %s\n", groupCount, config.jobs[i].inFileName);
+                keepShown = true;
+            }
+
+            printf("    duplicate: %s (%.4f)\n", config.jobs[j].inFileName, groupSimilarity[j]);
+
+            if (outFile != NULL) fprintf(outFile, "%s\n", config.jobs[j].inFileName);
+            duplicateCount++;
+        }
+    }
+
+    if (outFile != NULL)
+    {
+        fclose(outFile);
+        printf("\nDuplicates list saved: %s\n", outFileName);
+    }
+
+    printf("\nDedup processed: %i files fingerprinted in %.3f s, %lld pairs compared (of %lld), %i groups, %i duplicates\n",
+           count, fingerprintTime, pairCount, (long long)count*(count - 1)/2, groupCount, duplicateCount);
+
+    free(planes);
+    free(buckets);
+    free(positions);
+    free(groups);
+    free(lastCompared);
+    free(groupSimilarity);
+    free(config.fingerprints);
+    free(config.durations);
+    free(config.jobs);
+}
+
+// Process one dedup job: load sound, generate wave and compute fingerprint
+// NOTE: Called from worker threads, only thread-safe functions should be used
+static void ProcessDedupJob(void *userData, int index)
+{
+    DedupConfig *config = (DedupConfig *)userData;
+
+    WaveParams params = LoadWaveParams(config->jobs[index].inFileName);
+    Wave wave = GenerateWaveCached(params, WAVE_SAMPLE_RATE, 32, 1, SYNTH_QUALITY_FINAL, NULL);
+
+    if (wave.sampleCount > 0)
+    {
+        ComputeWaveFingerprint(wave, config->fingerprints[index]);
+        config->durations[index] = (float)wave.sampleCount/wave.sampleRate;
+        config->jobs[index].success = true;
+    }
+    else printf("[%s] WARNING: Wave could not be generated\n", config->jobs[index].inFileName);
+
+    UnloadWave(wave);
+}
+
+// Compute wave fingerprint: loudness envelope of DEDUP_BANDS bands over DEDUP_FRAMES frames (normalized vector)
+// NOTE: Wave must be 32 bit mono, bands split with one-pole lowpass filters, loudness approximated as energy^(1/3)
+static void ComputeWaveFingerprint(Wave wave, float *fingerprint)
+{
+    static const float bandFrequencies[DEDUP_BANDS - 1] = { 400.0f, 1600.0f, 6400.0f };
+
+    float coeficients[DEDUP_BANDS - 1] = { 0 };
+    float filters[DEDUP_BANDS - 1] = { 0 };
+    float *samples = (float *)wave.data;
+
+    for (int b = 0; b < (DEDUP_BANDS - 1); b++) coeficients[b] = 1.0f - expf(-2.0f*PI*bandFrequencies[b]/wave.sampleRate);
+
+    memset(fingerprint, 0, DEDUP_FINGERPRINT_SIZE*sizeof(float));
+
+    for (int frame = 0; frame < DEDUP_FRAMES; frame++)
+    {
+        int start = (int)((long long)wave.sampleCount*frame/DEDUP_FRAMES);
+        int end = (int)((long long)wave.sampleCount*(frame + 1)/DEDUP_FRAMES);
+        float *bands = &fingerprint[frame*DEDUP_BANDS];
+
+        for (int i = start; i < end; i++)
+        {
+            float sample = isfinite(samples[i])? samples[i] : 0.0f;   // Unstable filters could generate NaN samples
+            float low = 0.0f;
+
+            for (int b = 0; b < (DEDUP_BANDS - 1); b++)
+            {
+                filters[b] += coeficients[b]*(sample - filters[b]);
+                bands[b] += (filters[b] - low)*(filters[b] - low);
+                low = filters[b];
+            }
+
+            bands[DEDUP_BANDS - 1] += (sample - low)*(sample - low);
+        }
+
+        for (int b = 0; b < DEDUP_BANDS; b++) bands[b] = cbrtf(bands[b]/((end > start)? (end - start) : 1));
+    }
+
+    float length = 0.0f;
+    for (int k = 0; k < DEDUP_FINGERPRINT_SIZE; k++) length += fingerprint[k]*fingerprint[k];
+
+    length = sqrtf(length);
+    if (length > 0.0f) for (int k = 0; k < DEDUP_FINGERPRINT_SIZE; k++) fingerprint[k] /= length;
+}
+
+// Get fingerprints similarity (cosine similarity, fingerprints are normalized)
+static float GetFingerprintSimilarity(const float *a, const float *b)
+{
+    float dot = 0.0f;
+    for (int k = 0; k < DEDUP_FINGERPRINT_SIZE; k++) dot += a[k]*b[k];
+
+    return dot;
+}
+
+// Compare dedup LSH buckets entries: signature and sound index (qsort)
+static int CompareDedupBuckets(const void *a, const void *b)
+{
+    unsigned long long valueA = *(const unsigned long long *)a;
+    unsigned long long valueB = *(const unsigned long long *)b;
+
+    return (valueA > valueB) - (valueA < valueB);
+}
+
+// Compare batch jobs by input file name (qsort)
+static int CompareBatchJobs(const void *a, const void *b)
+{
+    return strcmp(((const BatchJob *)a)->inFileName, ((const BatchJob *)b)->inFileName);
+}
+
+// Serve render requests from stdin until closed (line protocol), requests are processed by worker threads
+// NOTE: Responses are written to stdout, any other output is redirected to stderr while serving
+static void RunServe(int sampleRate, int sampleSize, int channels, int quality, int threadCount)
+{
+    ServeQueue queue = { 0 };
+    queue.requests = (ServeRequest *)calloc(SERVE_QUEUE_SIZE, sizeof(ServeRequest));
+    pthread_mutex_init(&queue.lock, NULL);
+    pthread_cond_init(&queue.notEmpty, NULL);
+    pthread_cond_init(&queue.notFull, NULL);
+    pthread_mutex_init(&queue.outputLock, NULL);
+
+    // Responses output is stdout, stdout is redirected to stderr (messages can not break responses)
+    fflush(stdout);
+#if defined(_WIN32)
+    int outputFile = _dup(_fileno(stdout));
+    _dup2(_fileno(stderr), _fileno(stdout));
+    _setmode(outputFile, _O_BINARY);
+    queue.output = _fdopen(outputFile, "wb");
+#else
+    int outputFile = dup(fileno(stdout));
+    dup2(fileno(stderr), fileno(stdout));
+    queue.output = fdopen(outputFile, "wb");
+#endif
+
+    if (threadCount > MAX_JOB_THREADS) threadCount = MAX_JOB_THREADS;
+
+    pthread_t threads[MAX_JOB_THREADS] = { 0 };
+    int threadsStarted = 0;
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        if (pthread_create(&threads[threadsStarted], NULL, ServeWorkerThread, &queue) == 0) threadsStarted++;
+    }
+
+    printf("\nServe mode: %i worker threads, waiting for requests on stdin\n", threadsStarted);
+    printf("Default format:   %i Hz, %i bits, %s\n", sampleRate, sampleSize, (channels == 1) ? "Mono" : "Stereo");
+    fflush(stdout);
+
+    char line[SERVE_MAX_LINE] = { 0 };
+    int requestCount = 0;
+
+    while ((threadsStarted > 0) && (fgets(line, SERVE_MAX_LINE, stdin) != NULL))
+    {
+        int length = (int)strlen(line);
+
+        // Too long lines are skipped until line end
+        if ((length == (SERVE_MAX_LINE - 1)) && (line[length - 1] != '\n'))
+        {
+            int c = 0;
+            while (((c = getchar()) != EOF) && (c != '\n')) { }
+
+            SendServeResponse(&queue, "-", "error Request line too long", NULL, 0);
+            continue;
+        }
+
+        while ((length > 0) && isspace((unsigned char)line[length - 1])) line[--length] = '\0';
+        if ((length == 0) || (line[0] == '#')) continue;     // Empty lines and comments are skipped
+
+        ServeRequest request = { 0 };
+        request.sampleRate = sampleRate;
+        request.sampleSize = sampleSize;
+        request.channels = channels;
+        request.quality = quality;
+
+        const char *error = ParseServeRequest(line, &request);
+
+        if (error != NULL)
+        {
+            char response[128] = { 0 };
+            snprintf(response, 128, "error %s", error);
+            SendServeResponse(&queue, (request.id[0] != '\0')? request.id : "-", response, NULL, 0);
+        }
+        else if (request.type == SERVE_REQUEST_QUIT) break;
+        else if (request.type == SERVE_REQUEST_PING) SendServeResponse(&queue, request.id, "ok", NULL, 0);
+        else
+        {
+            // Add request to queue, waiting for a free position if queue is full
+            pthread_mutex_lock(&queue.lock);
+            while (queue.count == SERVE_QUEUE_SIZE) pthread_cond_wait(&queue.notFull, &queue.lock);
+            queue.requests[(queue.head + queue.count)%SERVE_QUEUE_SIZE] = request;
+            queue.count++;
+            pthread_cond_signal(&queue.notEmpty);
+            pthread_mutex_unlock(&queue.lock);
+
+            requestCount++;
+        }
+    }
+
+    // Pending requests are finished before closing
+    pthread_mutex_lock(&queue.lock);
+    queue.closed = true;
+    pthread_cond_broadcast(&queue.notEmpty);
+    pthread_mutex_unlock(&queue.lock);
+
+    for (int i = 0; i < threadsStarted; i++) pthread_join(threads[i], NULL);
+
+    printf("Serve mode finished: %i render requests processed\n", requestCount);
+    if (renderCache.directory[0] != '\0') printf("Render cache: %i reused, %i generated\n", renderCache.hitCount, renderCache.missCount);
+
+    fclose(queue.output);
+
+    pthread_mutex_destroy(&queue.outputLock);
+    pthread_cond_destroy(&queue.notFull);
+    pthread_cond_destroy(&queue.notEmpty);
+    pthread_mutex_destroy(&queue.lock);
+    free(queue.requests);
+}
+
+// Parse serve request line: <id> <command> [arguments], returns error message (NULL if valid)
+// NOTE: Optional format (<sample_rate>,<sample_size>,<channels>) and quality arguments can be provided in any order
+static const char *ParseServeRequest(const char *line, ServeRequest *request)
+{
+    char command[16] = { 0 };
+    char args[4][SERVE_MAX_LINE] = { 0 };
+
+    if (strcmp(line, "quit") == 0)
+    {
+        request->type = SERVE_REQUEST_QUIT;
+        return NULL;
+    }
+
+    int count = sscanf(line, "%63s %15s %1023s %1023s %1023s %1023s", request->id, command, args[0], args[1], args[2], args[3]);
+    int optionsStart = 0;
+
+    if (count < 2) return "Request command not provided";
+    else if (strcmp(command, "ping") == 0)
+    {
+        request->type = SERVE_REQUEST_PING;
+        return NULL;
+    }
+    else if (strcmp(command, "quit") == 0)
+    {
+        request->type = SERVE_REQUEST_QUIT;
+        return NULL;
+    }
+    else if (strcmp(command, "render") == 0)
+    {
+        if (count < 4) return "Render request requires input and output";
+        if (!IsFileExtension(args[1], ".wav") && !IsFileExtension(args[1], ".qoa") && !IsFileExtension(args[1], ".h")) return "Output file extension not supported";
+        if (strlen(args[1]) > 255) return "Output file name too long";
+
+        request->type = SERVE_REQUEST_RENDER;
+        strcpy(request->outFileName, args[1]);
+        optionsStart = 2;
+    }
+    else if (strcmp(command, "pcm") == 0)
+    {
+        if (count < 3) return "PCM request requires input";
+
+        request->type = SERVE_REQUEST_PCM;
+        optionsStart = 1;
+    }
+    else return "Request command not supported";
+
+    strcpy(request->input, args[0]);
+
+    // Read optional format and quality arguments
+    for (int i = optionsStart; i < (count - 2); i++)
+    {
+        if (strchr(args[i], ',') != NULL)
+        {
+            if ((sscanf(args[i], "%i,%i,%i", &request->sampleRate, &request->sampleSize, &request->channels) != 3) ||
+                ((request->sampleRate != 44100) && (request->sampleRate != 22050)) ||
+                ((request->sampleSize != 8) && (request->sampleSize != 16) && (request->sampleSize != 32)) ||
+                ((request->channels != 1) && (request->channels != 2))) return "Format not supported";
+        }
+        else if (strcmp(args[i], "adaptive") == 0) request->quality = SYNTH_QUALITY_ADAPTIVE;
+        else if ((strcmp(args[i], "1") == 0) || (strcmp(args[i], "2") == 0) || (strcmp(args[i], "4") == 0) || (strcmp(args[i], "8") == 0)) request->quality = atoi(args[i]);
+        else return "Argument not supported";
+    }
+
+    return NULL;
+}
+
+// Serve worker thread: process queued requests until queue is closed and empty
+static void *ServeWorkerThread(void *arg)
+{
+    ServeQueue *queue = (ServeQueue *)arg;
+    ServeRequest request = { 0 };
+
+    while (true)
+    {
+        pthread_mutex_lock(&queue->lock);
+        while ((queue->count == 0) && !queue->closed) pthread_cond_wait(&queue->notEmpty, &queue->lock);
+
+        if (queue->count == 0)
+        {
+            pthread_mutex_unlock(&queue->lock);
+            break;
+        }
+
+        request = queue->requests[queue->head];
+        queue->head = (queue->head + 1)%SERVE_QUEUE_SIZE;
+        queue->count--;
+        pthread_cond_signal(&queue->notFull);
+        pthread_mutex_unlock(&queue->lock);
+
+        ProcessServeRequest(queue, &request);
+    }
+
+    return NULL;
+}
+
+// Process render request: generate wave (render cache is used) and send response
+// NOTE: Called from worker threads, only thread-safe functions should be used
+static void ProcessServeRequest(ServeQueue *queue, ServeRequest *request)
+{
+    WaveParams params = { 0 };
+
+    if (!LoadServeParams(request->input, &params))
+    {
+        SendServeResponse(queue, request->id, "error Input could not be loaded", NULL, 0);
+        return;
+    }
+
+    Wave wave = GenerateWaveCached(params, request->sampleRate, request->sampleSize, request->channels, request->quality, NULL);
+
+    if (wave.sampleCount == 0) SendServeResponse(queue, request->id, "error Wave could not be generated", NULL, 0);
+    else if (request->type == SERVE_REQUEST_PCM)
+    {
+        char response[128] = { 0 };
+        int dataSize = wave.sampleCount*wave.channels*wave.sampleSize/8;
+        snprintf(response, 128, "pcm %i %i %i %i", dataSize, wave.sampleRate, wave.sampleSize, wave.channels);
+
+        SendServeResponse(queue, request->id, response, wave.data, dataSize);
+    }
+    else
+    {
+        // Export wave data as audio file (.wav) or code file (.h), output file is checked after export
+        remove(request->outFileName);
+        ExportWaveFile(wave, request->outFileName, CODE_EXPORT_PCM, WAV_EXPORT_PCM);
+
+        struct stat outStat = { 0 };
+        char response[SERVE_MAX_LINE] = { 0 };
+
+        if (stat(request->outFileName, &outStat) == 0) snprintf(response, SERVE_MAX_LINE, "ok %s %i", request->outFileName, wave.sampleCount);
+        else snprintf(response, SERVE_MAX_LINE, "error Output file could not be saved");
+
+        SendServeResponse(queue, request->id, response, NULL, 0);
+    }
+
+    UnloadWave(wave);
+}
+
+// Load wave parameters from serve request input: sound file (.rfx, .sfs) or hex text (params:<hex>)
+// NOTE: Hex text is the .rfx wave parameters data, 2 hex digits per byte
+static bool LoadServeParams(const char *input, WaveParams *params)
+{
+    if (strncmp(input, "params:", 7) == 0)
+    {
+        const char *hex = input + 7;
+        unsigned char *data = (unsigned char *)params;
+
+        if (strlen(hex) != 2*sizeof(WaveParams)) return false;
+
+        for (int i = 0; i < (int)sizeof(WaveParams); i++)
+        {
+            unsigned int value = 0;
+            if (!isxdigit((unsigned char)hex[2*i]) || !isxdigit((unsigned char)hex[2*i + 1]) || (sscanf(hex + 2*i, "%2x", &value) != 1)) return false;
+            data[i] = (unsigned char)value;
+        }
+
+        return true;
+    }
+
+    if (!IsFileExtension(input, ".rfx") && !IsFileExtension(input, ".sfs")) return false;
+
+    FILE *inFile = fopen(input, "rb");
+    if (inFile == NULL) return false;
+    fclose(inFile);
+
+    *params = LoadWaveParams(input);
+
+    return true;
+}
+
+// Send serve response line: <id> <text>, followed by data if provided
+// NOTE: Responses from different threads are never mixed, output is flushed after every response
+static void SendServeResponse(ServeQueue *queue, const char *id, const char *text, const void *data, int dataSize)
+{
+    pthread_mutex_lock(&queue->outputLock);
+
+    fprintf(queue->output, "%s %s\n", id, text);
+    if ((data != NULL) && (dataSize > 0)) fwrite(data, 1, dataSize, queue->output);
+    fflush(queue->output);
+
+    pthread_mutex_unlock(&queue->outputLock);
+}
+
+#if defined(SYNTH_PROFILE)
+// Init profile trace, synth profile counters are reset and events recorded into trace
+static void InitProfileTrace(ProfileTrace *trace)
+{
+    memset(trace, 0, sizeof(ProfileTrace));
+
+    pthread_mutex_init(&trace->lock, NULL);
+    trace->threads[0] = pthread_self();
+    trace->threadCount = 1;
+    trace->startTime = GetSynthProfileTime();
+
+    ResetSynthProfile();
+    SetSynthProfileCallback(RecordProfileTraceEvent, trace);
+}
+
+// Close profile trace, events recording stopped
+// NOTE: Recorded events are kept for summary and trace saving
+static void CloseProfileTrace(ProfileTrace *trace)
+{
+    SetSynthProfileCallback(NULL, NULL);
+    pthread_mutex_destroy(&trace->lock);
+}
+
+// Record synth profile event into trace (synth profile callback)
+// NOTE: Called from generation threads (batch and explore workers), events are appended under lock
+static void RecordProfileTraceEvent(int stage, double startTime, double duration, unsigned long long count, void *userData)
+{
+    ProfileTrace *trace = (ProfileTrace *)userData;
+
+    pthread_mutex_lock(&trace->lock);
+
+    // Get calling thread index, threads are numbered in order of first event
+    int thread = 0;
+    pthread_t self = pthread_self();
+
+    while ((thread < trace->threadCount) && !pthread_equal(trace->threads[thread], self)) thread++;
+
+    if (thread == trace->threadCount)
+    {
+        if (trace->threadCount < (MAX_JOB_THREADS + 1)) trace->threads[trace->threadCount++] = self;
+        else thread = 0;        // NOTE: Not expected, jobs pool threads are limited to MAX_JOB_THREADS
+    }
+
+    if (trace->eventCount == trace->eventCapacity)
+    {
+        int capacity = (trace->eventCapacity > 0)? trace->eventCapacity*2 : 1024;
+        ProfileTraceEvent *events = (ProfileTraceEvent *)realloc(trace->events, capacity*sizeof(ProfileTraceEvent));
+
+        if (events != NULL)
+        {
+            trace->events = events;
+            trace->eventCapacity = capacity;
+        }
+    }
+
+    if (trace->eventCount < trace->eventCapacity)
+    {
+        ProfileTraceEvent *event = &trace->events[trace->eventCount++];
+        event->stage = stage;
+        event->thread = thread;
+        event->startTime = startTime;
+        event->duration = duration;
+        event->count = count;
+    }
+
+    pthread_mutex_unlock(&trace->lock);
+}
+
+// Show profile summary table: stages count and time
+// NOTE: Filter, phaser and noise stages are part of synth loop, their time is estimated from timed events
+static void ShowProfileSummary(ProfileTrace *trace)
+{
+    SynthProfileCounter counters[SYNTH_PROFILE_STAGES] = { 0 };
+    GetSynthProfile(counters);
+
+    // Total time for top level stages, synth loop stages are included in synth time
+    double totalTime = 0.0;
+    int topStages[4] = { SYNTH_PROFILE_RESET, SYNTH_PROFILE_SYNTH, SYNTH_PROFILE_FORMAT, SYNTH_PROFILE_EXPORT };
+    for (int i = 0; i < 4; i++) totalTime += counters[topStages[i]].time*1e-9;
+
+    printf("\nProfile: %i events, %i threads, %.3f s elapsed\n\n", trace->eventCount, trace->threadCount, GetSynthProfileTime() - trace->startTime);
+    printf("STAGE              COUNT      TOTAL MS      AVG US    TIME %%\n");
+
+    for (int i = 0; i < SYNTH_PROFILE_STAGES; i++)
+    {
+        bool loopStage = ((i == SYNTH_PROFILE_FILTER) || (i == SYNTH_PROFILE_PHASER) || (i == SYNTH_PROFILE_NOISE));
+        double time = counters[i].time*1e-9;
+
+        printf("%s%-*s %12llu  %12.3f  %10.3f  %8.1f\n", loopStage? "  " : "", loopStage? 10 : 12, GetSynthProfileStageName(i), counters[i].count,
+               time*1000.0, (counters[i].count > 0)? time*1e6/counters[i].count : 0.0, (totalTime > 0.0)? time*100.0/totalTime : 0.0);
+    }
+
+    printf("\nNOTE: Times are measured per thread, filter, phaser and noise are part of synth (timed every %i events)\n", SYNTH_PROFILE_INTERVAL);
+}
+
+// Save profile trace as Chrome trace file (.json), events complete type ("X"), times in microseconds
+static void SaveProfileTrace(ProfileTrace *trace, const char *fileName)
+{
+    FILE *traceFile = fopen(fileName, "wt");
+
+    if (traceFile == NULL)
+    {
+        printf("WARNING: Profile trace could not be saved: %s\n", fileName);
+        return;
+    }
+
+    fprintf(traceFile, "{\n  \"traceEvents\": [\n");
+
+    // Threads names (metadata events), there is always one thread (main)
+    for (int i = 0; i < trace->threadCount; i++)
+    {
+        fprintf(traceFile, "%s    { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %i, \"args\": { \"name\": \"%s %i\" } }",
+                (i > 0)? ",\n" : "", i, (i == 0)? "main" : "worker", i);
+    }
+
+    for (int i = 0; i < trace->eventCount; i++)
+    {
+        ProfileTraceEvent *event = &trace->events[i];
+
+        fprintf(traceFile, ",\n    { \"name\": \"%s\", \"cat\": \"rfxgen\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %i, \"args\": { \"count\": %llu } }",
+                GetSynthProfileStageName(event->stage), (event->startTime - trace->startTime)*1e6, event->duration*1e6, event->thread, event->count);
+    }
+
+    fprintf(traceFile, "\n  ],\n  \"displayTimeUnit\": \"ms\"\n}\n");
+    fclose(traceFile);
+
+    printf("Profile trace saved: %s\n", fileName);
+}
+#endif
+#endif      // VERSION_ONE
+
+//--------------------------------------------------------------------------------------------
+// Load/Save/Export functions
+//--------------------------------------------------------------------------------------------
+
+#if !defined(COMMAND_LINE_ONLY)
+// Show dialog: load sound parameters file
+static WaveParams DialogLoadSound(void)
+{
+    WaveParams params = { 0 };
+    
+    // Open file dialog
+    const char *filters[] = { "*.rfx", "*.sfs" };
+    const char *fileName = tinyfd_openFileDialog("Load sound parameters file", "", 2, filters, "Sound Param Files (*.rfx, *.sfs)", 0);
+
+    if (fileName != NULL)
+    {
+        params = LoadWaveParamsEx(fileName, &volumeValue);
+        //SetWindowTitle(FormatText("rFXGen v%s - %s", TOOL_VERSION_TEXT, GetFileName(fileName)));
+    }
+    
+    return params;
+}
+
+// Show dialog: save sound parameters file
+static void DialogSaveSound(WaveParams params)
+{
+    // Save file dialog
+    const char *filters[] = { "*.rfx" };
+    const char *fileName = tinyfd_saveFileDialog("Save sound parameters file", "sound.rfx", 1, filters, "Sound Param Files (*.rfx)");
+
+    if (fileName != NULL)
+    {
+        char outFileName[128] = { 0 };
+        strcpy(outFileName, fileName);
+
+        // Check for valid extension and make sure it is
+        if ((GetExtension(outFileName) == NULL) || !IsFileExtension(outFileName, ".rfx")) strcat(outFileName, ".rfx\0");
+
+        // Save wave parameters
+        SaveWaveParams(params, outFileName);
+    }
+}
+
+// Show dialog: export current sound as .wav
+// NOTE: Wave is generated again from parameters directly in export format
+static void DialogExportWave(WaveParams params)
+{
+    // Save file dialog
+    const char *filters[] = { "*.wav", "*.qoa" };
+    const char *fileName = tinyfd_saveFileDialog("Export wave file", "sound.wav", 2, filters, "Wave File (*.wav, *.qoa)");
+
+    if (fileName != NULL)
+    {
+        char outFileName[128] = { 0 };
+        strcpy(outFileName, fileName);
+
+        // Check for valid extension and make sure it is
+        if ((GetExtension(outFileName) == NULL) ||
+            (!IsFileExtension(outFileName, ".wav") && !IsFileExtension(outFileName, ".qoa"))) strcat(outFileName, ".wav\0");
+
+        // Export wave data, compressed audio is encoded while generated (16 bit samples)
+        if (IsFileExtension(outFileName, ".qoa")) ExportWaveStream(params, wavSampleRate, 1, SYNTH_QUALITY_FINAL, outFileName, AUDIO_FORMAT_QOA, NULL);
+        else
+        {
+            Wave wave = GenerateWaveEx(params, wavSampleRate, wavSampleSize, 1);
+            ExportWave(wave, outFileName);                      // Export wave data to file
+            UnloadWave(wave);
+        }
+    }
+}
+#endif
+
+// Export wave as audio file (.wav, .qoa) or code file (.h), depending on file extension and export modes
+// NOTE: Export time is added to synth profile (SYNTH_PROFILE), function is thread-safe
+static void ExportWaveFile(Wave wave, const char *fileName, int codeMode, int wavMode)
+{
+#if defined(SYNTH_PROFILE)
+    double startTime = GetSynthProfileTime();
+#endif
+
+    int format = GetAudioFormat(fileName, wavMode);
+
+    if (format != AUDIO_FORMAT_NONE) ExportWaveCompressed(wave, fileName, format);
+    else if (IsFileExtension(fileName, ".wav")) ExportWave(wave, fileName);
+    else if (IsFileExtension(fileName, ".h"))
+    {
+        // NOTE: Parameters code export requires wave parameters, wave data is exported if only wave available
+        if (codeMode == CODE_EXPORT_ADPCM) ExportWaveAsCodeAdpcm(wave, fileName);
+        else ExportWaveAsCode(wave, fileName);
+    }
+
+#if defined(SYNTH_PROFILE)
+    AddSynthProfileEvent(SYNTH_PROFILE_EXPORT, startTime, GetSynthProfileTime() - startTime, 1);
+#endif
+}
+
+// Export wave generated from parameters as compressed audio file (.qoa, .wav IMA ADPCM), returns frames exported
+// NOTE: Wave is generated by blocks and every block is encoded just after generation, so no full wave is
+// generated (render cache is not used). Compressed formats use 16 bit samples, generated with dither
+static int ExportWaveStream(WaveParams params, int sampleRate, int channels, int quality, const char *fileName, int format, WaveAnalysis *analysis)
+{
+    WaveStream stream;
+    AudioEncoder encoder = { 0 };
+    int frameCount = 0;
+
+    if (!InitWaveStream(&stream, params, sampleRate, 16, channels, quality, (analysis != NULL)))
+    {
+        printf("[%s] Wave format not supported for compressed audio\n", fileName);
+        return 0;
+    }
+
+    if (InitAudioEncoder(&encoder, fileName, format, sampleRate, channels, stream.frameCount))
+    {
+        short samples[SYNTH_BLOCK_FRAMES*2] = { 0 };
+        int count = 0;
+#if defined(SYNTH_PROFILE)
+        double exportTime = GetSynthProfileTime();
+        double exportDuration = 0.0;
+#endif
+        while ((count = ReadWaveStream(&stream, samples, SYNTH_BLOCK_FRAMES)) > 0)
+        {
+#if defined(SYNTH_PROFILE)
+            double blockTime = GetSynthProfileTime();
+            WriteAudioEncoder(&encoder, samples, count);
+            exportDuration += (GetSynthProfileTime() - blockTime);
+#else
+            WriteAudioEncoder(&encoder, samples, count);
+#endif
+        }
+
+        frameCount = CloseAudioEncoder(&encoder);
+#if defined(SYNTH_PROFILE)
+        // NOTE: Encoding is interleaved with generation, total encoding time is reported as one event
+        AddSynthProfileEvent(SYNTH_PROFILE_EXPORT, exportTime, exportDuration, 1);
+#endif
+    }
+
+    CloseWaveStream(&stream, analysis);
+
+    return frameCount;
+}
+
+// Export wave data as compressed audio file (.qoa, .wav IMA ADPCM), samples converted to 16 bit by blocks
+static void ExportWaveCompressed(Wave wave, const char *fileName, int format)
+{
+    AudioEncoder encoder = { 0 };
+    int channels = (wave.channels == 2)? 2 : 1;
+
+    if (InitAudioEncoder(&encoder, fileName, format, wave.sampleRate, channels, wave.sampleCount))
+    {
+        short samples[SYNTH_BLOCK_FRAMES*2] = { 0 };
+
+        for (int frame = 0; frame < (int)wave.sampleCount; frame += SYNTH_BLOCK_FRAMES)
+        {
+            int count = ((wave.sampleCount - frame) < SYNTH_BLOCK_FRAMES)? (wave.sampleCount - frame) : SYNTH_BLOCK_FRAMES;
+
+            GetWaveSamples16(wave, frame, count, channels, samples);
+            WriteAudioEncoder(&encoder, samples, count);
+        }
+
+        CloseAudioEncoder(&encoder);
+    }
+}
+
+// Get compressed audio format for output file: .qoa files or .wav files on IMA ADPCM export mode
+static int GetAudioFormat(const char *fileName, int wavMode)
+{
+    int format = AUDIO_FORMAT_NONE;
+
+    if (IsFileExtension(fileName, ".qoa")) format = AUDIO_FORMAT_QOA;
+    else if (IsFileExtension(fileName, ".wav") && (wavMode == WAV_EXPORT_ADPCM)) format = AUDIO_FORMAT_ADPCM;
+
+    return format;
+}
+
+// Export wave parameters to code (.h), wave is generated on load from parameters with embedded synth (rfxgen_synth.h)
+// NOTE: Variables names are the file name (without extension) in uppercase. Floats are exported with 9 significant
+// digits, so exported parameters are exactly the same and generated wave is the same as the exported one
+static void ExportWaveParamsAsCode(WaveParams params, int sampleRate, int sampleSize, int channels, int quality, const char *fileName)
+{
+    static const char *paramNames[22] = {
+        "attackTimeValue", "sustainTimeValue", "sustainPunchValue", "decayTimeValue", "startFrequencyValue",
+        "minFrequencyValue", "slideValue", "deltaSlideValue", "vibratoDepthValue", "vibratoSpeedValue",
+        "changeAmountValue", "changeSpeedValue", "squareDutyValue", "dutySweepValue", "repeatSpeedValue",
+        "phaserOffsetValue", "phaserSweepValue", "lpfCutoffValue", "lpfCutoffSweepValue", "lpfResonanceValue",
+        "hpfCutoffValue", "hpfCutoffSweepValue"
+    };
+
+    FILE *txtFile = fopen(fileName, "wt");
+
+    if (txtFile == NULL)
+    {
+        printf("[%s] Code file could not be saved\n", fileName);
+        return;
+    }
+
+    char varFileName[256] = { 0 };
+    GetCodeVarName(fileName, varFileName);
+
+    fprintf(txtFile, "\n//////////////////////////////////////////////////////////////////////////////////\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "// WaveParamsAsCode exporter v1.0 - Sound parameters exported as code           //\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "// more info and bugs-report:  github.com/raysan5/rfxgen                        //\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "// Copyright (c) 2018 raylib technologies (@raylibtech)                         //\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "//////////////////////////////////////////////////////////////////////////////////\n\n");
+
+    fprintf(txtFile, "// Wave is generated on load from sound parameters:\n");
+    fprintf(txtFile, "//     Wave wave = GenerateWavePro(%s_PARAMS, %s_SAMPLE_RATE, %s_SAMPLE_SIZE, %s_CHANNELS, %s_QUALITY);\n", varFileName, varFileName, varFileName, varFileName, varFileName);
+    fprintf(txtFile, "// NOTE: RFXGEN_SYNTH_IMPLEMENTATION must be defined in one source file before including rfxgen_synth.h\n");
+    fprintf(txtFile, "#include \"rfxgen_synth.h\"\n\n");
+
+    fprintf(txtFile, "// Wave data information\n");
+    fprintf(txtFile, "#define %s_SAMPLE_RATE      %i\n", varFileName, sampleRate);
+    fprintf(txtFile, "#define %s_SAMPLE_SIZE      %i\n", varFileName, sampleSize);
+    fprintf(txtFile, "#define %s_CHANNELS         %i\n", varFileName, channels);
+    fprintf(txtFile, "#define %s_QUALITY          %i\n\n", varFileName, quality);
+
+    fprintf(txtFile, "// Sound parameters (WaveParams, %i bytes)\n", (int)sizeof(WaveParams));
+    fprintf(txtFile, "static const WaveParams %s_PARAMS = {\n", varFileName);
+    // NOTE: Values are padded so comments are aligned with float values comments (21 characters)
+    char intValue[32] = { 0 };
+    snprintf(intValue, 32, "%i,", params.randSeed);
+    fprintf(txtFile, "    %-21s// randSeed\n", intValue);
+    snprintf(intValue, 32, "%i,", params.waveTypeValue);
+    fprintf(txtFile, "    %-21s// waveTypeValue\n", intValue);
+
+    // NOTE: Float parameters are consecutive on WaveParams, after randSeed and waveTypeValue
+    const float *values = &params.attackTimeValue;
+    for (int i = 0; i < 22; i++) fprintf(txtFile, "    %.9ef,%s// %s\n", values[i], (values[i] < 0.0f)? "   " : "    ", paramNames[i]);
+
+    fprintf(txtFile, "};\n");
+
+    fclose(txtFile);
+}
+
+// Export wave data to code (.h), samples compressed as IMA ADPCM (4 bits per sample), decoder function included
+// NOTE: Data uses WAV IMA ADPCM blocks layout, decoded samples are 16 bit; decoder is only defined once
+// if several exported files are included in the same source file
+static void ExportWaveAsCodeAdpcm(Wave wave, const char *fileName)
+{
+    #define BYTES_TEXT_PER_LINE     20
+
+    FILE *txtFile = fopen(fileName, "wt");
+
+    if (txtFile == NULL)
+    {
+        printf("[%s] Code file could not be saved\n", fileName);
+        return;
+    }
+
+    char varFileName[256] = { 0 };
+    GetCodeVarName(fileName, varFileName);
+
+    // Encode wave blocks, samples converted to 16 bit
+    int channels = (wave.channels == 2)? 2 : 1;
+    int blockFrames = GetAdpcmBlockFrames(channels);
+    int blockAlign = ADPCM_BLOCK_SIZE*channels;
+    int blockCount = (wave.sampleCount + blockFrames - 1)/blockFrames;
+    int dataSize = blockCount*blockAlign;
+
+    unsigned char *data = (unsigned char *)calloc((dataSize > 0)? dataSize : 1, 1);
+    short *samples = (short *)calloc(blockFrames*channels, sizeof(short));
+    AdpcmState state = { 0 };
+
+    for (int b = 0; b < blockCount; b++)
+    {
+        int frameCount = (((int)wave.sampleCount - b*blockFrames) < blockFrames)? ((int)wave.sampleCount - b*blockFrames) : blockFrames;
+
+        GetWaveSamples16(wave, b*blockFrames, frameCount, channels, samples);
+        EncodeAdpcmBlock(&state, samples, frameCount, channels, data + b*blockAlign);
+    }
+
+    free(samples);
+
+    fprintf(txtFile, "\n//////////////////////////////////////////////////////////////////////////////////\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "// WaveAsCode exporter v1.0 - Wave data exported as IMA ADPCM array of bytes    //\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "// more info and bugs-report:  github.com/raysan5/rfxgen                        //\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "// Copyright (c) 2018 raylib technologies (@raylibtech)                         //\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "//////////////////////////////////////////////////////////////////////////////////\n\n");
+
+    fprintf(txtFile, "// Wave data is decoded on load into 16 bit samples:\n");
+    fprintf(txtFile, "//     short *samples = (short *)malloc(%s_SAMPLE_COUNT*%s_CHANNELS*sizeof(short));\n", varFileName, varFileName);
+    fprintf(txtFile, "//     DecodeAdpcm(%s_DATA, %s_SAMPLE_COUNT, %s_CHANNELS, %s_BLOCK_ALIGN, samples);\n\n", varFileName, varFileName, varFileName, varFileName);
+
+    fprintf(txtFile, "// Wave data information\n");
+    fprintf(txtFile, "#define %s_SAMPLE_COUNT     %i\n", varFileName, wave.sampleCount);
+    fprintf(txtFile, "#define %s_SAMPLE_RATE      %i\n", varFileName, wave.sampleRate);
+    fprintf(txtFile, "#define %s_SAMPLE_SIZE      16\n", varFileName);
+    fprintf(txtFile, "#define %s_CHANNELS         %i\n", varFileName, channels);
+    fprintf(txtFile, "#define %s_BLOCK_ALIGN      %i\n\n", varFileName, blockAlign);
+
+    fprintf(txtFile, "#if !defined(RFXGEN_ADPCM_DECODER)\n");
+    fprintf(txtFile, "#define RFXGEN_ADPCM_DECODER\n");
+    fprintf(txtFile, "// Decode IMA ADPCM data (WAV IMA ADPCM blocks layout) into 16 bit samples, channels interleaved\n");
+    fprintf(txtFile, "static void DecodeAdpcm(const unsigned char *data, int frameCount, int channels, int blockAlign, short *samples)\n{\n");
+    fprintf(txtFile, "    static const signed char indexTable[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };\n");
+    fprintf(txtFile, "    static const short stepTable[89] = {\n");
+    fprintf(txtFile, "        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,\n");
+    fprintf(txtFile, "        107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,\n");
+    fprintf(txtFile, "        876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428,\n");
+    fprintf(txtFile, "        4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,\n");
+    fprintf(txtFile, "        22385, 24623, 27086, 29794, 32767 };\n\n");
+    fprintf(txtFile, "    int blockFrames = (blockAlign - 4*channels)*2/channels + 1;\n\n");
+    fprintf(txtFile, "    for (int frame = 0; frame < frameCount; data += blockAlign)\n    {\n");
+    fprintf(txtFile, "        int count = ((frameCount - frame) < blockFrames)? (frameCount - frame) : blockFrames;\n\n");
+    fprintf(txtFile, "        for (int c = 0; c < channels; c++)\n        {\n");
+    fprintf(txtFile, "            // Block header: first sample and step index\n");
+    fprintf(txtFile, "            int predictor = (short)(data[4*c] | (data[4*c + 1] << 8));\n");
+    fprintf(txtFile, "            int index = data[4*c + 2];\n");
+    fprintf(txtFile, "            samples[frame*channels + c] = (short)predictor;\n\n");
+    fprintf(txtFile, "            for (int i = 1; i < count; i++)\n            {\n");
+    fprintf(txtFile, "                // Nibbles are grouped by 8 samples (4 bytes) per channel\n");
+    fprintf(txtFile, "                int k = i - 1;\n");
+    fprintf(txtFile, "                unsigned char byte = data[4*channels + (k/8)*4*channels + c*4 + (k%%8)/2];\n");
+    fprintf(txtFile, "                int nibble = (k & 1)? (byte >> 4) : (byte & 0x0f);\n");
+    fprintf(txtFile, "                int step = stepTable[index];\n");
+    fprintf(txtFile, "                int delta = step >> 3;\n\n");
+    fprintf(txtFile, "                if (nibble & 4) delta += step;\n");
+    fprintf(txtFile, "                if (nibble & 2) delta += step >> 1;\n");
+    fprintf(txtFile, "                if (nibble & 1) delta += step >> 2;\n\n");
+    fprintf(txtFile, "                predictor += (nibble & 8)? -delta : delta;\n");
+    fprintf(txtFile, "                if (predictor > 32767) predictor = 32767;\n");
+    fprintf(txtFile, "                else if (predictor < -32768) predictor = -32768;\n\n");
+    fprintf(txtFile, "                index += indexTable[nibble];\n");
+    fprintf(txtFile, "                if (index < 0) index = 0;\n");
+    fprintf(txtFile, "                else if (index > 88) index = 88;\n\n");
+    fprintf(txtFile, "                samples[(frame + i)*channels + c] = (short)predictor;\n");
+    fprintf(txtFile, "            }\n        }\n\n");
+    fprintf(txtFile, "        frame += count;\n    }\n}\n");
+    fprintf(txtFile, "#endif\n\n");
+
+    fprintf(txtFile, "static const unsigned char %s_DATA[%i] = { ", varFileName, dataSize);
+    for (int i = 0; i < dataSize - 1; i++) fprintf(txtFile, ((i%BYTES_TEXT_PER_LINE == 0)? "0x%x,\n" : "0x%x, "), data[i]);
+    if (dataSize > 0) fprintf(txtFile, "0x%x };\n", data[dataSize - 1]);
+    else fprintf(txtFile, "0 };\n");
+
+    fclose(txtFile);
+    free(data);
+}
+
+// Get code variables name from file name: file name without extension in uppercase, not alphanumeric characters replaced by '_'
+static void GetCodeVarName(const char *fileName, char *varName)
+{
+    strncpy(varName, GetFileName(fileName), 255);
+
+    for (int i = 0; varName[i] != '\0'; i++)
+    {
+        if (varName[i] == '.') { varName[i] = '\0'; break; }
+        if ((varName[i] >= 'a') && (varName[i] <= 'z')) varName[i] = varName[i] - 32;
+        else if (!isalnum((unsigned char)varName[i])) varName[i] = '_';
+    }
+}
+
+// Save wave analysis sidecar file (.json) for exported wave file, saved as <waveFileName>.json
+// NOTE: Analysis is measured on generation, exported file is never read again
+static void SaveWaveAnalysis(WaveAnalysis analysis, Wave wave, const char *waveFileName)
+{
+    char fileName[512] = { 0 };
+    snprintf(fileName, 512, "%s%s", waveFileName, ANALYSIS_FILE_EXT);
+
+    FILE *jsonFile = fopen(fileName, "wt");
+
+    if (jsonFile != NULL)
+    {
+        // Level values are also provided in dBFS, silence is reported as min loudness
+        float peakDb = (analysis.peak > 0.0f)? 20.0f*log10f(analysis.peak) : SYNTH_LOUDNESS_MIN;
+        float rmsDb = (analysis.rms > 0.0f)? 20.0f*log10f(analysis.rms) : SYNTH_LOUDNESS_MIN;
+
+        fprintf(jsonFile, "{\n");
+        fprintf(jsonFile, "    \"file\": \"");
+        for (const char *c = GetFileName(waveFileName); *c != '\0'; c++)
+        {
+            if ((*c == '"') || (*c == '\\')) fputc('\\', jsonFile);
+            fputc(*c, jsonFile);
+        }
+        fprintf(jsonFile, "\",\n");
+        fprintf(jsonFile, "    \"sampleRate\": %i,\n", wave.sampleRate);
+        fprintf(jsonFile, "    \"sampleSize\": %i,\n", wave.sampleSize);
+        fprintf(jsonFile, "    \"channels\": %i,\n", wave.channels);
+        fprintf(jsonFile, "    \"samples\": %i,\n", analysis.sampleCount);
+        fprintf(jsonFile, "    \"duration\": %.6f,\n", analysis.duration);
+        fprintf(jsonFile, "    \"peak\": %.6f,\n", analysis.peak);
+        fprintf(jsonFile, "    \"peakDb\": %.2f,\n", peakDb);
+        fprintf(jsonFile, "    \"rms\": %.6f,\n", analysis.rms);
+        fprintf(jsonFile, "    \"rmsDb\": %.2f,\n", rmsDb);
+        fprintf(jsonFile, "    \"clipped\": %i,\n", analysis.clippedCount);
+        fprintf(jsonFile, "    \"loudness\": %.2f\n", analysis.loudness);
+        fprintf(jsonFile, "}\n");
+
+        fclose(jsonFile);
+    }
+    else printf("WARNING: Wave analysis could not be saved: %s\n", fileName);
+}
+
+//--------------------------------------------------------------------------------------------
+// IMA ADPCM functions
+//--------------------------------------------------------------------------------------------
+
+// Get frames per IMA ADPCM block: header sample plus 2 samples per byte after 4 bytes header per channel
+// NOTE: Block is ADPCM_BLOCK_SIZE per channel, so frames per block do not depend on channels count
+static int GetAdpcmBlockFrames(int channels)
+{
+    int blockAlign = ADPCM_BLOCK_SIZE*channels;
+
+    return (blockAlign - 4*channels)*8/(4*channels) + 1;
+}
+
+// Encode frames into one IMA ADPCM block (ADPCM_BLOCK_SIZE*channels bytes), WAV IMA ADPCM blocks layout:
+// block header per channel (first sample, step index), then groups of 8 samples (4 bytes) per channel
+// NOTE: Block step index is selected to minimize block error (encoder only, decoder just reads it from header),
+// so transients at block start are not smoothed while step adapts. Incomplete blocks are padded repeating last frame
+static void EncodeAdpcmBlock(AdpcmState *state, const short *samples, int frameCount, int channels, unsigned char *block)
+{
+    memset(block, 0, ADPCM_BLOCK_SIZE*channels);
+
+    for (int c = 0; c < channels; c++)
+    {
+        // Block header: first sample is stored as is
+        state->predictor[c] = (frameCount > 0)? samples[c] : 0;
+
+        long long minError = -1;
+        int bestIndex = state->index[c];
+
+        for (int index = 0; index <= 88; index++)
+        {
+            AdpcmState trial = *state;
+            trial.index[c] = index;
+
+            long long error = EncodeAdpcmChannel(&trial, c, samples, frameCount, channels, NULL);
+
+            if ((minError < 0) || (error < minError))
+            {
+                minError = error;
+                bestIndex = index;
+            }
+        }
+
+        state->index[c] = bestIndex;
+
+        block[4*c] = (unsigned char)(state->predictor[c] & 0xff);
+        block[4*c + 1] = (unsigned char)((state->predictor[c] >> 8) & 0xff);
+        block[4*c + 2] = (unsigned char)state->index[c];
+
+        EncodeAdpcmChannel(state, c, samples, frameCount, channels, block);
+    }
+}
+
+// Encode one channel block samples (after header sample), nibbles are written to block if provided
+// NOTE: Returns block squared error, used to select block step index
+static long long EncodeAdpcmChannel(AdpcmState *state, int channel, const short *samples, int frameCount, int channels, unsigned char *block)
+{
+    static const int indexTable[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+    static const int stepTable[89] = {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+        107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+        876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428,
+        4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
+        22385, 24623, 27086, 29794, 32767 };
+
+    int blockFrames = GetAdpcmBlockFrames(channels);
+    int predictor = state->predictor[channel];
+    int index = state->index[channel];
+    long long error = 0;
+
+    for (int i = 1; i < blockFrames; i++)
+    {
+        int sample = predictor;
+        if (frameCount > 0) sample = samples[((i < frameCount)? i : (frameCount - 1))*channels + channel];
+
+        // Quantize difference to predicted sample, using same steps than decoder
+        int step = stepTable[index];
+        int diff = sample - predictor;
+        int nibble = 0;
+
+        if (diff < 0)
+        {
+            nibble = 8;
+            diff = -diff;
+        }
+
+        int delta = step >> 3;
+
+        if (diff >= step) { nibble |= 4; diff -= step; delta += step; }
+        step >>= 1;
+        if (diff >= step) { nibble |= 2; diff -= step; delta += step; }
+        step >>= 1;
+        if (diff >= step) { nibble |= 1; delta += step; }
+
+        predictor += (nibble & 8)? -delta : delta;
+        if (predictor > 32767) predictor = 32767;
+        else if (predictor < -32768) predictor = -32768;
+
+        index += indexTable[nibble];
+        if (index < 0) index = 0;
+        else if (index > 88) index = 88;
+
+        if (i < frameCount) error += (long long)(sample - predictor)*(sample - predictor);
+
+        // Nibbles are grouped by 8 samples (4 bytes) per channel, low nibble first
+        if (block != NULL)
+        {
+            int k = i - 1;
+            block[4*channels + (k/8)*4*channels + channel*4 + (k%8)/2] |= (unsigned char)((k & 1)? (nibble << 4) : nibble);
+        }
+    }
+
+    state->predictor[channel] = predictor;
+    state->index[channel] = index;
+
+    return error;
+}
+
+// Get wave frames as 16 bit samples (channels interleaved), mono wave samples are copied to all channels
+static void GetWaveSamples16(Wave wave, int frame, int frameCount, int channels, short *samples)
+{
+    for (int i = 0; i < frameCount*channels; i++)
+    {
+        int index = (frame + i/channels)*wave.channels + ((wave.channels == 2)? i%channels : 0);
+        float sample = 0.0f;
+
+        if (wave.sampleSize == 8) sample = (((unsigned char *)wave.data)[index] - 128)/127.0f;
+        else if (wave.sampleSize == 16) sample = ((short *)wave.data)[index]/32767.0f;
+        else if (wave.sampleSize == 32) sample = ((float *)wave.data)[index];
+
+        int value = (int)floorf(sample*32767.0f + 0.5f);
+        samples[i] = (short)((value > 32767)? 32767 : ((value < -32768)? -32768 : value));
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+// Compressed audio encoder functions (QOA, WAV IMA ADPCM)
+//--------------------------------------------------------------------------------------------
+
+// Init audio encoder for compressed audio file, file header is written for expected frames count
+// NOTE: Only one block of samples and one encoded block are allocated, whatever the wave length
+static bool InitAudioEncoder(AudioEncoder *encoder, const char *fileName, int format, int sampleRate, int channels, int frameCount)
+{
+    memset(encoder, 0, sizeof(AudioEncoder));
+
+    encoder->file = fopen(fileName, "wb");
+
+    if (encoder->file == NULL)
+    {
+        printf("[%s] Compressed audio file could not be saved\n", fileName);
+        return false;
+    }
+
+    encoder->format = format;
+    encoder->sampleRate = sampleRate;
+    encoder->channels = channels;
+    encoder->frameCount = frameCount;
+
+    if (format == AUDIO_FORMAT_QOA)
+    {
+        // QOA frame: header, LMS state per channel and up to 256 slices per channel
+        encoder->blockFrames = QOA_FRAME_LEN;
+        encoder->block = (unsigned char *)calloc(8 + 16*channels + 8*QOA_SLICES_PER_FRAME*channels, 1);
+
+        // NOTE: LMS weights start as a simple extrapolation of the last two samples
+        for (int c = 0; c < channels; c++)
+        {
+            encoder->lms[c].weights[2] = -(1 << 13);
+            encoder->lms[c].weights[3] = (1 << 14);
+        }
+    }
+    else
+    {
+        encoder->blockFrames = GetAdpcmBlockFrames(channels);
+        encoder->block = (unsigned char *)calloc(ADPCM_BLOCK_SIZE*channels, 1);
+    }
+
+    encoder->samples = (short *)calloc(encoder->blockFrames*channels, sizeof(short));
+
+    WriteAudioEncoderHeader(encoder);
+
+    return true;
+}
+
+// Write frames to audio encoder (16 bit samples, channels interleaved), blocks are encoded once completed
+static void WriteAudioEncoder(AudioEncoder *encoder, const short *samples, int frameCount)
+{
+    while (frameCount > 0)
+    {
+        int count = encoder->blockFrames - encoder->pendingFrames;
+        if (count > frameCount) count = frameCount;
+
+        memcpy(encoder->samples + encoder->pendingFrames*encoder->channels, samples, count*encoder->channels*sizeof(short));
+        encoder->pendingFrames += count;
+        samples += count*encoder->channels;
+        frameCount -= count;
+
+        if (encoder->pendingFrames == encoder->blockFrames) FlushAudioEncoder(encoder);
+    }
+}
+
+// Close audio encoder, last incomplete block is encoded and file header is updated if required
+static int CloseAudioEncoder(AudioEncoder *encoder)
+{
+    if (encoder->pendingFrames > 0) FlushAudioEncoder(encoder);
+
+    if (encoder->framesWritten != encoder->frameCount)
+    {
+        encoder->frameCount = encoder->framesWritten;
+
+        fseek(encoder->file, 0, SEEK_SET);
+        WriteAudioEncoderHeader(encoder);
+    }
+
+    fclose(encoder->file);
+    free(encoder->samples);
+    free(encoder->block);
+
+    return encoder->framesWritten;
+}
+
+// Encode pending frames as one block (QOA frame or IMA ADPCM block) and write it to file
+static void FlushAudioEncoder(AudioEncoder *encoder)
+{
+    int size = 0;
+
+    if (encoder->format == AUDIO_FORMAT_QOA) size = EncodeQoaFrame(encoder->lms, encoder->samples, encoder->pendingFrames, encoder->channels, encoder->sampleRate, encoder->block);
+    else
+    {
+        EncodeAdpcmBlock(&encoder->adpcm, encoder->samples, encoder->pendingFrames, encoder->channels, encoder->block);
+        size = ADPCM_BLOCK_SIZE*encoder->channels;
+    }
+
+    fwrite(encoder->block, 1, size, encoder->file);
+
+    encoder->dataSize += size;
+    encoder->framesWritten += encoder->pendingFrames;
+    encoder->pendingFrames = 0;
+}
+
+// Write compressed audio file header for declared frames count
+// NOTE: Data size is only required on WAV header, header is updated on close if frames count changes
+static void WriteAudioEncoderHeader(AudioEncoder *encoder)
+{
+    if (encoder->format == AUDIO_FORMAT_QOA)
+    {
+        // QOA file header: magic and samples per channel (big endian)
+        unsigned char header[8] = { 0 };
+        int position = 0;
+
+        WriteQoaValue(header, &position, (0x716f6166ULL << 32) | (unsigned int)encoder->frameCount);
+        fwrite(header, 1, 8, encoder->file);
+    }
+    else
+    {
+        // Expected data size is required on WAV header, IMA ADPCM blocks are always complete
+        int dataSize = encoder->dataSize;
+        if (encoder->framesWritten == 0) dataSize = ((encoder->frameCount + encoder->blockFrames - 1)/encoder->blockFrames)*ADPCM_BLOCK_SIZE*encoder->channels;
+
+        unsigned int riffSize = 52 + dataSize;
+        unsigned int fmtSize = 20;
+        unsigned short audioFormat = 0x11;      // WAVE_FORMAT_IMA_ADPCM
+        unsigned short channels = encoder->channels;
+        unsigned short blockAlign = ADPCM_BLOCK_SIZE*encoder->channels;
+        unsigned int byteRate = (unsigned int)((long long)encoder->sampleRate*blockAlign/encoder->blockFrames);
+        unsigned short bitsPerSample = 4;
+        unsigned short extraSize = 2;
+        unsigned short samplesPerBlock = encoder->blockFrames;
+        unsigned int factSize = 4;
+
+        // Write RIFF header, format chunk (with samples per block), fact chunk (frames count) and data chunk header
+        fwrite("RIFF", 1, 4, encoder->file);
+        fwrite(&riffSize, sizeof(unsigned int), 1, encoder->file);
+        fwrite("WAVEfmt ", 1, 8, encoder->file);
+        fwrite(&fmtSize, sizeof(unsigned int), 1, encoder->file);
+        fwrite(&audioFormat, sizeof(unsigned short), 1, encoder->file);
+        fwrite(&channels, sizeof(unsigned short), 1, encoder->file);
+        fwrite(&encoder->sampleRate, sizeof(unsigned int), 1, encoder->file);
+        fwrite(&byteRate, sizeof(unsigned int), 1, encoder->file);
+        fwrite(&blockAlign, sizeof(unsigned short), 1, encoder->file);
+        fwrite(&bitsPerSample, sizeof(unsigned short), 1, encoder->file);
+        fwrite(&extraSize, sizeof(unsigned short), 1, encoder->file);
+        fwrite(&samplesPerBlock, sizeof(unsigned short), 1, encoder->file);
+        fwrite("fact", 1, 4, encoder->file);
+        fwrite(&factSize, sizeof(unsigned int), 1, encoder->file);
+        fwrite(&encoder->frameCount, sizeof(unsigned int), 1, encoder->file);
+        fwrite("data", 1, 4, encoder->file);
+        fwrite(&dataSize, sizeof(unsigned int), 1, encoder->file);
+    }
+}
+
+// Encode frames into one QOA frame (up to QOA_FRAME_LEN frames), returns frame size in bytes
+// NOTE: Every slice (20 samples) uses the scale factor with lower error (brute force search), slices error
+// includes a penalty for big LMS weights, so predictor never becomes unstable (same as reference encoder)
+static int EncodeQoaFrame(QoaLms *lms, const short *samples, int frameCount, int channels, int sampleRate, unsigned char *frame)
+{
+    // NOTE: Scale factors are (s + 1)^2.75 rounded, reciprocals (65536/scalefactor rounded up) are used for division
+    static const int reciprocalTable[16] = { 65536, 9363, 3121, 1457, 781, 475, 311, 216, 156, 117, 90, 71, 57, 47, 39, 32 };
+    static const int quantTable[17] = { 7, 7, 7, 5, 5, 3, 3, 1, 0, 0, 2, 2, 4, 4, 6, 6, 6 };   // Residuals -8..8
+    static const int dequantTable[16][8] = {
+        { 1, -1, 3, -3, 5, -5, 7, -7 },
+        { 5, -5, 18, -18, 32, -32, 49, -49 },
+        { 16, -16, 53, -53, 95, -95, 147, -147 },
+        { 34, -34, 113, -113, 203, -203, 315, -315 },
+        { 63, -63, 210, -210, 378, -378, 588, -588 },
+        { 104, -104, 345, -345, 621, -621, 966, -966 },
+        { 158, -158, 528, -528, 950, -950, 1477, -1477 },
+        { 228, -228, 760, -760, 1368, -1368, 2128, -2128 },
+        { 316, -316, 1053, -1053, 1895, -1895, 2947, -2947 },
+        { 422, -422, 1405, -1405, 2529, -2529, 3934, -3934 },
+        { 548, -548, 1828, -1828, 3290, -3290, 5117, -5117 },
+        { 696, -696, 2320, -2320, 4176, -4176, 6496, -6496 },
+        { 868, -868, 2893, -2893, 5207, -5207, 8099, -8099 },
+        { 1064, -1064, 3548, -3548, 6386, -6386, 9933, -9933 },
+        { 1286, -1286, 4288, -4288, 7718, -7718, 12005, -12005 },
+        { 1536, -1536, 5120, -5120, 9216, -9216, 14336, -14336 } };
+
+    int sliceCount = (frameCount + QOA_SLICE_LEN - 1)/QOA_SLICE_LEN;
+    int frameSize = 8 + 16*channels + 8*sliceCount*channels;
+    int position = 0;
+
+    // Frame header: channels, sample rate, samples per channel and frame size
+    WriteQoaValue(frame, &position, ((unsigned long long)channels << 56) | ((unsigned long long)sampleRate << 32) |
+                  ((unsigned long long)frameCount << 16) | (unsigned long long)frameSize);
+
+    // LMS state per channel: history and weights (16 bit values)
+    for (int c = 0; c < channels; c++)
+    {
+        unsigned long long history = 0;
+        unsigned long long weights = 0;
+
+        for (int i = 0; i < 4; i++)
+        {
+            history = (history << 16) | (lms[c].history[i] & 0xffff);
+            weights = (weights << 16) | (lms[c].weights[i] & 0xffff);
+        }
+
+        WriteQoaValue(frame, &position, history);
+        WriteQoaValue(frame, &position, weights);
+    }
+
+    // NOTE: Slices are interleaved by channel, scale factor search starts with previous slice scale factor
+    int prevScalefactor[2] = { 0 };
+
+    for (int start = 0; start < frameCount; start += QOA_SLICE_LEN)
+    {
+        int sliceLength = ((frameCount - start) < QOA_SLICE_LEN)? (frameCount - start) : QOA_SLICE_LEN;
+
+        for (int c = 0; c < channels; c++)
+        {
+            unsigned long long bestRank = ~0ULL;
+            unsigned long long bestSlice = 0;
+            QoaLms bestLms = lms[c];
+            int bestScalefactor = 0;
+
+            for (int s = 0; s < 16; s++)
+            {
+                int scalefactor = (s + prevScalefactor[c])%16;
+                QoaLms trial = lms[c];
+                unsigned long long slice = scalefactor;
+                unsigned long long rank = 0;
+
+                for (int i = 0; i < sliceLength; i++)
+                {
+                    int sample = samples[(start + i)*channels + c];
+                    int predicted = (trial.weights[0]*trial.history[0] + trial.weights[1]*trial.history[1] +
+                                     trial.weights[2]*trial.history[2] + trial.weights[3]*trial.history[3]) >> 13;
+
+                    // Quantize scaled residual, rounded away from zero
+                    int residual = sample - predicted;
+                    int scaled = (int)(((long long)residual*reciprocalTable[scalefactor] + (1 << 15)) >> 16);
+                    scaled = scaled + ((residual > 0) - (residual < 0)) - ((scaled > 0) - (scaled < 0));
+                    if (scaled > 8) scaled = 8;
+                    else if (scaled < -8) scaled = -8;
+
+                    int quantized = quantTable[scaled + 8];
+                    int dequantized = dequantTable[scalefactor][quantized];
+                    int reconstructed = predicted + dequantized;
+                    if (reconstructed > 32767) reconstructed = 32767;
+                    else if (reconstructed < -32768) reconstructed = -32768;
+
+                    long long penalty = (((long long)trial.weights[0]*trial.weights[0] + (long long)trial.weights[1]*trial.weights[1] +
+                                          (long long)trial.weights[2]*trial.weights[2] + (long long)trial.weights[3]*trial.weights[3]) >> 18) - 0x8ff;
+                    if (penalty < 0) penalty = 0;
+
+                    long long error = sample - reconstructed;
+                    rank += (unsigned long long)(error*error + penalty*penalty);
+                    if (rank > bestRank) break;
+
+                    // Update LMS predictor with reconstructed sample (same as decoder)
+                    int delta = dequantized >> 4;
+                    for (int k = 0; k < 4; k++) trial.weights[k] += (trial.history[k] < 0)? -delta : delta;
+                    for (int k = 0; k < 3; k++) trial.history[k] = trial.history[k + 1];
+                    trial.history[3] = reconstructed;
+
+                    slice = (slice << 3) | quantized;
+                }
+
+                if (rank < bestRank)
+                {
+                    bestRank = rank;
+                    bestSlice = slice;
+                    bestLms = trial;
+                    bestScalefactor = scalefactor;
+                }
+            }
+
+            prevScalefactor[c] = bestScalefactor;
+            lms[c] = bestLms;
+
+            // NOTE: Incomplete slices (last frame) are left aligned, unused residuals are zero
+            bestSlice <<= (QOA_SLICE_LEN - sliceLength)*3;
+            WriteQoaValue(frame, &position, bestSlice);
+        }
+    }
+
+    return position;
+}
+
+// Write 64 bit value to QOA data (big endian)
+static void WriteQoaValue(unsigned char *data, int *position, unsigned long long value)
+{
+    for (int i = 0; i < 8; i++) data[*position + i] = (unsigned char)(value >> (56 - 8*i));
+    *position += 8;
+}
+
+//--------------------------------------------------------------------------------------------
+// Parallel jobs functions
+//--------------------------------------------------------------------------------------------
+
+// Jobs pool worker: process jobs until no more available
+static void *JobPoolWorker(void *arg)
+{
+    JobPool *pool = (JobPool *)arg;
+
+    while (true)
+    {
+        pthread_mutex_lock(&pool->lock);
+        int index = pool->nextJob++;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (index >= pool->jobCount) break;
+
+        pool->jobFunc(pool->userData, index);
+    }
+
+    return NULL;
+}
+
+// Run jobs on a pool of worker threads
+// NOTE: Calling thread also works on jobs, function returns when all jobs are processed
+static void RunJobsParallel(JobFunc jobFunc, void *userData, int jobCount, int threadCount)
+{
+    if (threadCount > jobCount) threadCount = jobCount;
+    if (threadCount > MAX_JOB_THREADS) threadCount = MAX_JOB_THREADS;
+
+    JobPool pool = { 0 };
+    pool.jobFunc = jobFunc;
+    pool.userData = userData;
+    pool.jobCount = jobCount;
+    pthread_mutex_init(&pool.lock, NULL);
+
+    pthread_t threads[MAX_JOB_THREADS] = { 0 };
+    int threadsStarted = 0;
+
+    for (int i = 0; i < (threadCount - 1); i++)
+    {
+        if (pthread_create(&threads[threadsStarted], NULL, JobPoolWorker, &pool) == 0) threadsStarted++;
+    }
+
+    JobPoolWorker(&pool);
+
+    for (int i = 0; i < threadsStarted; i++) pthread_join(threads[i], NULL);
+
+    pthread_mutex_destroy(&pool.lock);
+}
+
+// Get number of available cpu cores
+static int GetCpuCoreCount(void)
+{
+    int count = 1;
+
+#if defined(_WIN32)
+    const char *numProcessors = getenv("NUMBER_OF_PROCESSORS");
+    if (numProcessors != NULL) count = atoi(numProcessors);
+#else
+    count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    if (count < 1) count = 1;
+    if (count > MAX_JOB_THREADS) count = MAX_JOB_THREADS;
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------
+// Explore functions
+//--------------------------------------------------------------------------------------------
+
+// Init explore batch, candidates are mutations of base parameters or random sounds
+static void InitExploreBatch(ExploreBatch *batch, WaveParams base, bool mutate, unsigned int seed, int count)
+{
+    memset(batch, 0, sizeof(ExploreBatch));
+
+    if (count > EXPLORE_MAX_CANDIDATES) count = EXPLORE_MAX_CANDIDATES;
+
+    batch->base = base;
+    batch->mutate = mutate;
+    batch->seed = seed;
+    batch->count = count;
+    batch->quality = SYNTH_QUALITY_FINAL;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (mutate)
+        {
+            batch->params[i] = base;
+            WaveMutate(&batch->params[i], seed + i);
+        }
+        else batch->params[i] = GenRandomize(seed + i);
+    }
+
+    pthread_mutex_init(&batch->lock, NULL);
+}
+
+// Close explore batch, pending candidates are cancelled and generated waves unloaded
+// NOTE: Candidates being generated are finished before returning
+static void CloseExploreBatch(ExploreBatch *batch)
+{
+    pthread_mutex_lock(&batch->lock);
+    batch->cancel = true;
+    pthread_mutex_unlock(&batch->lock);
+
+    if (batch->threadActive) pthread_join(batch->thread, NULL);
+
+    for (int i = 0; i < batch->count; i++) UnloadWave(batch->waves[i]);
+
+    pthread_mutex_destroy(&batch->lock);
+    memset(batch, 0, sizeof(ExploreBatch));
+}
+
+// Process one explore candidate: generate wave, and export parameters and wave if export directory provided
+// NOTE: Called from worker threads, only thread-safe functions should be used
+static void ProcessExploreJob(void *userData, int index)
+{
+    ExploreBatch *batch = (ExploreBatch *)userData;
+
+    pthread_mutex_lock(&batch->lock);
+    bool cancel = batch->cancel;
+    pthread_mutex_unlock(&batch->lock);
+
+    if (cancel) return;
+
+    // NOTE: Candidates are not added to render cache, they would evict sounds being edited
+    if (batch->outDir != NULL)
+    {
+        char fileName[512] = { 0 };
+        Wave wave = GenerateWavePro(batch->params[index], batch->sampleRate, batch->sampleSize, batch->channels, batch->quality);
+
+        snprintf(fileName, 512, "%s/explore_%02i.rfx", batch->outDir, index);
+        SaveWaveParams(batch->params[index], fileName);
+
+        // Export wave data as audio file (.wav) or code file (.h)
+        snprintf(fileName, 512, "%s/explore_%02i.%s", batch->outDir, index, batch->outType);
+        ExportWaveFile(wave, fileName, CODE_EXPORT_PCM, WAV_EXPORT_PCM);
+
+        printf("[explore_%02i] Exported: %s (%.3f s)\n", index, fileName, (float)wave.sampleCount/wave.sampleRate);
+
+        UnloadWave(wave);
+    }
+    else batch->waves[index] = GenerateWavePro(batch->params[index], WAVE_SAMPLE_RATE, 32, 1, batch->quality);
+
+    pthread_mutex_lock(&batch->lock);
+    batch->ready[index] = true;
+    batch->readyCount++;
+    pthread_mutex_unlock(&batch->lock);
+}
+
+#if !defined(COMMAND_LINE_ONLY)
+// Check if explore candidate has been processed, candidate wave can be used
+static bool IsExploreCandidateReady(ExploreBatch *batch, int index)
+{
+    pthread_mutex_lock(&batch->lock);
+    bool ready = batch->ready[index];
+    pthread_mutex_unlock(&batch->lock);
+
+    return ready;
+}
+
+// Start explore batch rendering on a background thread, calling thread does not wait
+static void StartExploreBatch(ExploreBatch *batch)
+{
+    batch->threadActive = (pthread_create(&batch->thread, NULL, ExploreBatchThread, batch) == 0);
+
+    // Thread could not be created, candidates are rendered on calling thread
+    if (!batch->threadActive) ExploreBatchThread(batch);
+}
+
+// Explore batch background thread, candidates are rendered on a jobs pool using all cpu cores
+static void *ExploreBatchThread(void *arg)
+{
+    ExploreBatch *batch = (ExploreBatch *)arg;
+
+    RunJobsParallel(ProcessExploreJob, batch, batch->count, GetCpuCoreCount());
+
+    return NULL;
+}
+#endif
+
+//--------------------------------------------------------------------------------------------
+// Render cache functions
+//--------------------------------------------------------------------------------------------
+
+// Init render cache, disk cache enabled if directory provided
+// NOTE: Disk cache directory must exist, if directory path is too long disk cache is disabled and false is returned
+static bool InitRenderCache(const char *directory)
+{
+    memset(&renderCache, 0, sizeof(RenderCache));
+    pthread_mutex_init(&renderCache.lock, NULL);
+
+    if (directory == NULL) return true;
+
+    int length = snprintf(renderCache.directory, sizeof(renderCache.directory), "%s", directory);
+
+    if ((length < 0) || (length >= (int)sizeof(renderCache.directory)))
+    {
+        renderCache.directory[0] = '\0';   // NOTE: Truncated path is not used, cache files would go to a different directory
+        return false;
+    }
+
+    return true;
+}
+
+// Close render cache, unload cached waves
+static void CloseRenderCache(void)
+{
+    for (int i = 0; i < RENDER_CACHE_MAX_ENTRIES; i++)
+    {
+        if (renderCache.entries[i].wave.data != NULL) UnloadWave(renderCache.entries[i].wave);
+    }
+
+    pthread_mutex_destroy(&renderCache.lock);
+    memset(&renderCache, 0, sizeof(RenderCache));
+}
+
+// Generate wave in desired format and quality, using render cache, wave analysis is retrieved if required
+// NOTE: Returned wave is owned by caller, cache keeps its own copy. Function is thread-safe.
+// Wave analysis is always measured on generation (same pass) and cached with the wave, so it is also available for cached waves
+static Wave GenerateWaveCached(WaveParams params, int sampleRate, int sampleSize, int channels, int quality, WaveAnalysis *analysis)
+{
+    unsigned long long key = GetRenderCacheKey(params, sampleRate, sampleSize, channels, quality);
+
+    Wave wave = { 0 };
+    WaveAnalysis waveAnalysis = { 0 };
+    bool memoryCached = GetRenderCacheWave(params, sampleRate, sampleSize, channels, quality, &wave, &waveAnalysis);
+
+    // Memory cached waves without analysis (generated by GUI) are generated again if analysis required
+    if (memoryCached && (analysis != NULL) && (waveAnalysis.sampleCount == 0))
+    {
+        UnloadWave(wave);
+        wave = (Wave){ 0 };
+        memoryCached = false;
+    }
+
+    // Look for wave in disk cache, cache file name is the render key
+    char fileName[512] = { 0 };
+    if (renderCache.directory[0] != '\0') snprintf(fileName, 512, "%s/%08x%08x.rfxc", renderCache.directory, (unsigned int)(key >> 32), (unsigned int)key);
+
+    if ((wave.data == NULL) && (fileName[0] != '\0')) wave = LoadRenderCacheFile(fileName, params, sampleRate, sampleSize, channels, quality, &waveAnalysis);
+
+    pthread_mutex_lock(&renderCache.lock);
+    if (wave.data != NULL) renderCache.hitCount++;
+    else renderCache.missCount++;
+    pthread_mutex_unlock(&renderCache.lock);
+
+    // Generate wave if not cached and store it on disk cache
+    if (wave.data == NULL)
+    {
+        wave = GenerateWaveAnalyzed(params, sampleRate, sampleSize, channels, quality, &waveAnalysis);
+
+        if (analysis != NULL) *analysis = waveAnalysis;
+        if (wave.sampleCount == 0) return wave;     // Empty waves are not cached
+
+        if (fileName[0] != '\0') SaveRenderCacheFile(fileName, params, quality, wave, waveAnalysis);
+    }
+
+    if (!memoryCached) AddRenderCacheWave(params, quality, wave, &waveAnalysis);
+    if (analysis != NULL) *analysis = waveAnalysis;
+
+    return wave;
+}
+
+// Get wave copy from render cache memory, returns false if not cached
+static bool GetRenderCacheWave(WaveParams params, int sampleRate, int sampleSize, int channels, int quality, Wave *wave, WaveAnalysis *analysis)
+{
+    unsigned long long key = GetRenderCacheKey(params, sampleRate, sampleSize, channels, quality);
+    RenderCacheEntry *entry = &renderCache.entries[key%RENDER_CACHE_MAX_ENTRIES];
+    bool cached = false;
+
+    pthread_mutex_lock(&renderCache.lock);
+    if ((entry->wave.data != NULL) && (entry->key == key) &&
+        (memcmp(&entry->params, &params, sizeof(WaveParams)) == 0) && (entry->quality == quality) &&
+        ((int)entry->wave.sampleRate == sampleRate) && ((int)entry->wave.sampleSize == sampleSize) && ((int)entry->wave.channels == channels))
+    {
+        *wave = WaveCopy(entry->wave);
+        if (analysis != NULL) *analysis = entry->analysis;
+        cached = true;
+    }
+    pthread_mutex_unlock(&renderCache.lock);
+
+    return cached;
+}
+
+// Add wave copy to render cache memory, replacing previous entry for same key slot
+// NOTE: Wave analysis is optional (NULL if not measured)
+static void AddRenderCacheWave(WaveParams params, int quality, Wave wave, const WaveAnalysis *analysis)
+{
+    unsigned long long key = GetRenderCacheKey(params, wave.sampleRate, wave.sampleSize, wave.channels, quality);
+    RenderCacheEntry *entry = &renderCache.entries[key%RENDER_CACHE_MAX_ENTRIES];
+
+    Wave cachedWave = WaveCopy(wave);
+
+    pthread_mutex_lock(&renderCache.lock);
+    if (entry->wave.data != NULL) UnloadWave(entry->wave);
+    entry->key = key;
+    entry->params = params;
+    entry->quality = quality;
+    entry->wave = cachedWave;
+    if (analysis != NULL) entry->analysis = *analysis;
+    else memset(&entry->analysis, 0, sizeof(WaveAnalysis));
+    pthread_mutex_unlock(&renderCache.lock);
+}
+
+// Get render cache key for parameters, format and quality
+// NOTE: Render cache version is included, so cached waves are discarded when generator changes
+static unsigned long long GetRenderCacheKey(WaveParams params, int sampleRate, int sampleSize, int channels, int quality)
+{
+    int format[5] = { RENDER_CACHE_VERSION, sampleRate, sampleSize, channels, quality };
+
+    unsigned long long hash = ComputeHash64(&params, sizeof(WaveParams), 0);
+    hash = ComputeHash64(format, sizeof(format), hash);
+
+    return hash;
+}
+
+// Load wave from render cache file (.rfxc)
+// NOTE: Wave is only loaded if file matches wave parameters, format and quality, wave.data is NULL otherwise
+static Wave LoadRenderCacheFile(const char *fileName, WaveParams params, int sampleRate, int sampleSize, int channels, int quality, WaveAnalysis *analysis)
+{
+    Wave wave = { 0 };
+    FILE *cacheFile = fopen(fileName, "rb");
+
+    if (cacheFile != NULL)
+    {
+        // Read .rfxc file header
+        char signature[5] = { 0 };
+        unsigned short version = 0;
+        unsigned short length = 0;
+        WaveParams fileParams = { 0 };
+        int fileFormat[5] = { 0 };      // sampleCount, sampleRate, sampleSize, channels, quality
+
+        fread(signature, 1, 4, cacheFile);
+        fread(&version, 1, sizeof(unsigned short), cacheFile);
+        fread(&length, 1, sizeof(unsigned short), cacheFile);
+        fread(&fileParams, 1, sizeof(WaveParams), cacheFile);
+
+        if ((strncmp(signature, "rFXC", 4) == 0) && (version == RENDER_CACHE_VERSION) && (length == sizeof(WaveParams)) &&
+            (fread(fileFormat, sizeof(int), 5, cacheFile) == 5) && (memcmp(&fileParams, &params, sizeof(WaveParams)) == 0) &&
+            (fileFormat[0] > 0) && (fileFormat[1] == sampleRate) && (fileFormat[2] == sampleSize) && (fileFormat[3] == channels) &&
+            (fileFormat[4] == quality) && (fread(analysis, sizeof(WaveAnalysis), 1, cacheFile) == 1))
+        {
+            int dataSize = fileFormat[0]*channels*sampleSize/8;
+            void *data = malloc(dataSize);
+
+            if ((int)fread(data, 1, dataSize, cacheFile) == dataSize)
+            {
+                wave.sampleCount = fileFormat[0];
+                wave.sampleRate = sampleRate;
+                wave.sampleSize = sampleSize;
+                wave.channels = channels;
+                wave.data = data;
+            }
+            else free(data);    // Truncated cache file
+        }
+
+        fclose(cacheFile);
+    }
+
+    return wave;
+}
+
+// Save wave to render cache file (.rfxc)
+// NOTE: Data is written to a temporal file and then renamed, readers never get partially written files
+static void SaveRenderCacheFile(const char *fileName, WaveParams params, int quality, Wave wave, WaveAnalysis analysis)
+{
+    char tempFileName[540] = { 0 };
+
+    pthread_mutex_lock(&renderCache.lock);
+    snprintf(tempFileName, 540, "%s.%u.%u.tmp", fileName, (unsigned int)time(NULL), renderCache.tempCounter++);
+    pthread_mutex_unlock(&renderCache.lock);
+
+    FILE *cacheFile = fopen(tempFileName, "wb");
+
+    if (cacheFile != NULL)
+    {
+        // Write .rfxc file header
+        char signature[5] = "rFXC";
+        unsigned short version = RENDER_CACHE_VERSION;
+        unsigned short length = sizeof(WaveParams);
+        int format[5] = { wave.sampleCount, wave.sampleRate, wave.sampleSize, wave.channels, quality };
+        int dataSize = wave.sampleCount*wave.channels*wave.sampleSize/8;
+
+        fwrite(signature, 1, 4, cacheFile);
+        fwrite(&version, 1, sizeof(unsigned short), cacheFile);
+        fwrite(&length, 1, sizeof(unsigned short), cacheFile);
+        fwrite(&params, 1, sizeof(WaveParams), cacheFile);
+        fwrite(format, sizeof(int), 5, cacheFile);
+        fwrite(&analysis, sizeof(WaveAnalysis), 1, cacheFile);
+
+        bool success = ((int)fwrite(wave.data, 1, dataSize, cacheFile) == dataSize);
+        success = (fclose(cacheFile) == 0) && success;
+
+        // NOTE: On Windows rename() fails if file exists (written by another process), temporal file is just removed
+        if (!success || (rename(tempFileName, fileName) != 0)) remove(tempFileName);
+    }
+}
+
+// Compute FNV-1a 64 bit hash, data added to provided hash (0 to start a new hash)
+static unsigned long long ComputeHash64(const void *data, int size, unsigned long long hash)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    if (hash == 0) hash = 14695981039346656037ULL;      // FNV-1a 64 bit offset basis
+
+    for (int i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;                       // FNV-1a 64 bit prime
+    }
+
+    return hash;
+}
+
+//--------------------------------------------------------------------------------------------
+// Sound bank functions
+//--------------------------------------------------------------------------------------------
+
+// Load sound bank file (.rfxb), file is memory mapped (loaded with a single read on Windows)
+// NOTE: Sound bank data is used directly, only header and sections bounds are checked
+static SoundBank LoadSoundBank(const char *fileName)
+{
+    SoundBank bank = { 0 };
+
+#if defined(_WIN32)
+    FILE *bankFile = fopen(fileName, "rb");
+
+    if (bankFile != NULL)
+    {
+        fseek(bankFile, 0, SEEK_END);
+        bank.size = ftell(bankFile);
+        fseek(bankFile, 0, SEEK_SET);
+
+        bank.data = malloc((size_t)bank.size);
+        if (fread(bank.data, 1, (size_t)bank.size, bankFile) != (size_t)bank.size) bank.size = 0;
+
+        fclose(bankFile);
+    }
+#else
+    int fd = open(fileName, O_RDONLY);
+
+    if (fd != -1)
+    {
+        struct stat info = { 0 };
+
+        if ((fstat(fd, &info) == 0) && (info.st_size > 0))
+        {
+            void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data != MAP_FAILED)
+            {
+                bank.data = data;
+                bank.size = info.st_size;
+                bank.mapped = true;
+            }
+        }
+
+        close(fd);      // NOTE: Mapping is kept after closing file
+    }
+#endif
+
+    if (bank.data == NULL)
+    {
+        printf("[%s] Sound bank file could not be opened\n", fileName);
+        return bank;
+    }
+
+    // Check for valid .rfxb file and sections bounds
+    const SoundBankHeader *header = (const SoundBankHeader *)bank.data;
+    bool valid = (bank.size >= (long long)sizeof(SoundBankHeader)) && (memcmp(header->signature, "rFXB", 4) == 0);
+
+    if (valid && (header->version != SOUND_BANK_VERSION))
+    {
+        printf("[%s] rFX sound bank version not supported (%i)\n", fileName, header->version);
+        valid = false;
+    }
+    else if (valid)
+    {
+        valid = (header->soundCount >= 0) && (header->tableSize > 0) && ((header->tableSize & (header->tableSize - 1)) == 0) &&
+                (header->entriesOffset >= 0) && (header->entriesOffset + (long long)header->soundCount*(long long)sizeof(SoundBankEntry) <= bank.size) &&
+                (header->tableOffset >= 0) && (header->tableOffset + (long long)header->tableSize*(long long)sizeof(int) <= bank.size) &&
+                (header->paramsOffset >= 0) && (header->paramsOffset + (long long)header->soundCount*(long long)sizeof(WaveParams) <= bank.size) &&
+                (header->pcmOffset >= 0) && (header->pcmOffset <= bank.size);
+
+        if (!valid) printf("[%s] rFX sound bank sections not valid\n", fileName);
+    }
+    else printf("[%s] rFX sound bank does not seem to be valid\n", fileName);
+
+    if (!valid)
+    {
+        UnloadSoundBank(bank);
+        return (SoundBank){ 0 };
+    }
+
+    bank.header = header;
+    bank.entries = (const SoundBankEntry *)((const unsigned char *)bank.data + header->entriesOffset);
+    bank.table = (const int *)((const unsigned char *)bank.data + header->tableOffset);
+    bank.params = (const WaveParams *)((const unsigned char *)bank.data + header->paramsOffset);
+    if (header->flags & SOUND_BANK_FLAG_PCM) bank.pcm = (const unsigned char *)bank.data + header->pcmOffset;
+
+    return bank;
+}
+
+// Unload sound bank, waves retrieved from sound bank are not valid anymore
+static void UnloadSoundBank(SoundBank bank)
+{
+    if (bank.data == NULL) return;
+
+#if defined(_WIN32)
+    free(bank.data);
+#else
+    if (bank.mapped) munmap(bank.data, (size_t)bank.size);
+#endif
+}
+
+// Save sound bank file (.rfxb), sounds with repeated names are skipped
+// NOTE: If pcm is requested, all sounds are pre-rendered in provided format and quality
+static bool SaveSoundBank(const char *fileName, const char **names, const WaveParams *params, int count, bool pcm, int sampleRate, int sampleSize, int channels, int quality)
+{
+    // rFX Sound Bank File Structure (.rfxb)
+    // ------------------------------------------------------
+    // Offset | Size  | Type            | Description
+    // ------------------------------------------------------
+    // 0      | 64    | SoundBankHeader | Signature "rFXB", version, counts and sections offsets
+    // 64     | 72*N  | SoundBankEntry  | Index entries: name hash, name and pre-rendered PCM location
+    // ...    | 4*T   | int             | Hash table: entry index per slot (open addressing, -1 for empty)
+    // ...    | 96*N  | WaveParams      | Wave parameters records (same layout as .rfx data)
+    // ...    | ...   | unsigned char   | Pre-rendered PCM data (optional), every sound 16 bytes aligned
+    // ------------------------------------------------------
+
+    SoundBankHeader header = { 0 };
+    memcpy(header.signature, "rFXB", 4);
+    header.version = SOUND_BANK_VERSION;
+    header.flags = pcm? SOUND_BANK_FLAG_PCM : 0;
+    header.sampleRate = sampleRate;
+    header.sampleSize = sampleSize;
+    header.channels = channels;
+
+    header.tableSize = 1;
+    while (header.tableSize < 2*count) header.tableSize *= 2;
+
+    SoundBankEntry *entries = (SoundBankEntry *)calloc((count > 0)? count : 1, sizeof(SoundBankEntry));
+    WaveParams *records = (WaveParams *)calloc((count > 0)? count : 1, sizeof(WaveParams));
+    Wave *waves = (Wave *)calloc((count > 0)? count : 1, sizeof(Wave));
+    int *table = (int *)malloc(header.tableSize*sizeof(int));
+    for (int i = 0; i < header.tableSize; i++) table[i] = -1;
+
+    long long pcmSize = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        SoundBankEntry entry = { 0 };
+        strncpy(entry.name, names[i], SOUND_BANK_NAME_SIZE - 1);
+        entry.nameHash = ComputeHash64(entry.name, (int)strlen(entry.name), 0);
+
+        // Find hash table slot (linear probing), checking for repeated names
+        int slot = (int)(entry.nameHash & (header.tableSize - 1));
+        while ((table[slot] != -1) && (strcmp(entries[table[slot]].name, entry.name) != 0)) slot = (slot + 1) & (header.tableSize - 1);
+
+        if (table[slot] != -1)
+        {
+            printf("WARNING: Sound name repeated, skipped: %s\n", entry.name);
+            continue;
+        }
+
+        int index = header.soundCount;
+
+        if (pcm)
+        {
+            waves[index] = GenerateWaveCached(params[i], sampleRate, sampleSize, channels, quality, NULL);
+            entry.pcmOffset = pcmSize;
+            entry.pcmSampleCount = waves[index].sampleCount;
+            pcmSize += ((long long)waves[index].sampleCount*channels*sampleSize/8 + 15) & ~15LL;
+        }
+
+        table[slot] = index;
+        entries[index] = entry;
+        records[index] = params[i];
+        header.soundCount++;
+    }
+
+    // Compute sections offsets, 8 bytes aligned (PCM data 16 bytes aligned)
+    header.entriesOffset = sizeof(SoundBankHeader);
+    header.tableOffset = header.entriesOffset + (long long)header.soundCount*sizeof(SoundBankEntry);
+    header.paramsOffset = (header.tableOffset + (long long)header.tableSize*sizeof(int) + 7) & ~7LL;
+    header.pcmOffset = (header.paramsOffset + (long long)header.soundCount*sizeof(WaveParams) + 15) & ~15LL;
+
+    // Write all sections into one buffer, file is written at once
+    long long size = header.pcmOffset + pcmSize;
+    unsigned char *data = (unsigned char *)calloc((size_t)size, 1);
+
+    memcpy(data, &header, sizeof(SoundBankHeader));
+    memcpy(data + header.entriesOffset, entries, header.soundCount*sizeof(SoundBankEntry));
+    memcpy(data + header.tableOffset, table, header.tableSize*sizeof(int));
+    memcpy(data + header.paramsOffset, records, header.soundCount*sizeof(WaveParams));
+
+    for (int i = 0; i < header.soundCount; i++)
+    {
+        if (waves[i].data != NULL)
+        {
+            memcpy(data + header.pcmOffset + entries[i].pcmOffset, waves[i].data, (size_t)waves[i].sampleCount*channels*sampleSize/8);
+            UnloadWave(waves[i]);
+        }
+    }
+
+    bool success = false;
+    FILE *bankFile = fopen(fileName, "wb");
+
+    if (bankFile != NULL)
+    {
+        success = (fwrite(data, 1, (size_t)size, bankFile) == (size_t)size);
+        if (fclose(bankFile) != 0) success = false;
+    }
+
+    if (!success) printf("[%s] Sound bank file could not be saved\n", fileName);
+
+    free(data);
+    free(table);
+    free(waves);
+    free(records);
+    free(entries);
+
+    return success;
+}
+
+// Get sound index from sound bank by name, returns -1 if not found
+// NOTE: Sound name hash is used for hash table lookup, O(1)
+static int GetSoundBankIndex(SoundBank *bank, const char *name)
+{
+    if (bank->header == NULL) return -1;
+
+    unsigned long long hash = ComputeHash64(name, (int)strlen(name), 0);
+    int mask = bank->header->tableSize - 1;
+
+    for (int slot = (int)(hash & mask), probes = 0; probes < bank->header->tableSize; slot = (slot + 1) & mask, probes++)
+    {
+        int index = bank->table[slot];
+
+        if ((index < 0) || (index >= bank->header->soundCount)) return -1;
+        if ((bank->entries[index].nameHash == hash) && (strncmp(bank->entries[index].name, name, SOUND_BANK_NAME_SIZE) == 0)) return index;
+    }
+
+    return -1;
+}
+
+// Get wave parameters from sound bank
+static WaveParams GetSoundBankParams(SoundBank *bank, int index)
+{
+    WaveParams params = { 0 };
+
+    if ((bank->header != NULL) && (index >= 0) && (index < bank->header->soundCount)) params = bank->params[index];
+
+    return params;
+}
+
+// Get pre-rendered wave from sound bank (zero-copy), wave data is NULL if not available
+// NOTE: Wave data is owned by sound bank, it must not be unloaded or modified
+static Wave GetSoundBankWave(SoundBank *bank, int index)
+{
+    Wave wave = { 0 };
+
+    if ((bank->pcm != NULL) && (index >= 0) && (index < bank->header->soundCount))
+    {
+        const SoundBankEntry *entry = &bank->entries[index];
+        long long size = (long long)entry->pcmSampleCount*bank->header->channels*bank->header->sampleSize/8;
+
+        if ((entry->pcmOffset >= 0) && (bank->header->pcmOffset + entry->pcmOffset + size <= bank->size))
+        {
+            wave.sampleCount = entry->pcmSampleCount;
+            wave.sampleRate = bank->header->sampleRate;
+            wave.sampleSize = bank->header->sampleSize;
+            wave.channels = bank->header->channels;
+            wave.data = (void *)(bank->pcm + entry->pcmOffset);
+        }
+    }
+
+    return wave;
+}
+
+#if !defined(COMMAND_LINE_ONLY)
+//--------------------------------------------------------------------------------------------
+// Wave regeneration functions (GUI)
+//--------------------------------------------------------------------------------------------
+
+// Init wave regeneration worker thread
+static void InitRegenWorker(RegenWorker *worker)
+{
+    memset(worker, 0, sizeof(RegenWorker));
+
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->signal, NULL);
+
+    worker->running = true;
+    if (pthread_create(&worker->thread, NULL, RegenWorkerThread, worker) != 0) worker->running = false;
+}
+
+// Close wave regeneration worker, in-flight generation is cancelled
+static void CloseRegenWorker(RegenWorker *worker)
+{
+    pthread_mutex_lock(&worker->lock);
+    bool running = worker->running;
+    worker->running = false;
+    pthread_cond_signal(&worker->signal);
+    pthread_mutex_unlock(&worker->lock);
+
+    if (running) pthread_join(worker->thread, NULL);
+
+    for (int i = 0; i < MAX_WAVE_SLOTS; i++)
+    {
+        if (worker->slots[i].wave.data != NULL) UnloadWave(worker->slots[i].wave);
+    }
+
+    pthread_cond_destroy(&worker->signal);
+    pthread_mutex_destroy(&worker->lock);
+}
+
+// Request wave regeneration for slot, replaces (and cancels) previous request for same slot
+// NOTE: If frameLimit > 0 only first frames are generated (live preview), cached full wave is used if available
+// NOTE: If worker thread is not available, full wave is generated immediately
+static void RequestRegenWave(RegenWorker *worker, int slot, WaveParams params, int quality, bool play, int frameLimit)
+{
+    pthread_mutex_lock(&worker->lock);
+
+    RegenSlot *regen = &worker->slots[slot];
+    regen->params = params;
+    regen->quality = quality;
+    regen->requestId++;
+    regen->pending = true;
+    regen->play = play;
+    regen->frameLimit = frameLimit;
+
+    if (!worker->running)
+    {
+        if (regen->wave.data != NULL) UnloadWave(regen->wave);
+        regen->wave = GenerateWaveCached(params, WAVE_SAMPLE_RATE, 32, 1, quality, NULL);
+        regen->playWave = play;
+        regen->previewWave = false;
+        regen->pending = false;
+    }
+
+    pthread_cond_signal(&worker->signal);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+// Get generated wave for slot if ready, wave ownership is passed to caller
+static bool GetRegenWave(RegenWorker *worker, int slot, Wave *wave, bool *play, bool *preview)
+{
+    bool ready = false;
+
+    pthread_mutex_lock(&worker->lock);
+
+    RegenSlot *regen = &worker->slots[slot];
+
+    if (regen->wave.data != NULL)
+    {
+        *wave = regen->wave;
+        *play = regen->playWave;
+        *preview = regen->previewWave;
+        regen->wave = (Wave){ 0 };
+        ready = true;
+    }
+
+    pthread_mutex_unlock(&worker->lock);
+
+    return ready;
+}
+
+// Wave regeneration worker thread: generate requested waves until stopped
+// NOTE: Generation is done in blocks, it is cancelled if a new request arrives for same slot
+static void *RegenWorkerThread(void *arg)
+{
+    RegenWorker *worker = (RegenWorker *)arg;
+
+    pthread_mutex_lock(&worker->lock);
+
+    while (worker->running)
+    {
+        // Look for a pending request
+        int slot = -1;
+        for (int i = 0; i < MAX_WAVE_SLOTS; i++) if (worker->slots[i].pending) { slot = i; break; }
+
+        if (slot == -1)
+        {
+            pthread_cond_wait(&worker->signal, &worker->lock);
+            continue;
+        }
+
+        RegenSlot *regen = &worker->slots[slot];
+        WaveParams params = regen->params;
+        int quality = regen->quality;
+        unsigned int requestId = regen->requestId;
+        bool play = regen->play;
+        int frameLimit = regen->frameLimit;
+        regen->pending = false;
+
+        pthread_mutex_unlock(&worker->lock);
+
+        // Generate wave (or reuse cached one) out of lock, checking for cancellation between blocks
+        Wave wave = { 0 };
+        bool cancelled = false;
+        bool preview = false;
+
+        if (!GetRenderCacheWave(params, WAVE_SAMPLE_RATE, 32, 1, quality, &wave, NULL))
+        {
+            SynthVoice voice = { 0 };
+            InitSynthVoiceEx(&voice, params, quality);
+
+            int sampleCount = GetWaveSampleCount(params);
+
+            // Live preview: only first frames are generated, streaming synth is just stopped early
+            if ((frameLimit > 0) && (frameLimit < sampleCount))
+            {
+                sampleCount = frameLimit;
+                preview = true;
+            }
+            float *buffer = (float *)calloc((sampleCount > 0)? sampleCount : 1, sizeof(float));
+            int frame = 0;
+
+            while (!cancelled && (frame < sampleCount))
+            {
+                int blockCount = RenderSynthVoice(&voice, buffer + frame, ((sampleCount - frame) < SYNTH_BLOCK_FRAMES)? (sampleCount - frame) : SYNTH_BLOCK_FRAMES);
+                if (blockCount == 0) break;
+                frame += blockCount;
+
+                pthread_mutex_lock(&worker->lock);
+                cancelled = (regen->requestId != requestId) || !worker->running;
+                pthread_mutex_unlock(&worker->lock);
+            }
+
+            wave.sampleCount = frame;
+            wave.sampleRate = WAVE_SAMPLE_RATE;
+            wave.sampleSize = 32;
+            wave.channels = 1;
+            wave.data = buffer;
+
+            if (!cancelled && !preview && (wave.sampleCount > 0)) AddRenderCacheWave(params, quality, wave, NULL);
+        }
+
+        pthread_mutex_lock(&worker->lock);
+
+        // Generated wave is only provided if it is still the latest request for the slot
+        if (!cancelled && (regen->requestId == requestId))
+        {
+            if (regen->wave.data != NULL) UnloadWave(regen->wave);
+            regen->wave = wave;
+            regen->playWave = play;
+            regen->previewWave = preview;
+        }
+        else UnloadWave(wave);
+    }
+
+    pthread_mutex_unlock(&worker->lock);
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------
+// Audio device loader functions (GUI)
+//--------------------------------------------------------------------------------------------
+
+// Init audio device on a background thread, window can be shown and drawn meanwhile
+// NOTE: If thread can not be created, audio device is initialized immediately
+static void InitAudioDeviceAsync(AudioDeviceLoader *loader)
+{
+    memset(loader, 0, sizeof(AudioDeviceLoader));
+
+    pthread_mutex_init(&loader->lock, NULL);
+
+    if (pthread_create(&loader->thread, NULL, AudioDeviceLoaderThread, loader) == 0) loader->started = true;
+    else
+    {
+        InitAudioDevice();
+        loader->done = true;
+    }
+}
+
+// Check if audio device initialization is done, sounds can only be loaded and played after it
+// NOTE: Initialization could have failed, raylib audio functions check device state
+static bool IsAudioDeviceLoaded(AudioDeviceLoader *loader)
+{
+    pthread_mutex_lock(&loader->lock);
+    bool done = loader->done;
+    pthread_mutex_unlock(&loader->lock);
+
+    if (done && loader->started)
+    {
+        pthread_join(loader->thread, NULL);
+        loader->started = false;
+    }
+
+    return done;
+}
+
+// Close audio device, waiting for background initialization if still running
+static void CloseAudioDeviceAsync(AudioDeviceLoader *loader)
+{
+    if (loader->started)
+    {
+        pthread_join(loader->thread, NULL);
+        loader->started = false;
+    }
+
+    if (IsAudioDeviceReady()) CloseAudioDevice();
+
+    pthread_mutex_destroy(&loader->lock);
+}
+
+// Audio device loader thread: init audio device and flag it as done
+static void *AudioDeviceLoaderThread(void *arg)
+{
+    AudioDeviceLoader *loader = (AudioDeviceLoader *)arg;
+
+    InitAudioDevice();
+
+    pthread_mutex_lock(&loader->lock);
+    loader->done = true;
+    pthread_mutex_unlock(&loader->lock);
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------
+// Sound slot functions (GUI)
+//--------------------------------------------------------------------------------------------
+
+// Init sound slot, no memory is allocated until first update
+static void InitSoundSlot(SoundSlot *slot)
+{
+    memset(slot, 0, sizeof(SoundSlot));
+
+    slot->volume = 1.0f;
+}
+
+// Close sound slot
+static void CloseSoundSlot(SoundSlot *slot)
+{
+    if (slot->capacity[0] > 0) UnloadSound(slot->sounds[0]);
+    if (slot->capacity[1] > 0) UnloadSound(slot->sounds[1]);
+    free(slot->buffer);
+
+    memset(slot, 0, sizeof(SoundSlot));
+}
+
+// Update sound slot with new wave, wave is copied into back sound and sounds are swapped
+// NOTE: Back sound is reloaded only if wave does not fit, allocated frames are rounded up to SOUND_SLOT_FRAMES_STEP
+// NOTE: Wave must be WAVE_SAMPLE_RATE, 32 bit, mono (GUI generated waves format), audio device must be ready
+// NOTE: UpdateSound() copies data in sound format (device format), not in the loaded wave format,
+// so mono wave samples are duplicated into stereo frames in staging buffer
+static void UpdateSoundSlot(SoundSlot *slot, Wave wave)
+{
+    const float *samples = (const float *)wave.data;
+    int maxFrameCount = MAX_WAVE_LENGTH_SECONDS*WAVE_SAMPLE_RATE;
+    int frameCount = ((int)wave.sampleCount < maxFrameCount)? (int)wave.sampleCount : maxFrameCount;
+    int back = 1 - slot->front;
+
+    if ((frameCount > slot->capacity[back]) || (slot->capacity[back] == 0))
+    {
+        int capacity = ((frameCount + SOUND_SLOT_FRAMES_STEP - 1)/SOUND_SLOT_FRAMES_STEP)*SOUND_SLOT_FRAMES_STEP;
+        if (capacity == 0) capacity = SOUND_SLOT_FRAMES_STEP;
+
+        if (capacity > slot->bufferCapacity)
+        {
+            free(slot->buffer);
+            slot->buffer = (float *)malloc(capacity*SOUND_SLOT_CHANNELS*sizeof(float));
+            slot->bufferCapacity = capacity;
+        }
+
+        // Load back sound with wave padded with silence up to allocated frames, converted to device format on loading
+        memcpy(slot->buffer, wave.data, frameCount*sizeof(float));
+        memset(slot->buffer + frameCount, 0, (capacity - frameCount)*sizeof(float));
+
+        Wave padded = { 0 };
+        padded.sampleCount = capacity;
+        padded.sampleRate = WAVE_SAMPLE_RATE;
+        padded.sampleSize = 32;
+        padded.channels = 1;
+        padded.data = slot->buffer;
+
+        if (slot->capacity[back] > 0) UnloadSound(slot->sounds[back]);
+        slot->sounds[back] = LoadSoundFromWave(padded);
+        SetSoundVolume(slot->sounds[back], slot->volume);
+        slot->capacity[back] = capacity;
+    }
+    else
+    {
+        // Copy wave into stereo frames padded with silence, only frames used by previous back sound wave require clearing
+        int updateCount = (slot->frameCount[back] > frameCount)? slot->frameCount[back] : frameCount;
+
+        for (int i = 0; i < frameCount; i++)
+        {
+            slot->buffer[i*SOUND_SLOT_CHANNELS] = samples[i];
+            slot->buffer[i*SOUND_SLOT_CHANNELS + 1] = samples[i];
+        }
+        memset(slot->buffer + frameCount*SOUND_SLOT_CHANNELS, 0, (updateCount - frameCount)*SOUND_SLOT_CHANNELS*sizeof(float));
+
+        // NOTE: Back sound is stopped, audio mixer is not reading it while updated
+        UpdateSound(slot->sounds[back], slot->buffer, updateCount);
+    }
+
+    slot->frameCount[back] = frameCount;
+
+    // Swap sounds, previous front sound is stopped
+    if (slot->capacity[slot->front] > 0) StopSound(slot->sounds[slot->front]);
+    slot->front = back;
+    slot->stopTime = 0.0;
+}
+
+// Play sound slot front sound, playback is stopped by time at wave end
+// NOTE: Nothing is played if slot has not been updated yet
+static void PlaySoundSlot(SoundSlot *slot)
+{
+    if (slot->capacity[slot->front] == 0) return;
+
+    PlaySound(slot->sounds[slot->front]);
+    slot->stopTime = GetTime() + (double)slot->frameCount[slot->front]/WAVE_SAMPLE_RATE;
+}
+
+// Update sound slot playback, stopping it once wave has been played
+// NOTE: Sound buffers are silence after wave end, stop time granularity is not audible
+static void UpdateSoundSlotPlayback(SoundSlot *slot)
+{
+    if ((slot->stopTime > 0.0) && (GetTime() >= slot->stopTime))
+    {
+        StopSound(slot->sounds[slot->front]);
+        slot->stopTime = 0.0;
+    }
+}
+
+// Set sound slot volume (loaded sounds), volume is kept for sounds loaded later
+static void SetSoundSlotVolume(SoundSlot *slot, float volume)
+{
+    slot->volume = volume;
+
+    if (slot->capacity[0] > 0) SetSoundVolume(slot->sounds[0], volume);
+    if (slot->capacity[1] > 0) SetSoundVolume(slot->sounds[1], volume);
+}
+
+//--------------------------------------------------------------------------------------------
+// Parameters history functions (GUI)
+//--------------------------------------------------------------------------------------------
+
+// Add parameters change step to history, steps after current position (to redo) are discarded
+// NOTE: Parameters are compared as 32 bit fields, step only stores changed fields
+static void PushParamsHistory(ParamsHistory *history, WaveParams prev, WaveParams params)
+{
+    unsigned int prevFields[sizeof(WaveParams)/sizeof(unsigned int)] = { 0 };
+    unsigned int fields[sizeof(WaveParams)/sizeof(unsigned int)] = { 0 };
+    int fieldCount = sizeof(WaveParams)/sizeof(unsigned int);   // NOTE: Up to 32 fields supported by mask
+
+    memcpy(prevFields, &prev, sizeof(WaveParams));
+    memcpy(fields, &params, sizeof(WaveParams));
+
+    unsigned int mask = 0;
+    int changedCount = 0;
+
+    for (int i = 0; i < fieldCount; i++)
+    {
+        if (fields[i] != prevFields[i]) { mask |= (1u << i); changedCount++; }
+    }
+
+    if (mask == 0) return;
+
+    // Discard steps to redo and grow data if required
+    history->size = history->position;
+
+    if ((history->size + changedCount + 2) > history->capacity)
+    {
+        int capacity = (history->capacity > 0)? history->capacity*2 : 256;
+        while (capacity < (history->size + changedCount + 2)) capacity *= 2;
+
+        unsigned int *data = (unsigned int *)realloc(history->data, capacity*sizeof(unsigned int));
+        if (data == NULL) return;
+
+        history->data = data;
+        history->capacity = capacity;
+    }
+
+    unsigned int *step = history->data + history->size;
+
+    *step++ = mask;
+    for (int i = 0; i < fieldCount; i++) if (mask & (1u << i)) *step++ = fields[i]^prevFields[i];
+    *step++ = mask;
+
+    history->size += changedCount + 2;
+    history->position = history->size;
+}
+
+// Apply history step xor values to parameters, same step is used to undo and redo
+static void ApplyParamsHistoryStep(const unsigned int *step, WaveParams *params)
+{
+    unsigned int fields[sizeof(WaveParams)/sizeof(unsigned int)] = { 0 };
+    int fieldCount = sizeof(WaveParams)/sizeof(unsigned int);
+    unsigned int mask = *step++;
+
+    memcpy(fields, params, sizeof(WaveParams));
+    for (int i = 0; i < fieldCount; i++) if (mask & (1u << i)) fields[i] ^= *step++;
+    memcpy(params, fields, sizeof(WaveParams));
+}
+
+// Get history step size (words) from step mask
+static int GetParamsHistoryStepSize(unsigned int mask)
+{
+    int size = 2;
+    for (; mask != 0; mask &= (mask - 1)) size++;
+
+    return size;
+}
+
+// Undo last parameters change step, returns false if there is nothing to undo
+static bool UndoParamsHistory(ParamsHistory *history, WaveParams *params)
+{
+    if (history->position <= 0) return false;
+
+    // NOTE: Step mask is repeated at step end to find step start
+    history->position -= GetParamsHistoryStepSize(history->data[history->position - 1]);
+    ApplyParamsHistoryStep(history->data + history->position, params);
+
+    return true;
+}
+
+// Redo next parameters change step, returns false if there is nothing to redo
+static bool RedoParamsHistory(ParamsHistory *history, WaveParams *params)
+{
+    if (history->position >= history->size) return false;
+
+    ApplyParamsHistoryStep(history->data + history->position, params);
+    history->position += GetParamsHistoryStepSize(history->data[history->position]);
+
+    return true;
+}
+
+// Unload parameters history
+static void UnloadParamsHistory(ParamsHistory *history)
+{
+    free(history->data);
+    memset(history, 0, sizeof(ParamsHistory));
+}
+
+//--------------------------------------------------------------------------------------------
+// Wave peaks functions (GUI)
+//--------------------------------------------------------------------------------------------
+
+// Load wave peaks (min/max pyramid) from wave
+// NOTE: Wave must be 32 bit, mono (GUI generated waves format), wave data is referenced
+static WavePeaks LoadWavePeaks(Wave wave)
+{
+    WavePeaks peaks = { 0 };
+
+    peaks.samples = (const float *)wave.data;
+    peaks.sampleCount = wave.sampleCount;
+
+    if (wave.sampleCount <= 0) return peaks;
+
+    // Compute levels blocks count, down to one block
+    int totalCount = 0;
+    int blockCount = (wave.sampleCount + WAVE_PEAKS_BLOCK_SIZE - 1)/WAVE_PEAKS_BLOCK_SIZE;
+
+    while (peaks.levelCount < WAVE_PEAKS_MAX_LEVELS)
+    {
+        peaks.blockCount[peaks.levelCount] = blockCount;
+        peaks.levelCount++;
+        totalCount += blockCount;
+
+        if (blockCount == 1) break;
+        blockCount = (blockCount + 1)/2;
+    }
+
+    peaks.values = (float *)malloc(2*totalCount*sizeof(float));
+
+    float *values = peaks.values;
+    for (int l = 0; l < peaks.levelCount; l++)
+    {
+        peaks.minValues[l] = values;
+        peaks.maxValues[l] = values + peaks.blockCount[l];
+        values += 2*peaks.blockCount[l];
+    }
+
+    // Level 0 from samples
+    for (int b = 0; b < peaks.blockCount[0]; b++)
+    {
+        int start = b*WAVE_PEAKS_BLOCK_SIZE;
+        int end = (start + WAVE_PEAKS_BLOCK_SIZE < (int)wave.sampleCount)? start + WAVE_PEAKS_BLOCK_SIZE : (int)wave.sampleCount;
+        float min = peaks.samples[start];
+        float max = peaks.samples[start];
+
+        for (int i = start + 1; i < end; i++)
+        {
+            if (peaks.samples[i] < min) min = peaks.samples[i];
+            if (peaks.samples[i] > max) max = peaks.samples[i];
+        }
+
+        peaks.minValues[0][b] = min;
+        peaks.maxValues[0][b] = max;
+    }
+
+    // Next levels from previous level blocks pairs
+    for (int l = 1; l < peaks.levelCount; l++)
+    {
+        for (int b = 0; b < peaks.blockCount[l]; b++)
+        {
+            int b0 = b*2;
+            int b1 = (b0 + 1 < peaks.blockCount[l - 1])? b0 + 1 : b0;
+
+            peaks.minValues[l][b] = (peaks.minValues[l - 1][b0] < peaks.minValues[l - 1][b1])? peaks.minValues[l - 1][b0] : peaks.minValues[l - 1][b1];
+            peaks.maxValues[l][b] = (peaks.maxValues[l - 1][b0] > peaks.maxValues[l - 1][b1])? peaks.maxValues[l - 1][b0] : peaks.maxValues[l - 1][b1];
+        }
+    }
+
+    return peaks;
+}
+
+// Unload wave peaks
+static void UnloadWavePeaks(WavePeaks peaks)
+{
+    free(peaks.values);
+}
+
+// Get wave peaks min/max values for samples range [start..end)
+// NOTE: Level with blocks up to half the range is used, range is extended to blocks bounds
+static void GetWavePeaksRange(WavePeaks *peaks, int start, int end, float *min, float *max)
+{
+    if (start < 0) start = 0;
+    if (end > peaks->sampleCount) end = peaks->sampleCount;
+
+    *min = 0.0f;
+    *max = 0.0f;
+
+    if (end <= start) return;
+
+    if ((end - start) < 2*WAVE_PEAKS_BLOCK_SIZE)
+    {
+        // Small ranges are computed from samples
+        *min = peaks->samples[start];
+        *max = peaks->samples[start];
+
+        for (int i = start + 1; i < end; i++)
+        {
+            if (peaks->samples[i] < *min) *min = peaks->samples[i];
+            if (peaks->samples[i] > *max) *max = peaks->samples[i];
+        }
+    }
+    else
+    {
+        int level = 0;
+        while ((level + 1 < peaks->levelCount) && ((WAVE_PEAKS_BLOCK_SIZE << (level + 1))*2 <= (end - start))) level++;
+
+        int blockSize = WAVE_PEAKS_BLOCK_SIZE << level;
+        int first = start/blockSize;
+        int last = (end - 1)/blockSize;
+
+        *min = peaks->minValues[level][first];
+        *max = peaks->maxValues[level][first];
+
+        for (int b = first + 1; b <= last; b++)
+        {
+            if (peaks->minValues[level][b] < *min) *min = peaks->minValues[level][b];
+            if (peaks->maxValues[level][b] > *max) *max = peaks->maxValues[level][b];
+        }
+    }
+}
+
+#endif  // !defined(COMMAND_LINE_ONLY)
+
+//--------------------------------------------------------------------------------------------
+// Auxiliar functions
+//--------------------------------------------------------------------------------------------
+
+#if !defined(COMMAND_LINE_ONLY)
+// Draw wave peaks, one line per column from column min to max values
+// NOTE: For proper visualization, MSAA x4 is recommended, alternatively
+// it should be rendered to a bigger texture and then scaled down with
+// bilinear/trilinear texture filtering
+static void DrawWave(WavePeaks *peaks, Rectangle bounds, Color color)
+{
+    float sampleScale = (float)bounds.height;
+    float samplesPerColumn = (float)peaks->sampleCount/bounds.width;
+
+    for (int x = 0; x < (int)bounds.width; x++)
+    {
+        float min, max;
+        GetWavePeaksRange(peaks, (int)(x*samplesPerColumn), (int)((x + 1)*samplesPerColumn) + 1, &min, &max);
+
+        min *= sampleScale;
+        max *= sampleScale;
+
+        if (min < -bounds.height/2) min = -bounds.height/2;
+        if (max > bounds.height/2) max = bounds.height/2;
+
+        DrawRectangle(bounds.x + x, bounds.y + bounds.height/2 + min, 1, ((max - min) > 1.0f)? (int)(max - min) : 1, color);
+    }
+}
+#endif // COMMAND_LINE_ONLY
+
+#if defined(VERSION_ONE) || defined(COMMAND_LINE_ONLY)
+#if !defined(COMMAND_LINE_ONLY)
+// Play provided wave through CLI
+// NOTE: Audio device is only initialized here, headless tool (COMMAND_LINE_ONLY) has no sound playing
+static void PlayWaveCLI(Wave wave)
+{
+    float waveTimeMs = (float)wave.sampleCount*1000.0/(wave.sampleRate*wave.channels);
+
+    InitAudioDevice();                  // Init audio device
+    Sound fx = LoadSoundFromWave(wave); // Load WAV audio file
+
+    printf("\n//////////////////////////////////////////////////////////////////////////////////\n");
+    printf("//                                                                              //\n");
+    printf("// rFXGen v%s - CLI audio player                                               //\n", TOOL_VERSION_TEXT);
+    printf("//                                                                              //\n");
+    printf("// more info and bugs-report: github.com/raysan5/rfxgen                         //\n");
+    printf("//                                                                              //\n");
+    printf("// Copyright (c) 2018 raylib technologies (@raylibtech)                         //\n");
+    printf("//                                                                              //\n");
+    printf("//////////////////////////////////////////////////////////////////////////////////\n\n");
 
-    genWave.data = calloc(genWave.sampleCount*genWave.channels, genWave.sampleSize/8);
-    memcpy(genWave.data, buffer, genWave.sampleCount*genWave.channels*genWave.sampleSize/8);
+    printf("Playing sound [%.2f sec.]. Press ENTER to finish.\n", waveTimeMs/1000.0f);
 
-    free(buffer);
+    PlaySound(fx);                      // Play sound
 
-    return genWave;
-}
+    // Wait while audio is playing, input is waited between progress updates
+    double startTime = GetPreciseTime();
+    int percent = -1;
 
-// Load .rfx (rFXGen) or .sfs (sfxr) sound parameters file
-static WaveParams LoadWaveParams(const char *fileName)
-{
-    WaveParams params = { 0 };
+    InitPlaybackInput();
 
-    if (IsFileExtension(GetExtension(fileName), ".rfx"))
+    while (true)
     {
-        FILE *rfxFile = fopen(fileName, "rb");
+        float timeMs = (float)((GetPreciseTime() - startTime)*1000.0);
+        PrintPlaybackProgress(timeMs, waveTimeMs, &percent);
 
-        if (rfxFile != NULL)
-        {
-            // Read .rfx file header
-            unsigned char signature[5];
-            fread(signature, 4, sizeof(unsigned char), rfxFile);
+        if ((timeMs >= waveTimeMs) || WaitPlaybackInput(PLAY_UPDATE_MS)) break;
+    }
 
-            // Check for valid .rfx file (FormatCC)
-            if ((signature[0] == 'r') &&
-                (signature[1] == 'F') &&
-                (signature[2] == 'X') &&
-                (signature[3] == ' '))
-            {
-                unsigned short version, length;
-                fread(&version, 1, sizeof(unsigned short), rfxFile);
-                fread(&length, 1, sizeof(unsigned short), rfxFile);
+    ClosePlaybackInput();
+    printf("\n\n");
 
-                if (version != 200) printf("[%s] rFX file version not supported (%i)\n", fileName, version);
-                else
-                {
-                    if (length != sizeof(WaveParams)) printf("[%s] Wrong rFX wave parameters size\n", fileName);
-                    else fread(&params, 1, sizeof(WaveParams), rfxFile);   // Load wave generation parameters
-                }
-            }
-            else printf("[%s] rFX file does not seem to be valid\n", fileName);
+    UnloadSound(fx);                    // Unload sound data
+    CloseAudioDevice();                 // Close audio device
+}
 
-            fclose(rfxFile);
-        }
-    }
-    else if (IsFileExtension(GetExtension(fileName), ".sfs"))
-    {
-        FILE *sfsFile = fopen(fileName, "rb");
+// Play sound generated from parameters through CLI (44100 Hz, 16 bit, mono)
+// NOTE: Wave is generated by blocks as audio stream buffers are processed, no full wave is generated,
+// playback starts as soon as first block is generated
+static void PlayWaveParamsCLI(WaveParams params, int quality)
+{
+    WaveStream stream;
+    InitWaveStream(&stream, params, WAVE_SAMPLE_RATE, 16, 1, quality, false);
 
-        if (sfsFile == NULL) return params;
+    float waveTimeMs = (float)stream.frameCount*1000.0f/WAVE_SAMPLE_RATE;
 
-        // Load .sfs sound parameters
-        int version = 0;
-        fread(&version, 1, sizeof(int), sfsFile);
+    // NOTE: Last stream buffer is played after all frames are provided, it is added to playback time
+    float endTimeMs = waveTimeMs + PLAY_STREAM_FRAMES*1000.0f/WAVE_SAMPLE_RATE;
 
-        if ((version == 100) || (version == 101) || (version == 102))
-        {
-            fread(&params.waveTypeValue, 1, sizeof(int), sfsFile);
+    InitAudioDevice();                  // Init audio device
+    AudioStream audio = InitAudioStream(WAVE_SAMPLE_RATE, 16, 1);
 
-            volumeValue = 0.5f;
+    printf("\n//////////////////////////////////////////////////////////////////////////////////\n");
+    printf("//                                                                              //\n");
+    printf("// rFXGen v%s - CLI audio player                                               //\n", TOOL_VERSION_TEXT);
+    printf("//                                                                              //\n");
+    printf("// more info and bugs-report: github.com/raysan5/rfxgen                         //\n");
+    printf("//                                                                              //\n");
+    printf("// Copyright (c) 2018 raylib technologies (@raylibtech)                         //\n");
+    printf("//                                                                              //\n");
+    printf("//////////////////////////////////////////////////////////////////////////////////\n\n");
 
-            if (version == 102) fread(&volumeValue, 1, sizeof(float), sfsFile);
+    printf("Playing sound [%.2f sec.]. Press ENTER to finish.\n", waveTimeMs/1000.0f);
 
-            fread(&params.startFrequencyValue, 1, sizeof(float), sfsFile);
-            fread(&params.minFrequencyValue, 1, sizeof(float), sfsFile);
-            fread(&params.slideValue, 1, sizeof(float), sfsFile);
+    PlayAudioStream(audio);             // Play audio stream, buffers are provided when processed
 
-            if (version >= 101) fread(&params.deltaSlideValue, 1, sizeof(float), sfsFile);
+    short samples[PLAY_STREAM_FRAMES] = { 0 };
+    double startTime = GetPreciseTime();
+    int percent = -1;
 
-            fread(&params.squareDutyValue, 1, sizeof(float), sfsFile);
-            fread(&params.dutySweepValue, 1, sizeof(float), sfsFile);
+    InitPlaybackInput();
 
-            fread(&params.vibratoDepthValue, 1, sizeof(float), sfsFile);
-            fread(&params.vibratoSpeedValue, 1, sizeof(float), sfsFile);
+    while (true)
+    {
+        // Generate next block for every processed audio stream buffer
+        while ((stream.frame < stream.frameCount) && IsAudioBufferProcessed(audio))
+        {
+            int count = ReadWaveStream(&stream, samples, PLAY_STREAM_FRAMES);
+            if (count > 0) UpdateAudioStream(audio, samples, count);
+            else break;
+        }
 
-            float vibratoPhaseDelay = 0.0f;
-            fread(&vibratoPhaseDelay, 1, sizeof(float), sfsFile); // Not used
+        float timeMs = (float)((GetPreciseTime() - startTime)*1000.0);
+        PrintPlaybackProgress((timeMs < waveTimeMs)? timeMs : waveTimeMs, waveTimeMs, &percent);
 
-            fread(&params.attackTimeValue, 1, sizeof(float), sfsFile);
-            fread(&params.sustainTimeValue, 1, sizeof(float), sfsFile);
-            fread(&params.decayTimeValue, 1, sizeof(float), sfsFile);
-            fread(&params.sustainPunchValue, 1, sizeof(float), sfsFile);
+        if ((timeMs >= endTimeMs) || WaitPlaybackInput(PLAY_UPDATE_MS)) break;
+    }
 
-            bool filterOn = false;
-            fread(&filterOn, 1, sizeof(bool), sfsFile); // Not used
+    ClosePlaybackInput();
+    printf("\n\n");
 
-            fread(&params.lpfResonanceValue, 1, sizeof(float), sfsFile);
-            fread(&params.lpfCutoffValue, 1, sizeof(float), sfsFile);
-            fread(&params.lpfCutoffSweepValue, 1, sizeof(float), sfsFile);
-            fread(&params.hpfCutoffValue, 1, sizeof(float), sfsFile);
-            fread(&params.hpfCutoffSweepValue, 1, sizeof(float), sfsFile);
+    CloseWaveStream(&stream, NULL);
+    StopAudioStream(audio);
+    CloseAudioStream(audio);            // Close audio stream
+    CloseAudioDevice();                 // Close audio device
+}
 
-            fread(&params.phaserOffsetValue, 1, sizeof(float), sfsFile);
-            fread(&params.phaserSweepValue, 1, sizeof(float), sfsFile);
-            fread(&params.repeatSpeedValue, 1, sizeof(float), sfsFile);
+#if !defined(_WIN32)
+static struct termios playbackTermios = { 0 };  // Console input settings, restored after playback
+static bool playbackTerminal = false;           // Console input is a terminal, settings changed for playback
+static bool playbackInput = false;              // Console input available for playback stop key
+#endif
 
-            if (version >= 101)
-            {
-                fread(&params.changeSpeedValue, 1, sizeof(float), sfsFile);
-                fread(&params.changeAmountValue, 1, sizeof(float), sfsFile);
-            }
-        }
-        else printf("[%s] SFS file version not supported\n", fileName);
+// Init console input for playback: no line buffering and no echo, so keys are read as pressed
+// NOTE: Terminal settings are only changed once per playback (not per key check)
+static void InitPlaybackInput(void)
+{
+#if !defined(_WIN32)
+    playbackInput = true;
+    playbackTerminal = (tcgetattr(STDIN_FILENO, &playbackTermios) == 0);
 
-        fclose(sfsFile);
+    if (playbackTerminal)
+    {
+        struct termios playTermios = playbackTermios;
+        playTermios.c_lflag &= ~(ICANON | ECHO);
+        playTermios.c_cc[VMIN] = 1;
+        playTermios.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &playTermios);
     }
+#endif
+}
 
-    return params;
+// Restore console input after playback
+static void ClosePlaybackInput(void)
+{
+#if !defined(_WIN32)
+    if (playbackTerminal) tcsetattr(STDIN_FILENO, TCSANOW, &playbackTermios);
+    playbackTerminal = false;
+#endif
 }
 
-// Save .rfx sound parameters file
-static void SaveWaveParams(WaveParams params, const char *fileName)
+// Wait for playback stop key (ENTER, ESCAPE) up to ms milliseconds, returns true if stop key pressed
+// NOTE: Thread sleeps while waiting (poll() on console input), so no CPU is used while sound is playing
+static bool WaitPlaybackInput(int ms)
 {
-    if (IsFileExtension(GetExtension(fileName), ".rfx"))
-    {
-        // Fx Sound File Structure (.rfx)
-        // ------------------------------------------------------
-        // Offset | Size  | Type       | Description
-        // ------------------------------------------------------
-        // 0      | 4     | char       | Signature: "rFX "
-        // 4      | 2     | short      | Version: 200
-        // 6      | 2     | short      | Data length: 96 bytes
-        // 8      | 96    | WaveParams | Wave parameters
-        // ------------------------------------------------------
+    int key = 0;
 
-        FILE *rfxFile = fopen(fileName, "wb");
+#if defined(_WIN32)
+    if (kbhit()) key = getch();
+    else Sleep(ms);
+#else
+    if (playbackInput)
+    {
+        struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
 
-        if (rfxFile != NULL)
+        if (poll(&input, 1, ms) > 0)
         {
-            unsigned char signature[5] = "rFX ";
-            unsigned short version = 200;
-            unsigned short length = sizeof(WaveParams);
-            
-            // Write .rfx file header
-            fwrite(signature, 4, sizeof(unsigned char), rfxFile);
-            fwrite(&version, 1, sizeof(unsigned short), rfxFile);
-            fwrite(&length, 1, sizeof(unsigned short), rfxFile);
-
-            // Write wave generation parameters
-            fwrite(&params, 1, sizeof(WaveParams), rfxFile);
+            unsigned char c = 0;
 
-            fclose(rfxFile);
+            // NOTE: Closed (or not readable) input is no longer waited, playback time is just waited
+            if (read(STDIN_FILENO, &c, 1) == 1) key = c;
+            else playbackInput = false;
         }
     }
-}
-
-// Show dialog: load sound parameters file
-static WaveParams DialogLoadSound(void)
-{
-    WaveParams params = { 0 };
-    
-    // Open file dialog
-    const char *filters[] = { "*.rfx", "*.sfs" };
-    const char *fileName = tinyfd_openFileDialog("Load sound parameters file", "", 2, filters, "Sound Param Files (*.rfx, *.sfs)", 0);
-
-    if (fileName != NULL)
+    else
     {
-        params = LoadWaveParams(fileName);
-        //SetWindowTitle(FormatText("rFXGen v%s - %s", TOOL_VERSION_TEXT, GetFileName(fileName)));
+        struct timespec wait = { ms/1000, (ms%1000)*1000000L };
+        nanosleep(&wait, NULL);
     }
-    
-    return params;
+#endif
+
+    return ((key == 10) || (key == 13) || (key == 27));     // KEY_ENTER || KEY_ESCAPE
 }
 
-// Show dialog: save sound parameters file
-static void DialogSaveSound(WaveParams params)
+// Print console playback time bar, only printed if percent changed
+static void PrintPlaybackProgress(float timeMs, float totalTimeMs, int *prevPercent)
 {
-    // Save file dialog
-    const char *filters[] = { "*.rfx" };
-    const char *fileName = tinyfd_saveFileDialog("Save sound parameters file", "sound.rfx", 1, filters, "Sound Param Files (*.rfx)");
+    int percent = (totalTimeMs > 0.0f)? (int)(timeMs/totalTimeMs*100.0f) : 100;
+    if (percent > 100) percent = 100;
 
-    if (fileName != NULL)
+    if (percent != *prevPercent)
     {
-        char outFileName[128] = { 0 };
-        strcpy(outFileName, fileName);
-
-        // Check for valid extension and make sure it is
-        if ((GetExtension(outFileName) == NULL) || !IsFileExtension(outFileName, ".rfx")) strcat(outFileName, ".rfx\0");
+        printf("\r[");
+        for (int j = 0; j < 50; j++)
+        {
+            if (j < percent/2) printf("=");
+            else printf(" ");
+        }
+        printf("] [%02i%%]", percent);
+        fflush(stdout);
 
-        // Save wave parameters
-        SaveWaveParams(params, outFileName);
+        *prevPercent = percent;
     }
 }
+#endif
 
-// Show dialog: export current sound as .wav
-static void DialogExportWave(Wave wave)
+// Check if file name matches wildcard pattern (*, ?)
+static bool MatchFilePattern(const char *fileName, const char *pattern)
 {
-    // Save file dialog
-    const char *filters[] = { "*.wav" };
-    const char *fileName = tinyfd_saveFileDialog("Export wave file", "sound.wav", 1, filters, "Wave File (*.wav)");
+    if (*pattern == '\0') return (*fileName == '\0');
+    if (*pattern == '*') return (MatchFilePattern(fileName, pattern + 1) || ((*fileName != '\0') && MatchFilePattern(fileName + 1, pattern)));
+    if ((*fileName != '\0') && ((*pattern == '?') || (*pattern == *fileName))) return MatchFilePattern(fileName + 1, pattern + 1);
 
-    if (fileName != NULL)
-    {
-        char outFileName[128] = { 0 };
-        strcpy(outFileName, fileName);
+    return false;
+}
 
-        // Check for valid extension and make sure it is
-        if ((GetExtension(outFileName) == NULL) || !IsFileExtension(outFileName, ".wav")) strcat(outFileName, ".wav\0");
+// Create directory if it does not exist
+static void MakeDirectory(const char *dirPath)
+{
+    struct stat dirStat;
 
-        // Export wave data
-        Wave cwave = WaveCopy(wave);
-        WaveFormat(&cwave, wavSampleRate, wavSampleSize, 1);    // Before exporting wave data, we format it as desired
-        ExportWave(cwave, outFileName);                         // Export wave data to file
-        UnloadWave(cwave);
+    if (stat(dirPath, &dirStat) != 0)
+    {
+#if defined(_WIN32)
+        _mkdir(dirPath);
+#else
+        mkdir(dirPath, 0755);
+#endif
     }
 }
 
+#endif      // VERSION_ONE
+
+#if defined(COMMAND_LINE_ONLY)
 //--------------------------------------------------------------------------------------------
-// Sound generation functions
+// Headless functions (raylib functions replacements)
+// NOTE: Same behaviour as raylib functions, but thread-safe (batch export from worker threads)
 //--------------------------------------------------------------------------------------------
 
-// Generate sound: Pickup/Coin
-static WaveParams GenPickupCoin(void)
-{
-    WaveParams params = { 0 };
-    ResetWaveParams(&params);
+// Directory file names, loaded by GetDirectoryFiles()
+static char **dirFilesPath = NULL;
+static int dirFilesCount = 0;
 
-    params.startFrequencyValue = 0.4f + frnd(0.5f);
-    params.attackTimeValue = 0.0f;
-    params.sustainTimeValue = frnd(0.1f);
-    params.decayTimeValue = 0.1f + frnd(0.4f);
-    params.sustainPunchValue = 0.3f + frnd(0.3f);
+// Check file extension (including dot)
+static bool IsFileExtension(const char *fileName, const char *ext)
+{
+    const char *fileExt = strrchr(fileName, '.');
 
-    if (GetRandomValue(0, 1))
-    {
-        params.changeSpeedValue = 0.5f + frnd(0.2f);
-        params.changeAmountValue = 0.2f + frnd(0.4f);
-    }
-    
-    return params;
+    return ((fileExt != NULL) && (strcmp(fileExt, ext) == 0));
 }
 
-// Generate sound: Laser shoot
-static WaveParams GenLaserShoot(void)
+// Get pointer to file name for a path (after last path separator)
+static const char *GetFileName(const char *filePath)
 {
-    WaveParams params = { 0 };
-    ResetWaveParams(&params);
-
-    params.waveTypeValue = GetRandomValue(0, 2);
-
-    if ((params.waveTypeValue == 2) && GetRandomValue(0, 1)) params.waveTypeValue = GetRandomValue(0, 1);
-
-    params.startFrequencyValue = 0.5f + frnd(0.5f);
-    params.minFrequencyValue = params.startFrequencyValue - 0.2f - frnd(0.6f);
+    const char *fileName = filePath;
 
-    if (params.minFrequencyValue < 0.2f) params.minFrequencyValue = 0.2f;
+    for (const char *c = filePath; *c != '\0'; c++) if ((*c == '/') || (*c == '\\')) fileName = c + 1;
 
-    params.slideValue = -0.15f - frnd(0.2f);
+    return fileName;
+}
 
-    if (GetRandomValue(0, 2) == 0)
-    {
-        params.startFrequencyValue = 0.3f + frnd(0.6f);
-        params.minFrequencyValue = frnd(0.1f);
-        params.slideValue = -0.35f - frnd(0.3f);
-    }
+// Split text into multiple strings, strings and array must be freed by caller
+static char **SplitText(char *text, char delimiter, int *strCount)
+{
+    char **strings = NULL;
+    int count = 0;
+    const char *start = text;
 
-    if (GetRandomValue(0, 1))
+    while (true)
     {
-        params.squareDutyValue = frnd(0.5f);
-        params.dutySweepValue = frnd(0.2f);
-    }
-    else
-    {
-        params.squareDutyValue = 0.4f + frnd(0.5f);
-        params.dutySweepValue = -frnd(0.7f);
-    }
+        const char *end = strchr(start, delimiter);
+        int length = (end != NULL)? (int)(end - start) : (int)strlen(start);
 
-    params.attackTimeValue = 0.0f;
-    params.sustainTimeValue = 0.1f + frnd(0.2f);
-    params.decayTimeValue = frnd(0.4f);
+        strings = (char **)realloc(strings, (count + 1)*sizeof(char *));
+        strings[count] = (char *)calloc(length + 1, 1);
+        memcpy(strings[count], start, length);
+        count++;
 
-    if (GetRandomValue(0, 1)) params.sustainPunchValue = frnd(0.3f);
-
-    if (GetRandomValue(0, 2) == 0)
-    {
-        params.phaserOffsetValue = frnd(0.2f);
-        params.phaserSweepValue = -frnd(0.2f);
+        if (end == NULL) break;
+        start = end + 1;
     }
 
-    if (GetRandomValue(0, 1)) params.hpfCutoffValue = frnd(0.3f);
+    *strCount = count;
 
-    return params;
+    return strings;
 }
 
-// Generate sound: Explosion
-static WaveParams GenExplosion(void)
+// Get file names in a directory path, file names are kept until ClearDirectoryFiles()
+static char **GetDirectoryFiles(const char *dirPath, int *count)
 {
-    WaveParams params = { 0 };
-    ResetWaveParams(&params);
+    ClearDirectoryFiles();
 
-    params.waveTypeValue = 3;
+    DIR *dir = opendir(dirPath);
 
-    if (GetRandomValue(0, 1))
+    if (dir != NULL)
     {
-        params.startFrequencyValue = 0.1f + frnd(0.4f);
-        params.slideValue = -0.1f + frnd(0.4f);
-    }
-    else
-    {
-        params.startFrequencyValue = 0.2f + frnd(0.7f);
-        params.slideValue = -0.2f - frnd(0.2f);
-    }
+        struct dirent *entry = NULL;
 
-    params.startFrequencyValue *= params.startFrequencyValue;
-
-    if (GetRandomValue(0, 4) == 0) params.slideValue = 0.0f;
-    if (GetRandomValue(0, 2) == 0) params.repeatSpeedValue = 0.3f + frnd(0.5f);
-
-    params.attackTimeValue = 0.0f;
-    params.sustainTimeValue = 0.1f + frnd(0.3f);
-    params.decayTimeValue = frnd(0.5f);
+        while ((entry = readdir(dir)) != NULL)
+        {
+            dirFilesPath = (char **)realloc(dirFilesPath, (dirFilesCount + 1)*sizeof(char *));
+            dirFilesPath[dirFilesCount] = (char *)calloc(strlen(entry->d_name) + 1, 1);
+            strcpy(dirFilesPath[dirFilesCount], entry->d_name);
+            dirFilesCount++;
+        }
 
-    if (GetRandomValue(0, 1) == 0)
-    {
-        params.phaserOffsetValue = -0.3f + frnd(0.9f);
-        params.phaserSweepValue = -frnd(0.3f);
+        closedir(dir);
     }
+    else printf("WARNING: Can not open directory: %s\n", dirPath);
 
-    params.sustainPunchValue = 0.2f + frnd(0.6f);
+    *count = dirFilesCount;
 
-    if (GetRandomValue(0, 1))
-    {
-        params.vibratoDepthValue = frnd(0.7f);
-        params.vibratoSpeedValue = frnd(0.6f);
-    }
+    return dirFilesPath;
+}
 
-    if (GetRandomValue(0, 2) == 0)
-    {
-        params.changeSpeedValue = 0.6f + frnd(0.3f);
-        params.changeAmountValue = 0.8f - frnd(1.6f);
-    }
+// Clear directory file names
+static void ClearDirectoryFiles(void)
+{
+    for (int i = 0; i < dirFilesCount; i++) free(dirFilesPath[i]);
 
-    return params;
+    free(dirFilesPath);
+    dirFilesPath = NULL;
+    dirFilesCount = 0;
 }
 
-// Generate sound: Powerup
-static WaveParams GenPowerup(void)
+// Load wave data from file (.wav)
+// NOTE: Supported formats: PCM 8 bit and 16 bit, IEEE float 32 bit (also as WAVE_FORMAT_EXTENSIBLE)
+static Wave LoadWave(const char *fileName)
 {
-    WaveParams params = { 0 };
-    ResetWaveParams(&params);
-    
-    if (GetRandomValue(0, 1)) params.waveTypeValue = 1;
-    else params.squareDutyValue = frnd(0.6f);
+    Wave wave = { 0 };
+    FILE *wavFile = fopen(fileName, "rb");
 
-    if (GetRandomValue(0, 1))
+    if (wavFile == NULL)
     {
-        params.startFrequencyValue = 0.2f + frnd(0.3f);
-        params.slideValue = 0.1f + frnd(0.4f);
-        params.repeatSpeedValue = 0.4f + frnd(0.4f);
+        printf("[%s] WAV file could not be opened\n", fileName);
+        return wave;
     }
-    else
-    {
-        params.startFrequencyValue = 0.2f + frnd(0.3f);
-        params.slideValue = 0.05f + frnd(0.2f);
 
-        if (GetRandomValue(0, 1))
-        {
-            params.vibratoDepthValue = frnd(0.7f);
-            params.vibratoSpeedValue = frnd(0.6f);
-        }
-    }
+    char chunkId[4] = { 0 };
+    unsigned int chunkSize = 0;
+    char format[4] = { 0 };
 
-    params.attackTimeValue = 0.0f;
-    params.sustainTimeValue = frnd(0.4f);
-    params.decayTimeValue = 0.1f + frnd(0.4f);
+    unsigned short audioFormat = 0;
+    unsigned short channels = 0;
+    unsigned int sampleRate = 0;
+    unsigned short bitsPerSample = 0;
 
-    return params;
-}
+    fread(chunkId, 1, 4, wavFile);
+    fread(&chunkSize, sizeof(unsigned int), 1, wavFile);
+    fread(format, 1, 4, wavFile);
 
-// Generate sound: Hit/Hurt
-static WaveParams GenHitHurt(void)
-{
-    WaveParams params = { 0 };
-    ResetWaveParams(&params);
+    if ((strncmp(chunkId, "RIFF", 4) == 0) && (strncmp(format, "WAVE", 4) == 0))
+    {
+        // Look for format and data chunks, other chunks are skipped (chunks are 2 bytes aligned)
+        while ((fread(chunkId, 1, 4, wavFile) == 4) && (fread(&chunkSize, sizeof(unsigned int), 1, wavFile) == 1))
+        {
+            if ((strncmp(chunkId, "fmt ", 4) == 0) && (chunkSize >= 16))
+            {
+                unsigned char fmt[40] = { 0 };
+                unsigned int fmtSize = (chunkSize < 40)? chunkSize : 40;
 
-    params.waveTypeValue = GetRandomValue(0, 2);
-    if (params.waveTypeValue == 2) params.waveTypeValue = 3;
-    if (params.waveTypeValue == 0) params.squareDutyValue = frnd(0.6f);
+                fread(fmt, 1, fmtSize, wavFile);
+                fseek(wavFile, chunkSize - fmtSize + (chunkSize & 1), SEEK_CUR);
 
-    params.startFrequencyValue = 0.2f + frnd(0.6f);
-    params.slideValue = -0.3f - frnd(0.4f);
-    params.attackTimeValue = 0.0f;
-    params.sustainTimeValue = frnd(0.1f);
-    params.decayTimeValue = 0.1f + frnd(0.2f);
+                memcpy(&audioFormat, fmt + 0, 2);
+                memcpy(&channels, fmt + 2, 2);
+                memcpy(&sampleRate, fmt + 4, 4);
+                memcpy(&bitsPerSample, fmt + 14, 2);
 
-    if (GetRandomValue(0, 1)) params.hpfCutoffValue = frnd(0.3f);
+                // WAVE_FORMAT_EXTENSIBLE: format tag is the first 2 bytes of subformat GUID
+                if ((audioFormat == 0xfffe) && (fmtSize >= 26)) memcpy(&audioFormat, fmt + 24, 2);
+            }
+            else if (strncmp(chunkId, "data", 4) == 0)
+            {
+                bool supported = (((audioFormat == 1) && ((bitsPerSample == 8) || (bitsPerSample == 16))) ||
+                                  ((audioFormat == 3) && (bitsPerSample == 32))) && ((channels == 1) || (channels == 2));
 
-    return params;
-}
+                if (supported)
+                {
+                    unsigned int frameSize = channels*bitsPerSample/8;
+                    unsigned int sampleCount = chunkSize/frameSize;
+                    void *data = malloc((sampleCount > 0)? sampleCount*frameSize : 1);
 
-// Generate sound: Jump
-static WaveParams GenJump(void)
-{
-    WaveParams params = { 0 };
-    ResetWaveParams(&params);
+                    if (fread(data, frameSize, sampleCount, wavFile) == sampleCount)
+                    {
+                        wave.sampleCount = sampleCount;
+                        wave.sampleRate = sampleRate;
+                        wave.sampleSize = bitsPerSample;
+                        wave.channels = channels;
+                        wave.data = data;
+                    }
+                    else free(data);
+                }
+                else printf("[%s] WAV format not supported (format: %i, %i bits, %i channels)\n", fileName, audioFormat, bitsPerSample, channels);
 
-    params.waveTypeValue = 0;
-    params.squareDutyValue = frnd(0.6f);
-    params.startFrequencyValue = 0.3f + frnd(0.3f);
-    params.slideValue = 0.1f + frnd(0.2f);
-    params.attackTimeValue = 0.0f;
-    params.sustainTimeValue = 0.1f + frnd(0.3f);
-    params.decayTimeValue = 0.1f + frnd(0.2f);
+                break;
+            }
+            else fseek(wavFile, chunkSize + (chunkSize & 1), SEEK_CUR);
+        }
+    }
 
-    if (GetRandomValue(0, 1)) params.hpfCutoffValue = frnd(0.3f);
-    if (GetRandomValue(0, 1)) params.lpfCutoffValue = 1.0f - frnd(0.6f);
+    if (wave.data == NULL) printf("[%s] WAV file could not be loaded\n", fileName);
 
-    return params;
+    fclose(wavFile);
+
+    return wave;
 }
 
-// Generate sound: Blip/Select
-static WaveParams GenBlipSelect(void)
+// Copy a wave to a new wave
+static Wave WaveCopy(Wave wave)
 {
-    WaveParams params = { 0 };
-    ResetWaveParams(&params);
+    Wave newWave = wave;
+    int dataSize = wave.sampleCount*wave.channels*wave.sampleSize/8;
 
-    params.waveTypeValue = GetRandomValue(0, 1);
-    if (params.waveTypeValue == 0) params.squareDutyValue = frnd(0.6f);
-    params.startFrequencyValue = 0.2f + frnd(0.4f);
-    params.attackTimeValue = 0.0f;
-    params.sustainTimeValue = 0.1f + frnd(0.1f);
-    params.decayTimeValue = frnd(0.2f);
-    params.hpfCutoffValue = 0.1f;
+    newWave.data = malloc((dataSize > 0)? dataSize : 1);
+    if (wave.data != NULL) memcpy(newWave.data, wave.data, dataSize);
 
-    return params;
+    return newWave;
 }
 
-// Generate random sound
-static WaveParams GenRandomize(void)
+// Convert wave data to desired format
+// NOTE: Samples are resampled with linear interpolation, stereo to mono is the channels average
+static void WaveFormat(Wave *wave, int sampleRate, int sampleSize, int channels)
 {
-    WaveParams params = { 0 };
-    ResetWaveParams(&params);
-    
-    params.randSeed = GetRandomValue(0, 0xFFFE);
-
-    params.startFrequencyValue = pow(frnd(2.0f) - 1.0f, 2.0f);
-
-    if (GetRandomValue(0, 1)) params.startFrequencyValue = pow(frnd(2.0f) - 1.0f, 3.0f)+0.5f;
-
-    params.minFrequencyValue = 0.0f;
-    params.slideValue = pow(frnd(2.0f) - 1.0f, 5.0f);
+    if ((wave->data == NULL) || (((int)wave->sampleRate == sampleRate) && ((int)wave->sampleSize == sampleSize) && ((int)wave->channels == channels))) return;
 
-    if ((params.startFrequencyValue > 0.7f) && (params.slideValue > 0.2f)) params.slideValue = -params.slideValue;
-    if ((params.startFrequencyValue < 0.2f) && (params.slideValue < -0.05f)) params.slideValue = -params.slideValue;
+    int inChannels = wave->channels;
+    int inCount = wave->sampleCount;
+    int outCount = (int)((long long)inCount*sampleRate/wave->sampleRate);
 
-    params.deltaSlideValue = pow(frnd(2.0f) - 1.0f, 3.0f);
-    params.squareDutyValue = frnd(2.0f) - 1.0f;
-    params.dutySweepValue = pow(frnd(2.0f) - 1.0f, 3.0f);
-    params.vibratoDepthValue = pow(frnd(2.0f) - 1.0f, 3.0f);
-    params.vibratoSpeedValue = frnd(2.0f) - 1.0f;
-    //params.vibratoPhaseDelay = frnd(2.0f) - 1.0f;
-    params.attackTimeValue = pow(frnd(2.0f) - 1.0f, 3.0f);
-    params.sustainTimeValue = pow(frnd(2.0f) - 1.0f, 2.0f);
-    params.decayTimeValue = frnd(2.0f)-1.0f;
-    params.sustainPunchValue = pow(frnd(0.8f), 2.0f);
+    // Convert input samples to float
+    float *samples = (float *)malloc(((inCount > 0)? inCount : 1)*inChannels*sizeof(float));
 
-    if (params.attackTimeValue + params.sustainTimeValue + params.decayTimeValue < 0.2f)
+    for (int i = 0; i < inCount*inChannels; i++)
     {
-        params.sustainTimeValue += 0.2f + frnd(0.3f);
-        params.decayTimeValue += 0.2f + frnd(0.3f);
+        if (wave->sampleSize == 8) samples[i] = (((unsigned char *)wave->data)[i] - 128)/127.0f;
+        else if (wave->sampleSize == 16) samples[i] = ((short *)wave->data)[i]/32767.0f;
+        else samples[i] = ((float *)wave->data)[i];
     }
 
-    params.lpfResonanceValue = frnd(2.0f) - 1.0f;
-    params.lpfCutoffValue = 1.0f - pow(frnd(1.0f), 3.0f);
-    params.lpfCutoffSweepValue = pow(frnd(2.0f) - 1.0f, 3.0f);
-
-    if (params.lpfCutoffValue < 0.1f && params.lpfCutoffSweepValue < -0.05f) params.lpfCutoffSweepValue = -params.lpfCutoffSweepValue;
-
-    params.hpfCutoffValue = pow(frnd(1.0f), 5.0f);
-    params.hpfCutoffSweepValue = pow(frnd(2.0f) - 1.0f, 5.0f);
-    params.phaserOffsetValue = pow(frnd(2.0f) - 1.0f, 3.0f);
-    params.phaserSweepValue = pow(frnd(2.0f) - 1.0f, 3.0f);
-    params.repeatSpeedValue = frnd(2.0f) - 1.0f;
-    params.changeSpeedValue = frnd(2.0f) - 1.0f;
-    params.changeAmountValue = frnd(2.0f) - 1.0f;
-    
-    return params;
-}
-
-// Mutate current sound
-static void WaveMutate(WaveParams *params)
-{
-    if (GetRandomValue(0, 1)) params->startFrequencyValue += frnd(0.1f) - 0.05f;
-    //if (GetRandomValue(0, 1)) params.minFrequencyValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->slideValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->deltaSlideValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->squareDutyValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->dutySweepValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->vibratoDepthValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->vibratoSpeedValue += frnd(0.1f) - 0.05f;
-    //if (GetRandomValue(0, 1)) params.vibratoPhaseDelay += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->attackTimeValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->sustainTimeValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->decayTimeValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->sustainPunchValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->lpfResonanceValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->lpfCutoffValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->lpfCutoffSweepValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->hpfCutoffValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->hpfCutoffSweepValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->phaserOffsetValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->phaserSweepValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->repeatSpeedValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->changeSpeedValue += frnd(0.1f) - 0.05f;
-    if (GetRandomValue(0, 1)) params->changeAmountValue += frnd(0.1f) - 0.05f;
-}
-
-//--------------------------------------------------------------------------------------------
-// Auxiliar functions
-//--------------------------------------------------------------------------------------------
-
-#if !defined(COMMAND_LINE_ONLY)
-// Draw wave data
-// NOTE: For proper visualization, MSAA x4 is recommended, alternatively
-// it should be rendered to a bigger texture and then scaled down with
-// bilinear/trilinear texture filtering
-static void DrawWave(Wave *wave, Rectangle bounds, Color color)
-{
-    float sample, sampleNext;
-    float currentSample = 0.0f;
-    float sampleIncrement = (float)wave->sampleCount/(float)(bounds.width*2);
-    float sampleScale = (float)bounds.height;
-
-    for (int i = 1; i < bounds.width*2 - 1; i++)
-    {
-        sample = ((float *)wave->data)[(int)currentSample]*sampleScale;
-        sampleNext = ((float *)wave->data)[(int)(currentSample + sampleIncrement)]*sampleScale;
-
-        if (sample > bounds.height/2) sample = bounds.height/2;
-        else if (sample < -bounds.height/2) sample = -bounds.height/2;
-
-        if (sampleNext > bounds.height/2) sampleNext = bounds.height/2;
-        else if (sampleNext < -bounds.height/2) sampleNext = -bounds.height/2;
-
-        DrawLineV((Vector2){ (float)bounds.x + (float)i/2.0f, (float)(bounds.y + bounds.height/2) + sample },
-                  (Vector2){ (float)bounds.x + (float)i/2.0f, (float)(bounds.y  + bounds.height/2) + sampleNext }, color);
-
-        currentSample += sampleIncrement;
-    }
-}
-#endif // COMMAND_LINE_ONLY
+    void *data = malloc(((outCount > 0)? outCount : 1)*channels*sampleSize/8);
 
-#if defined(VERSION_ONE) || defined(COMMAND_LINE_ONLY)
-// Simple time wait in milliseconds
-static void WaitTime(int ms)
-{
-    if (ms > 0)
+    for (int i = 0; i < outCount; i++)
     {
-        int currentTime = clock()*1000/CLOCKS_PER_SEC;  // Current time in milliseconds
-        int totalTime = currentTime + ms;               // Total required time in ms to return from this timeout
-
-        int percent = 0;
-        int prevPercent = percent;
+        // Input position for output frame, next frame is interpolated
+        double position = (double)i*wave->sampleRate/sampleRate;
+        int frame = (int)position;
+        int nextFrame = (frame + 1 < inCount)? frame + 1 : frame;
+        float weight = (float)(position - frame);
 
-        // Wait until current ms time matches total ms time
-        while (currentTime <= totalTime)
+        for (int c = 0; c < channels; c++)
         {
-            // Check for key pressed to stop playing
-            if (kbhit())
+            float sample = 0.0f;
+
+            if ((inChannels == 2) && (channels == 1))
             {
-                int key = getch();
-                if ((key == 13) || (key == 27)) break;    // KEY_ENTER || KEY_ESCAPE
+                float current = (samples[frame*2] + samples[frame*2 + 1])*0.5f;
+                float next = (samples[nextFrame*2] + samples[nextFrame*2 + 1])*0.5f;
+                sample = current + (next - current)*weight;
             }
-
-            currentTime = clock()*1000/CLOCKS_PER_SEC;
-
-            // Print console time bar
-            percent = (int)(((float)currentTime/totalTime)*100.0f);
-
-            if (percent != prevPercent)
+            else
             {
-                printf("\r[");
-                for (int j = 0; j < 50; j++)
-                {
-                    if (j < percent/2) printf("=");
-                    else printf(" ");
-                }
-                printf("] [%02i%%]", percent);
-
-                prevPercent = percent;
+                int ic = (c < inChannels)? c : inChannels - 1;
+                sample = samples[frame*inChannels + ic] + (samples[nextFrame*inChannels + ic] - samples[frame*inChannels + ic])*weight;
             }
-        }
 
-        printf("\n\n");
+            if (sample > 1.0f) sample = 1.0f;
+            else if (sample < -1.0f) sample = -1.0f;
+
+            if (sampleSize == 8) ((unsigned char *)data)[i*channels + c] = (unsigned char)floorf(sample*127.0f + 128.0f + 0.5f);
+            else if (sampleSize == 16) ((short *)data)[i*channels + c] = (short)floorf(sample*32767.0f + 0.5f);
+            else ((float *)data)[i*channels + c] = sample;
+        }
     }
-}
 
-// Play provided wave through CLI
-static void PlayWaveCLI(Wave wave)
-{
-    float waveTimeMs = (float)wave.sampleCount*1000.0/(wave.sampleRate*wave.channels);
+    free(samples);
+    free(wave->data);
 
-    InitAudioDevice();                  // Init audio device
-    Sound fx = LoadSoundFromWave(wave); // Load WAV audio file
+    wave->data = data;
+    wave->sampleCount = outCount;
+    wave->sampleRate = sampleRate;
+    wave->sampleSize = sampleSize;
+    wave->channels = channels;
+}
 
-    printf("\n//////////////////////////////////////////////////////////////////////////////////\n");
-    printf("//                                                                              //\n");
-    printf("// rFXGen v%s - CLI audio player                                               //\n", TOOL_VERSION_TEXT);
-    printf("//                                                                              //\n");
-    printf("// more info and bugs-report: github.com/raysan5/rfxgen                         //\n");
-    printf("//                                                                              //\n");
-    printf("// Copyright (c) 2018 raylib technologies (@raylibtech)                         //\n");
-    printf("//                                                                              //\n");
-    printf("//////////////////////////////////////////////////////////////////////////////////\n\n");
+// Export wave data to file (.wav)
+// NOTE: 32 bit samples are exported as IEEE float samples
+static void ExportWave(Wave wave, const char *fileName)
+{
+    FILE *wavFile = fopen(fileName, "wb");
 
-    printf("Playing sound [%.2f sec.]. Press ENTER to finish.\n", waveTimeMs/1000.0f);
+    if (wavFile == NULL)
+    {
+        printf("[%s] WAV file could not be saved\n", fileName);
+        return;
+    }
 
-    PlaySound(fx);                      // Play sound
-    WaitTime(waveTimeMs);               // Wait while audio is playing
-    UnloadSound(fx);                    // Unload sound data
-    CloseAudioDevice();                 // Close audio device
+    unsigned int dataSize = wave.sampleCount*wave.channels*wave.sampleSize/8;
+    unsigned int riffSize = 36 + dataSize;
+    unsigned int fmtSize = 16;
+    unsigned short audioFormat = (wave.sampleSize == 32)? 3 : 1;
+    unsigned short channels = wave.channels;
+    unsigned int byteRate = wave.sampleRate*wave.channels*wave.sampleSize/8;
+    unsigned short blockAlign = wave.channels*wave.sampleSize/8;
+    unsigned short bitsPerSample = wave.sampleSize;
+
+    // Write RIFF header, format chunk and data chunk
+    fwrite("RIFF", 1, 4, wavFile);
+    fwrite(&riffSize, sizeof(unsigned int), 1, wavFile);
+    fwrite("WAVEfmt ", 1, 8, wavFile);
+    fwrite(&fmtSize, sizeof(unsigned int), 1, wavFile);
+    fwrite(&audioFormat, sizeof(unsigned short), 1, wavFile);
+    fwrite(&channels, sizeof(unsigned short), 1, wavFile);
+    fwrite(&wave.sampleRate, sizeof(unsigned int), 1, wavFile);
+    fwrite(&byteRate, sizeof(unsigned int), 1, wavFile);
+    fwrite(&blockAlign, sizeof(unsigned short), 1, wavFile);
+    fwrite(&bitsPerSample, sizeof(unsigned short), 1, wavFile);
+    fwrite("data", 1, 4, wavFile);
+    fwrite(&dataSize, sizeof(unsigned int), 1, wavFile);
+    fwrite(wave.data, 1, dataSize, wavFile);
+
+    fclose(wavFile);
 }
 
-#if !defined(__WIN32)
-// Check if a key has been pressed
-static int kbhit(void)
+// Export wave sample data to code (.h), data is exported as an array of bytes
+// NOTE: Variables names are the file name (without extension) in uppercase
+static void ExportWaveAsCode(Wave wave, const char *fileName)
 {
-	struct termios oldt, newt;
-	int ch;
-	int oldf;
-
-	tcgetattr(STDIN_FILENO, &oldt);
-	newt = oldt;
-	newt.c_lflag &= ~(ICANON | ECHO);
-	tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-	oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-	fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
-
-	ch = getchar();
+    #define BYTES_TEXT_PER_LINE     20
 
-	tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-	fcntl(STDIN_FILENO, F_SETFL, oldf);
+    FILE *txtFile = fopen(fileName, "wt");
 
-	if (ch != EOF)
-	{
-		ungetc(ch, stdin);
-		return 1;
-	}
+    if (txtFile == NULL)
+    {
+        printf("[%s] Code file could not be saved\n", fileName);
+        return;
+    }
 
-	return 0;
+    char varFileName[256] = { 0 };
+    GetCodeVarName(fileName, varFileName);
+
+    int dataSize = wave.sampleCount*wave.channels*wave.sampleSize/8;
+
+    fprintf(txtFile, "\n//////////////////////////////////////////////////////////////////////////////////\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "// WaveAsCode exporter v1.0 - Wave data exported as an array of bytes           //\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "// more info and bugs-report:  github.com/raysan5/rfxgen                        //\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "// Copyright (c) 2018 raylib technologies (@raylibtech)                         //\n");
+    fprintf(txtFile, "//                                                                              //\n");
+    fprintf(txtFile, "//////////////////////////////////////////////////////////////////////////////////\n\n");
+
+    fprintf(txtFile, "// Wave data information\n");
+    fprintf(txtFile, "#define %s_SAMPLE_COUNT     %i\n", varFileName, wave.sampleCount);
+    fprintf(txtFile, "#define %s_SAMPLE_RATE      %i\n", varFileName, wave.sampleRate);
+    fprintf(txtFile, "#define %s_SAMPLE_SIZE      %i\n", varFileName, wave.sampleSize);
+    fprintf(txtFile, "#define %s_CHANNELS         %i\n\n", varFileName, wave.channels);
+
+    fprintf(txtFile, "static unsigned char %s_DATA[%i] = { ", varFileName, dataSize);
+    for (int i = 0; i < dataSize - 1; i++) fprintf(txtFile, ((i%BYTES_TEXT_PER_LINE == 0)? "0x%x,\n" : "0x%x, "), ((unsigned char *)wave.data)[i]);
+    if (dataSize > 0) fprintf(txtFile, "0x%x };\n", ((unsigned char *)wave.data)[dataSize - 1]);
+    else fprintf(txtFile, "0 };\n");
+
+    fclose(txtFile);
 }
-#endif
-#endif      // VERSION_ONE
+#endif  // COMMAND_LINE_ONLY
@@ -0,0 +1,2686 @@
+/*******************************************************************************************
+*
+*   rFXGen synth - Sound effects synthesizer (based on Tomas Petterson sfxr)
+*
+*   FEATURES:
+*       - Wave generation from parameters, same parameters always generate same wave
+*       - Generation quality tiers: 1x, 2x, 4x, 8x (final) subsamples or adaptive to wave period
+*       - Streaming generation in blocks (synth voice), no memory allocated
+*       - Wave streams: generation in blocks in desired format, for encoders (no full wave required)
+*       - Wave analysis measured on generation: peak, RMS, clipped samples and loudness (ITU-R BS.1770)
+*       - Sound parameters files loading/saving (.rfx, .sfs)
+*       - Sound presets generation and mutation, from provided seed
+*       - Polyphonic synth mixer: voices pool with voice stealing and lock-free commands
+*       - No raylib window/audio dependency
+*
+*   MODULE USAGE:
+*       #define RFXGEN_SYNTH_IMPLEMENTATION
+*       #include "rfxgen_synth.h"
+*
+*   To generate a wave:     Wave wave = GenerateWave(GenPickupCoin(seed));
+*   To generate a draft:    Wave wave = GenerateWavePro(params, 44100, 16, 1, SYNTH_QUALITY_DRAFT);
+*   To analyze a wave:      Wave wave = GenerateWaveAnalyzed(params, 44100, 16, 1, SYNTH_QUALITY_FINAL, &analysis);
+*   To stream a wave:       InitSynthVoice(&voice, params); RenderSynthVoice(&voice, buffer, frames);
+*   To stream a format:     InitWaveStream(&stream, params, 22050, 16, 1, SYNTH_QUALITY_FINAL, false);
+*                           ReadWaveStream(&stream, samples, frames); CloseWaveStream(&stream, NULL);
+*   To mix many voices:     InitSynthMixer(&mixer, 64, 256); PlaySynthMixerVoice(&mixer, params, gain);
+*                           RenderSynthMixer(&mixer, buffer, frames);   // From audio thread
+*
+*   NOTE: If raylib is used, raylib.h must be included before this file, raylib Wave type is used;
+*   otherwise an equivalent Wave type is defined and waves can be unloaded with UnloadWave()
+*
+*   CONFIGURATION:
+*
+*   #define SYNTH_NO_SIMD
+*       Disable SIMD wave oscillator (AVX, SSE2 or NEON, detected from compiler flags),
+*       scalar reference oscillator is used for all wave types.
+*
+*   #define SYNTH_SIMD_VALIDATE
+*       Check every SIMD oscillator block against scalar reference oscillator,
+*       a warning is shown if difference exceeds SYNTH_SIMD_TOLERANCE.
+*
+*   #define SYNTH_MIXER_MAX_VOICES, SYNTH_MIXER_QUEUE_SIZE
+*       Default synth mixer voices and commands queue capacity (used if 0 provided on init).
+*
+*   #define SYNTH_PROFILE
+*       Measure wave generation stages time and count (voice init, synth loop, filter, phaser,
+*       noise refresh and format conversion). Per-sample stages are timed every SYNTH_PROFILE_INTERVAL
+*       events. Measured events can be received through SetSynthProfileCallback() (trace).
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2014-2018 raylib technologies (@raylibtech).
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+#ifndef RFXGEN_SYNTH_H
+#define RFXGEN_SYNTH_H
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MAX_WAVE_LENGTH_SECONDS  10     // Max length for wave: 10 seconds
+#define WAVE_SAMPLE_RATE      44100     // Default sample rate
+
+#define MAX_SUPERSAMPLING         8     // Subsamples generated per wave sample
+#define SAMPLE_SCALE_COEFICIENT 0.2f    // NOTE: Used to scale sample value to [-1..1]
+#define SYNTH_BLOCK_FRAMES     1024     // Samples rendered per block on direct format generation (must be even)
+
+#define SYNTH_SIMD_TOLERANCE   1e-5f    // Max difference allowed between SIMD and scalar oscillators
+
+#define SYNTH_ADAPTIVE_CYCLE     64     // Min subsamples per wave cycle on adaptive quality (square, sawtooth, noise)
+#define SYNTH_ADAPTIVE_SINE_CYCLE 8     // Min subsamples per wave cycle on adaptive quality (sine, no harmonics)
+
+#define SYNTH_LOUDNESS_MIN    -70.0f    // Min loudness measured (LUFS), silent waves and absolute gate (ITU-R BS.1770)
+
+#if !defined(SYNTH_MIXER_MAX_VOICES)
+    #define SYNTH_MIXER_MAX_VOICES   64     // Default synth mixer voices capacity
+#endif
+#if !defined(SYNTH_MIXER_QUEUE_SIZE)
+    #define SYNTH_MIXER_QUEUE_SIZE  256     // Default synth mixer commands queue capacity (rounded up to power of two)
+#endif
+#if !defined(SYNTH_PROFILE_INTERVAL)
+    #define SYNTH_PROFILE_INTERVAL   64     // Per-sample stages events per timed event (profile, power of two)
+#endif
+
+// SIMD instruction set used for wave oscillator, detected from compiler flags
+// NOTE: Scalar oscillator is always available as reference (and for noise wave)
+#if !defined(SYNTH_NO_SIMD)
+    #if defined(__AVX__)
+        #define SYNTH_SIMD_AVX
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define SYNTH_SIMD_SSE2
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #define SYNTH_SIMD_NEON
+    #endif
+#endif
+
+#if defined(SYNTH_SIMD_AVX) || defined(SYNTH_SIMD_SSE2) || defined(SYNTH_SIMD_NEON)
+    #define SYNTH_SIMD_AVAILABLE
+#endif
+
+// Wave oscillator name, reported by benchmark
+#if defined(SYNTH_SIMD_AVX)
+    #define SYNTH_OSCILLATOR_NAME   "avx"
+#elif defined(SYNTH_SIMD_SSE2)
+    #define SYNTH_OSCILLATOR_NAME   "sse2"
+#elif defined(SYNTH_SIMD_NEON)
+    #define SYNTH_OSCILLATOR_NAME   "neon"
+#else
+    #define SYNTH_OSCILLATOR_NAME   "scalar"
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+#if !defined(RAYLIB_H)
+#include <stdbool.h>                    // Required for: bool
+
+// Wave type, same as raylib Wave (defined only if raylib is not used)
+typedef struct Wave {
+    unsigned int sampleCount;       // Number of samples
+    unsigned int sampleRate;        // Frequency (samples per second)
+    unsigned int sampleSize;        // Bit depth (bits per sample): 8, 16, 32 (24 not supported)
+    unsigned int channels;          // Number of channels (1-mono, 2-stereo)
+    void *data;                     // Buffer data pointer
+} Wave;
+#endif
+
+// Wave parameters type (96 bytes)
+typedef struct WaveParams {
+
+    // Random seed used to generate the wave
+    int randSeed;
+
+    // Wave type (square, sawtooth, sine, noise)
+    int waveTypeValue;
+
+    // Wave envelope parameters
+    float attackTimeValue;
+    float sustainTimeValue;
+    float sustainPunchValue;
+    float decayTimeValue;
+
+    // Frequency parameters
+    float startFrequencyValue;
+    float minFrequencyValue;
+    float slideValue;
+    float deltaSlideValue;
+    float vibratoDepthValue;
+    float vibratoSpeedValue;
+    //float vibratoPhaseDelayValue;
+
+    // Tone change parameters
+    float changeAmountValue;
+    float changeSpeedValue;
+
+    // Square wave parameters
+    float squareDutyValue;
+    float dutySweepValue;
+
+    // Repeat parameters
+    float repeatSpeedValue;
+
+    // Phaser parameters
+    float phaserOffsetValue;
+    float phaserSweepValue;
+
+    // Filter parameters
+    float lpfCutoffValue;
+    float lpfCutoffSweepValue;
+    float lpfResonanceValue;
+    float hpfCutoffValue;
+    float hpfCutoffSweepValue;
+
+} WaveParams;
+
+// Synth generation quality: subsamples generated per wave sample
+// NOTE: Only final quality generates reference waves, lower qualities approximate filters response
+typedef enum {
+    SYNTH_QUALITY_ADAPTIVE = 0,     // Subsamples selected from wave period, increased only when aliasing would be audible
+    SYNTH_QUALITY_DRAFT = 1,        // 1 subsample per sample
+    SYNTH_QUALITY_LOW = 2,          // 2 subsamples per sample
+    SYNTH_QUALITY_MEDIUM = 4,       // 4 subsamples per sample
+    SYNTH_QUALITY_FINAL = 8         // 8 subsamples per sample (MAX_SUPERSAMPLING), reference quality
+} SynthQuality;
+
+// Wave analysis, measured during generation on output samples (before quantization to sample size)
+typedef struct WaveAnalysis {
+    int sampleCount;                // Generated samples count (frames)
+    float duration;                 // Generated length in seconds
+    float peak;                     // Peak absolute sample value [0..1]
+    float rms;                      // Root mean square sample value [0..1]
+    float loudness;                 // Integrated loudness in LUFS (ITU-R BS.1770, K-weighted and gated)
+    int clippedCount;               // Generated samples clipped to [-1..1]
+} WaveAnalysis;
+
+// Random numbers generator state (xorshift32)
+// NOTE: State is kept per generation call, global rand() state is never used,
+// so same seed always generates same values, independently of other threads
+typedef struct RandomState {
+    unsigned int value;
+} RandomState;
+
+#if defined(SYNTH_PROFILE)
+// Synth profile stages
+typedef enum {
+    SYNTH_PROFILE_RESET = 0,        // Voice init: parameters reset and wave length
+    SYNTH_PROFILE_SYNTH,            // Synth loop, includes filter, phaser and noise stages
+    SYNTH_PROFILE_FILTER,           // LP/HP filter (per sample, timed every SYNTH_PROFILE_INTERVAL samples)
+    SYNTH_PROFILE_PHASER,           // Phaser (per sample, timed every SYNTH_PROFILE_INTERVAL samples)
+    SYNTH_PROFILE_NOISE,            // Noise buffer refresh (per period, timed every SYNTH_PROFILE_INTERVAL refreshes)
+    SYNTH_PROFILE_FORMAT,           // Wave format conversion
+    SYNTH_PROFILE_EXPORT,           // Wave file export, measured by application
+    SYNTH_PROFILE_STAGES            // Number of profile stages
+} SynthProfileStage;
+
+// Synth profile stage counter
+typedef struct SynthProfileCounter {
+    unsigned long long count;       // Stage events: waves or samples (synth, filter, phaser) or refreshes (noise)
+    unsigned long long time;        // Stage time in nanoseconds
+} SynthProfileCounter;
+
+// Synth profile event callback, called from generation thread for every measured event (not per-sample stages)
+typedef void (*SynthProfileCallback)(int stage, double startTime, double duration, unsigned long long count, void *userData);
+#endif
+
+// Synth render kernel, renders voice frames into buffer, specialized for wave type and enabled features
+struct SynthVoice;
+typedef int (*SynthKernel)(struct SynthVoice *voice, float *buffer, int frames);
+
+// Synth voice: wave generation state, allows streaming generation in blocks
+// NOTE: No memory is allocated by the voice, all generation state is contained
+typedef struct SynthVoice {
+    WaveParams params;              // Wave parameters used for generation
+    RandomState rng;                // Noise random state
+
+    // Configuration parameters for generation
+    // NOTE: Those parameters are calculated from selected values
+    int phase;
+    double fperiod;
+    double fmaxperiod;
+    double fslide;
+    double fdslide;
+    int period;
+    float squareDuty;
+    float squareSlide;
+    int envelopeStage;
+    int envelopeTime;
+    int envelopeLength[3];
+    float envelopeVolume;
+    float fphase;
+    float fdphase;
+    int iphase;
+    float phaserBuffer[1024];
+    int ipp;
+    float noiseBuffer[32];          // Required for noise wave, depends on random seed!
+    float fltp;
+    float fltdp;
+    float fltw;
+    float fltwd;
+    float fltdmp;
+    float fltphp;
+    float flthp;
+    float flthpd;
+    float vibratoPhase;
+    float vibratoSpeed;
+    float vibratoAmplitude;
+    int repeatTime;
+    int repeatLimit;
+    int arpeggioTime;
+    int arpeggioLimit;
+    double arpeggioModulation;
+
+    SynthKernel kernel;             // Render kernel, selected on voice init
+    int quality;                    // Generation quality (SynthQuality)
+
+    int framesRendered;             // Number of frames already rendered
+    int clippedCount;               // Number of frames clipped to [-1..1] (wave analysis)
+    bool finished;                  // Voice finished generating (envelope end or min frequency reached)
+#if defined(SYNTH_SIMD_VALIDATE)
+    float simdMaxError;             // Max difference found between SIMD and scalar oscillators
+#endif
+#if defined(SYNTH_PROFILE)
+    SynthProfileCounter profile[SYNTH_PROFILE_STAGES];  // Per-sample stages counters, added to profile on wave generation end
+#endif
+} SynthVoice;
+
+// Wave stream: wave generated in blocks and read in desired format, no full wave allocated
+// NOTE: Frames are read exactly as GenerateWavePro() generates them (same decimation and dither)
+typedef struct WaveStream {
+    SynthVoice voice;               // Synth voice used for generation
+    RandomState rng;                // Dither random state
+    struct SynthAnalyzer *analyzer; // Wave analyzer (optional, allocated on init)
+    int sampleRate;                 // Stream frequency: 44100 or 22050 Hz
+    int sampleSize;                 // Stream bit depth: 8, 16 or 32 bit (float)
+    int channels;                   // Stream channels: 1 or 2 (same sample on all channels)
+    int frameCount;                 // Stream frames count, known before generation
+    int frame;                      // Frames already read
+    float block[SYNTH_BLOCK_FRAMES];    // Voice render block
+    int blockCount;                 // Samples rendered in current block
+    int blockPosition;              // Next sample to read in current block
+#if defined(SYNTH_PROFILE)
+    double synthTime;               // Generation start time
+    double synthDuration;           // Voice rendering time
+    double formatDuration;          // Format conversion time
+#endif
+} WaveStream;
+
+// Synth mixer command type
+typedef enum {
+    SYNTH_MIXER_PLAY = 0,           // Start voice with wave parameters and gain
+    SYNTH_MIXER_STOP,               // Stop voice
+    SYNTH_MIXER_STOP_ALL            // Stop all voices
+} SynthMixerCommandType;
+
+// Synth mixer command, sent from any thread to mixer thread
+typedef struct SynthMixerCommand {
+    int type;                       // Command type (SynthMixerCommandType)
+    unsigned int voiceId;           // Voice id
+    float gain;                     // Voice gain (SYNTH_MIXER_PLAY)
+    WaveParams params;              // Voice wave parameters (SYNTH_MIXER_PLAY)
+} SynthMixerCommand;
+
+// Synth mixer commands queue cell, sequence number defines cell state (bounded MPSC queue)
+typedef struct SynthMixerCell {
+    volatile unsigned int sequence; // Cell sequence number
+    SynthMixerCommand command;      // Cell command
+} SynthMixerCell;
+
+// Synth mixer voice: synth voice playing on mixer
+typedef struct SynthMixerVoice {
+    SynthVoice voice;               // Synth voice generation state
+    unsigned int id;                // Voice id (0 for free voice)
+    unsigned int order;             // Voice start order, oldest voice is stolen first
+    float gain;                     // Voice gain
+} SynthMixerVoice;
+
+// Synth mixer: fixed capacity pool of synth voices rendered together
+// NOTE: Voices and commands queue are allocated once on init (arena), rendering does not allocate,
+// commands can be sent from any thread (lock-free), rendering must be done from one thread
+typedef struct SynthMixer {
+    void *arena;                    // Mixer memory: voices pool and commands queue
+    SynthMixerVoice *voices;        // Voices pool
+    int voiceCapacity;              // Voices pool capacity
+    int activeCount;                // Voices playing (mixer thread)
+    int stolenCount;                // Voices stolen because pool was full (mixer thread)
+    unsigned int startCount;        // Voices started (mixer thread), used for voices order
+    SynthMixerCell *queue;          // Commands queue
+    unsigned int queueMask;         // Commands queue capacity minus one (power of two capacity)
+    volatile unsigned int queueTail;    // Commands queue next write position (any thread)
+    unsigned int queueHead;         // Commands queue next read position (mixer thread)
+    volatile unsigned int nextVoiceId;  // Last voice id provided (any thread)
+    float block[SYNTH_BLOCK_FRAMES];    // Voice render block
+} SynthMixer;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+
+// Load/Save wave parameters functions
+WaveParams LoadWaveParams(const char *fileName);                        // Load wave parameters from file (.rfx, .sfs)
+WaveParams LoadWaveParamsEx(const char *fileName, float *volume);       // Load wave parameters from file, retrieving sound volume (.sfs)
+void SaveWaveParams(WaveParams params, const char *fileName);           // Save wave parameters to file (.rfx)
+void ResetWaveParams(WaveParams *params);                               // Reset wave parameters
+
+// Wave generation functions
+Wave GenerateWave(WaveParams params);                                   // Generate wave data from parameters
+Wave GenerateWaveEx(WaveParams params, int sampleRate, int sampleSize, int channels);  // Generate wave data from parameters in desired format
+Wave GenerateWavePro(WaveParams params, int sampleRate, int sampleSize, int channels, int quality);    // Generate wave data from parameters in desired format and quality
+Wave GenerateWaveAnalyzed(WaveParams params, int sampleRate, int sampleSize, int channels, int quality, WaveAnalysis *analysis);  // Generate wave data in desired format and quality, measuring wave analysis
+int GetWaveSampleCount(WaveParams params);                              // Get wave samples count for parameters (no generation required)
+float GetWaveDuration(WaveParams params);                               // Get wave duration in seconds for parameters (no generation required)
+#if !defined(RAYLIB_H)
+void UnloadWave(Wave wave);                                             // Unload wave data
+#endif
+
+// Synth voice functions (streaming generation)
+void InitSynthVoice(SynthVoice *voice, WaveParams params);              // Init synth voice for streaming generation
+void InitSynthVoiceEx(SynthVoice *voice, WaveParams params, int quality);   // Init synth voice for streaming generation in desired quality
+int RenderSynthVoice(SynthVoice *voice, float *buffer, int frames);     // Render next frames into buffer, returns frames rendered
+bool IsSynthVoiceFinished(SynthVoice *voice);                           // Check if synth voice finished generating
+
+// Wave stream functions (streaming generation in desired format)
+bool InitWaveStream(WaveStream *stream, WaveParams params, int sampleRate, int sampleSize, int channels, int quality, bool analyze);   // Init wave stream in desired format and quality, returns false if format not supported
+int ReadWaveStream(WaveStream *stream, void *data, int frames);         // Read next frames in stream format, returns frames read (0 on stream end)
+void CloseWaveStream(WaveStream *stream, WaveAnalysis *analysis);       // Close wave stream, retrieving wave analysis (if analyzed)
+
+// Synth mixer functions (polyphonic playback)
+bool InitSynthMixer(SynthMixer *mixer, int voiceCapacity, int queueCapacity);     // Init synth mixer, voices pool and commands queue are allocated
+void CloseSynthMixer(SynthMixer *mixer);                                // Close synth mixer, free allocated memory
+unsigned int PlaySynthMixerVoice(SynthMixer *mixer, WaveParams params, float gain);   // Start voice on mixer (any thread), returns voice id (0 if queue is full)
+bool StopSynthMixerVoice(SynthMixer *mixer, unsigned int voiceId);      // Stop voice on mixer (any thread), returns false if queue is full
+bool StopSynthMixerVoices(SynthMixer *mixer);                           // Stop all voices on mixer (any thread), returns false if queue is full
+int RenderSynthMixer(SynthMixer *mixer, float *buffer, int frames);     // Render all voices mixed into buffer (mixer thread), returns voices playing
+
+#if defined(SYNTH_PROFILE)
+// Synth profile functions
+void SetSynthProfileCallback(SynthProfileCallback callback, void *userData);   // Set profile events callback (must be set before generation)
+void AddSynthProfileEvent(int stage, double startTime, double duration, unsigned long long count);     // Add measured event to profile (any thread)
+void GetSynthProfile(SynthProfileCounter *counters);                    // Get profile counters for all stages (SYNTH_PROFILE_STAGES)
+void ResetSynthProfile(void);                                           // Reset profile counters (no generation in progress)
+const char *GetSynthProfileStageName(int stage);                        // Get profile stage name
+double GetSynthProfileTime(void);                                       // Get profile time in seconds (monotonic, high resolution)
+#endif
+
+// Sound generation functions
+// NOTE: Same seed always generates same sound parameters
+WaveParams GenPickupCoin(unsigned int seed);        // Generate sound: Pickup/Coin
+WaveParams GenLaserShoot(unsigned int seed);        // Generate sound: Laser shoot
+WaveParams GenExplosion(unsigned int seed);         // Generate sound: Explosion
+WaveParams GenPowerup(unsigned int seed);           // Generate sound: Powerup
+WaveParams GenHitHurt(unsigned int seed);           // Generate sound: Hit/Hurt
+WaveParams GenJump(unsigned int seed);              // Generate sound: Jump
+WaveParams GenBlipSelect(unsigned int seed);        // Generate sound: Blip/Select
+WaveParams GenRandomize(unsigned int seed);         // Generate random sound
+void WaveMutate(WaveParams *params, unsigned int seed); // Mutate sound parameters
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RFXGEN_SYNTH_H
+
+/***********************************************************************************
+*
+*   RFXGEN_SYNTH IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(RFXGEN_SYNTH_IMPLEMENTATION)
+
+#include <math.h>                       // Required for: sinf(), powf(), floorf(), tan(), pow(), log10(), sqrt()
+#include <stdlib.h>                     // Required for: calloc(), free()
+#include <string.h>                     // Required for: strcmp(), strrchr()
+#include <stdio.h>                      // Required for: FILE, fopen(), fread(), fwrite(), fclose(), printf()
+
+#if defined(SYNTH_SIMD_AVX)
+    #include <immintrin.h>              // Required for: AVX intrinsics
+#elif defined(SYNTH_SIMD_SSE2)
+    #include <emmintrin.h>              // Required for: SSE2 intrinsics
+#elif defined(SYNTH_SIMD_NEON)
+    #include <arm_neon.h>               // Required for: NEON intrinsics (AArch64, vdivq_f32() required)
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>                 // Required for: _InterlockedCompareExchange() [synth mixer commands queue]
+#endif
+
+#if defined(SYNTH_PROFILE)
+    #if defined(_WIN32)
+        // NOTE: Declared here to avoid windows.h inclusion (conflicts with raylib)
+        __declspec(dllimport) int __stdcall QueryPerformanceCounter(unsigned long long *lpPerformanceCount);
+        __declspec(dllimport) int __stdcall QueryPerformanceFrequency(unsigned long long *lpFrequency);
+    #else
+        #include <time.h>               // Required for: clock_gettime() [synth profile]
+    #endif
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if !defined(PI)
+    #define PI 3.14159265358979323846f  // NOTE: Same value as raylib PI
+#endif
+
+// Force inlining of synth generation functions into every specialized render kernel
+#if defined(_MSC_VER)
+    #define SYNTH_INLINE __forceinline
+#else
+    #define SYNTH_INLINE inline __attribute__((always_inline))
+#endif
+
+// Float random number generation, using provided random state
+#define frnd(rng, range) ((float)GetRandomStateValue(rng, 0, 10000)/10000.0f*(range))
+
+// Per-sample stage profiling: every stage event is counted, one of every SYNTH_PROFILE_INTERVAL events is timed
+// NOTE: Measured time is scaled by interval and timer overhead is subtracted,
+// timing every event would cost more than the stage itself
+#if defined(SYNTH_PROFILE)
+    #define SYNTH_PROFILE_BEGIN(voice, stage) \
+        bool profileTimed##stage = ((voice->profile[stage].count++ & (SYNTH_PROFILE_INTERVAL - 1)) == 0); \
+        double profileStart##stage = profileTimed##stage? GetSynthProfileTime() : 0.0
+    #define SYNTH_PROFILE_END(voice, stage) \
+        if (profileTimed##stage) \
+        { \
+            double profileTime##stage = GetSynthProfileTime() - profileStart##stage - synthProfileOverhead; \
+            if (profileTime##stage > 0.0) voice->profile[stage].time += (unsigned long long)(profileTime##stage*1e9*SYNTH_PROFILE_INTERVAL); \
+        }
+#else
+    #define SYNTH_PROFILE_BEGIN(voice, stage)
+    #define SYNTH_PROFILE_END(voice, stage)
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Wave analyzer: level and loudness accumulators, samples are added one by one during generation
+// NOTE: K-weighted mean square is accumulated per 100 ms sub-block, loudness gating blocks
+// (400 ms, 75% overlap) are built from sub-blocks when analysis ends
+typedef struct SynthAnalyzer {
+    double shelf[5];                // K-weighting high shelf filter coefficients: b0, b1, b2, a1, a2
+    double shelfState[2];           // K-weighting high shelf filter state (transposed direct form II)
+    double highpass[5];             // K-weighting high pass filter coefficients: b0, b1, b2, a1, a2
+    double highpassState[2];        // K-weighting high pass filter state (transposed direct form II)
+    float peak;                     // Peak absolute sample value
+    double sumSquares;              // Samples sum of squares
+    double sumWeighted;             // K-weighted samples sum of squares
+    int sampleCount;                // Samples added
+    int blockLength;                // Sub-block length in samples (100 ms)
+    int blockSamples;               // Samples added to current sub-block
+    double blockSum;                // Current sub-block K-weighted sum of squares
+    double blocks[MAX_WAVE_LENGTH_SECONDS*10 + 1];  // Sub-blocks K-weighted mean square
+    int blockCount;                 // Sub-blocks completed
+    int clippedCount;               // Generated samples clipped, from synth voice
+} SynthAnalyzer;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void ResetSynthVoiceSample(SynthVoice *voice);                   // Reset synth voice sample parameters (frequency, duty and arpeggio)
+static void UpdateSynthVoiceFrequency(SynthVoice *voice, bool repeat);  // Update synth voice frequency for next sample (repeat, arpeggio and slide)
+static void UpdateSynthVoiceSample(SynthVoice *voice, bool vibrato, bool phaser, bool repeat);     // Update synth voice state for next sample (frequency, envelope and sweeps)
+static float GenerateSynthVoiceSample(SynthVoice *voice, int waveType, bool lpf, bool vibrato, bool phaser, bool repeat);    // Generate next voice sample
+static float GenerateSynthVoiceSampleQuality(SynthVoice *voice, int waveType, int quality, bool lpf, bool vibrato, bool phaser, bool repeat);     // Generate next voice sample with reduced subsamples
+static float GenerateSynthVoiceSubsamples(SynthVoice *voice, int waveType, int subsamples, bool lpf, bool phaser);     // Generate and filter reduced subsamples, returns voice sample
+static int GetSynthVoiceSubsamples(SynthVoice *voice, int waveType);    // Get subsamples to generate for next voice sample, depending on quality
+static void GenerateSynthVoiceOscillator(SynthVoice *voice, float *buffer, int waveType, int subsamples, int step);     // Generate base waveform subsamples (SIMD if available, scalar for noise)
+static void GenerateSynthOscillator(SynthVoice *voice, float *buffer, int waveType, int subsamples, int step);    // Generate base waveform subsamples (scalar reference)
+#if defined(SYNTH_SIMD_AVAILABLE)
+static void GenerateSynthOscillatorSimd(SynthVoice *voice, float *buffer, int waveType, int subsamples, int step);     // Generate base waveform subsamples using SIMD (no noise)
+#endif
+static SynthKernel GetSynthKernel(SynthVoice *voice);                   // Get render kernel specialized for voice wave type and features
+static Wave GenerateWaveFloat(WaveParams params, int quality, SynthAnalyzer *analyzer);    // Generate wave as 44100 Hz, 32 bit float, mono samples
+
+static void InitSynthAnalyzer(SynthAnalyzer *analyzer, int sampleRate);  // Init wave analyzer, K-weighting filters computed for sample rate
+static void AddSynthAnalyzerSample(SynthAnalyzer *analyzer, float sample);  // Add output sample to wave analyzer
+static WaveAnalysis GetSynthAnalysis(SynthAnalyzer *analyzer, int sampleRate, int channels);   // Get wave analysis from analyzer accumulators
+
+static RandomState InitRandomState(unsigned int seed);                  // Init random state from seed
+static int GetRandomStateValue(RandomState *rng, int min, int max);     // Get next random value between min and max (both included)
+
+static bool PushSynthMixerCommand(SynthMixer *mixer, SynthMixerCommand command);     // Push command into mixer queue (lock-free, multiple producers)
+static bool PopSynthMixerCommand(SynthMixer *mixer, SynthMixerCommand *command);     // Pop command from mixer queue (single consumer)
+static void ProcessSynthMixerCommand(SynthMixer *mixer, SynthMixerCommand command);  // Process command on mixer thread
+static unsigned int SynthAtomicLoad(volatile unsigned int *value);     // Atomic load (acquire)
+static void SynthAtomicStore(volatile unsigned int *value, unsigned int newValue);   // Atomic store (release)
+static bool SynthAtomicCompareSwap(volatile unsigned int *value, unsigned int expected, unsigned int newValue);   // Atomic compare and swap
+
+#if defined(SYNTH_PROFILE)
+static void AddSynthVoiceProfile(SynthVoice *voice);                    // Add voice per-sample stages counters to profile
+static void SynthAtomicAdd64(volatile unsigned long long *value, unsigned long long addValue);    // Atomic add (relaxed)
+static unsigned long long SynthAtomicLoad64(volatile unsigned long long *value);  // Atomic load (relaxed)
+#endif
+
+static bool IsSynthFileExtension(const char *fileName, const char *ext);   // Check file extension (same as raylib IsFileExtension())
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+#if defined(SYNTH_PROFILE)
+static volatile unsigned long long synthProfileCount[SYNTH_PROFILE_STAGES] = { 0 };  // Profile stages events count
+static volatile unsigned long long synthProfileTime[SYNTH_PROFILE_STAGES] = { 0 };   // Profile stages time (nanoseconds)
+static SynthProfileCallback synthProfileCallback = NULL;    // Profile events callback
+static void *synthProfileUserData = NULL;                   // Profile events callback user data
+static double synthProfileOverhead = 0.0;                   // Profile timer overhead in seconds, measured on profile reset
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------
+// Load/Save wave parameters and wave generation functions
+//--------------------------------------------------------------------------------------------
+
+// Reset wave parameters
+void ResetWaveParams(WaveParams *params)
+{
+    // NOTE: Random seed should be set by caller, it defines generated noise
+    params->randSeed = 0;
+
+    // Wave type
+    params->waveTypeValue = 0;
+
+    // Wave envelope params
+    params->attackTimeValue = 0.0f;
+    params->sustainTimeValue = 0.3f;
+    params->sustainPunchValue = 0.0f;
+    params->decayTimeValue = 0.4f;
+
+    // Frequency params
+    params->startFrequencyValue = 0.3f;
+    params->minFrequencyValue = 0.0f;
+    params->slideValue = 0.0f;
+    params->deltaSlideValue = 0.0f;
+    params->vibratoDepthValue = 0.0f;
+    params->vibratoSpeedValue = 0.0f;
+    //params->vibratoPhaseDelay = 0.0f;
+
+    // Tone change params
+    params->changeAmountValue = 0.0f;
+    params->changeSpeedValue = 0.0f;
+
+    // Square wave params
+    params->squareDutyValue = 0.0f;
+    params->dutySweepValue = 0.0f;
+
+    // Repeat params
+    params->repeatSpeedValue = 0.0f;
+
+    // Phaser params
+    params->phaserOffsetValue = 0.0f;
+    params->phaserSweepValue = 0.0f;
+
+    // Filter params
+    params->lpfCutoffValue = 1.0f;
+    params->lpfCutoffSweepValue = 0.0f;
+    params->lpfResonanceValue = 0.0f;
+    params->hpfCutoffValue = 0.0f;
+    params->hpfCutoffSweepValue = 0.0f;
+}
+
+// Generates new wave from wave parameters
+// NOTE: By default wave is generated as 44100Hz, 32bit float, mono
+Wave GenerateWave(WaveParams params)
+{
+    return GenerateWaveFloat(params, SYNTH_QUALITY_FINAL, NULL);
+}
+
+// Generates new wave from wave parameters in desired format
+Wave GenerateWaveEx(WaveParams params, int sampleRate, int sampleSize, int channels)
+{
+    return GenerateWavePro(params, sampleRate, sampleSize, channels, SYNTH_QUALITY_FINAL);
+}
+
+// Generates new wave from wave parameters in desired format and quality (SynthQuality)
+Wave GenerateWavePro(WaveParams params, int sampleRate, int sampleSize, int channels, int quality)
+{
+    return GenerateWaveAnalyzed(params, sampleRate, sampleSize, channels, quality, NULL);
+}
+
+// Generates new wave from wave parameters in desired format and quality, measuring wave analysis (if provided)
+// NOTE: Samples are rendered in blocks and written directly in desired format (no float wave required),
+// 22050 Hz samples are the average of two generated samples, 8 and 16 bit samples use TPDF dither.
+// Analysis is measured on output samples in the same pass, so exported waves never need to be read again
+Wave GenerateWaveAnalyzed(WaveParams params, int sampleRate, int sampleSize, int channels, int quality, WaveAnalysis *analysis)
+{
+    // Default format is generated directly as float samples
+    if ((sampleRate == WAVE_SAMPLE_RATE) && (sampleSize == 32) && (channels == 1))
+    {
+        SynthAnalyzer *analyzer = (analysis != NULL)? (SynthAnalyzer *)calloc(1, sizeof(SynthAnalyzer)) : NULL;
+        Wave wave = GenerateWaveFloat(params, quality, analyzer);
+
+        if (analysis != NULL) *analysis = GetSynthAnalysis(analyzer, sampleRate, channels);
+        free(analyzer);
+
+        return wave;
+    }
+
+    // Not supported formats are converted after generation (only available with raylib)
+    if (((sampleRate != WAVE_SAMPLE_RATE) && (sampleRate != WAVE_SAMPLE_RATE/2)) ||
+        ((sampleSize != 8) && (sampleSize != 16) && (sampleSize != 32)) || ((channels != 1) && (channels != 2)))
+    {
+        SynthAnalyzer *analyzer = (analysis != NULL)? (SynthAnalyzer *)calloc(1, sizeof(SynthAnalyzer)) : NULL;
+#if defined(RAYLIB_H)
+        // NOTE: Analysis is measured on generated wave (44100 Hz), before format conversion
+        Wave wave = GenerateWaveFloat(params, quality, analyzer);
+    #if defined(SYNTH_PROFILE)
+        double formatTime = GetSynthProfileTime();
+    #endif
+        WaveFormat(&wave, sampleRate, sampleSize, channels);
+    #if defined(SYNTH_PROFILE)
+        AddSynthProfileEvent(SYNTH_PROFILE_FORMAT, formatTime, GetSynthProfileTime() - formatTime, 1);
+    #endif
+        if (analysis != NULL)
+        {
+            *analysis = GetSynthAnalysis(analyzer, WAVE_SAMPLE_RATE, channels);
+            analysis->sampleCount = wave.sampleCount;
+        }
+        free(analyzer);
+
+        return wave;
+#else
+        free(analyzer);
+        if (analysis != NULL) memset(analysis, 0, sizeof(WaveAnalysis));
+
+        return (Wave){ 0 };     // NOTE: Wave conversion requires raylib
+#endif
+    }
+
+    // Supported formats are generated directly in desired format, rendered and converted by blocks
+    WaveStream stream = { 0 };
+    InitWaveStream(&stream, params, sampleRate, sampleSize, channels, quality, (analysis != NULL));
+
+    int frameSize = channels*sampleSize/8;
+    unsigned char *data = (unsigned char *)calloc((stream.frameCount > 0)? stream.frameCount*frameSize : 1, sizeof(unsigned char));
+
+    int frame = ReadWaveStream(&stream, data, stream.frameCount);
+    CloseWaveStream(&stream, analysis);
+
+    Wave wave = { 0 };
+    wave.sampleCount = frame;
+    wave.sampleRate = sampleRate;
+    wave.sampleSize = sampleSize;
+    wave.channels = channels;
+    wave.data = data;
+
+    return wave;
+}
+
+// Generate wave as 44100 Hz, 32 bit float, mono samples, in desired quality
+// NOTE: If analyzer provided, wave is rendered in blocks and every block is analyzed just after rendering
+static Wave GenerateWaveFloat(WaveParams params, int quality, SynthAnalyzer *analyzer)
+{
+#if defined(SYNTH_PROFILE)
+    double resetTime = GetSynthProfileTime();
+#endif
+    SynthVoice voice = { 0 };
+    InitSynthVoiceEx(&voice, params, quality);
+
+    // NOTE: Wave length is known before generation, we reserve exact space for wave samples (up to 10 seconds)
+    // By default we use float size samples, they are converted to desired sample size at the end
+    int sampleCount = GetWaveSampleCount(params);
+    float *buffer = (float *)calloc((sampleCount > 0)? sampleCount : 1, sizeof(float));
+
+#if defined(SYNTH_PROFILE)
+    double synthTime = GetSynthProfileTime();
+    AddSynthProfileEvent(SYNTH_PROFILE_RESET, resetTime, synthTime - resetTime, 1);
+#endif
+
+    if (analyzer != NULL)
+    {
+        InitSynthAnalyzer(analyzer, WAVE_SAMPLE_RATE);
+
+        int rendered = 0;
+
+        while (rendered < sampleCount)
+        {
+            int blockCount = RenderSynthVoice(&voice, buffer + rendered, ((sampleCount - rendered) < SYNTH_BLOCK_FRAMES)? (sampleCount - rendered) : SYNTH_BLOCK_FRAMES);
+            if (blockCount == 0) break;
+
+            for (int i = 0; i < blockCount; i++) AddSynthAnalyzerSample(analyzer, buffer[rendered + i]);
+            rendered += blockCount;
+        }
+
+        sampleCount = rendered;
+        analyzer->clippedCount = voice.clippedCount;
+    }
+    else sampleCount = RenderSynthVoice(&voice, buffer, sampleCount);
+
+#if defined(SYNTH_PROFILE)
+    AddSynthProfileEvent(SYNTH_PROFILE_SYNTH, synthTime, GetSynthProfileTime() - synthTime, sampleCount);
+    AddSynthVoiceProfile(&voice);
+#endif
+
+#if defined(SYNTH_SIMD_VALIDATE)
+    if (voice.simdMaxError > SYNTH_SIMD_TOLERANCE) printf("WARNING: SIMD oscillator difference exceeds tolerance: %f\n", voice.simdMaxError);
+#endif
+
+    Wave genWave;
+    genWave.sampleCount = sampleCount;
+    genWave.sampleRate = WAVE_SAMPLE_RATE; // By default 44100 Hz
+    genWave.sampleSize = 32;               // By default 32 bit float samples
+    genWave.channels = 1;                  // By default 1 channel (mono)
+
+    genWave.data = buffer;
+
+    // NOTE: Wave can be converted to desired format after generation
+
+    return genWave;
+}
+
+// Get wave samples count for parameters (no generation required)
+// NOTE: Wave ends after volume envelope or when frequency goes below min frequency,
+// only frequency is simulated to get exact length, wave is limited to 10 seconds
+int GetWaveSampleCount(WaveParams params)
+{
+    SynthVoice voice = { 0 };
+    InitSynthVoice(&voice, params);
+
+    int maxSampleCount = MAX_WAVE_LENGTH_SECONDS*WAVE_SAMPLE_RATE;
+
+    // Voice finishes when last envelope stage ends, every stage takes its length plus one sample
+    long long envelopeCount = (long long)voice.envelopeLength[0] + voice.envelopeLength[1] + voice.envelopeLength[2] + 3;
+    int sampleCount = (envelopeCount < maxSampleCount)? (int)envelopeCount : maxSampleCount;
+
+    // Min frequency cutoff can only finish voice earlier
+    if (voice.params.minFrequencyValue > 0.0f)
+    {
+        bool repeat = (voice.repeatLimit != 0);
+
+        for (int i = 0; i < sampleCount; i++)
+        {
+            UpdateSynthVoiceFrequency(&voice, repeat);
+
+            if (voice.finished) return (i + 1);
+        }
+    }
+
+    return sampleCount;
+}
+
+// Get wave duration in seconds for parameters (no generation required)
+float GetWaveDuration(WaveParams params)
+{
+    return (float)GetWaveSampleCount(params)/WAVE_SAMPLE_RATE;
+}
+
+// Load .rfx (rFXGen) or .sfs (sfxr) sound parameters file
+WaveParams LoadWaveParams(const char *fileName)
+{
+    return LoadWaveParamsEx(fileName, NULL);
+}
+
+// Load .rfx (rFXGen) or .sfs (sfxr) sound parameters file, retrieving sound volume
+// NOTE: Only .sfs files define sound volume, provided volume is not modified for .rfx files
+WaveParams LoadWaveParamsEx(const char *fileName, float *volume)
+{
+    WaveParams params = { 0 };
+
+    if (IsSynthFileExtension(fileName, ".rfx"))
+    {
+        FILE *rfxFile = fopen(fileName, "rb");
+
+        if (rfxFile != NULL)
+        {
+            // Read .rfx file header
+            unsigned char signature[5];
+            fread(signature, 4, sizeof(unsigned char), rfxFile);
+
+            // Check for valid .rfx file (FormatCC)
+            if ((signature[0] == 'r') &&
+                (signature[1] == 'F') &&
+                (signature[2] == 'X') &&
+                (signature[3] == ' '))
+            {
+                unsigned short version, length;
+                fread(&version, 1, sizeof(unsigned short), rfxFile);
+                fread(&length, 1, sizeof(unsigned short), rfxFile);
+
+                if (version != 200) printf("[%s] rFX file version not supported (%i)\n", fileName, version);
+                else
+                {
+                    if (length != sizeof(WaveParams)) printf("[%s] Wrong rFX wave parameters size\n", fileName);
+                    else fread(&params, 1, sizeof(WaveParams), rfxFile);   // Load wave generation parameters
+                }
+            }
+            else printf("[%s] rFX file does not seem to be valid\n", fileName);
+
+            fclose(rfxFile);
+        }
+    }
+    else if (IsSynthFileExtension(fileName, ".sfs"))
+    {
+        FILE *sfsFile = fopen(fileName, "rb");
+
+        if (sfsFile == NULL) return params;
+
+        // Load .sfs sound parameters
+        int version = 0;
+        fread(&version, 1, sizeof(int), sfsFile);
+
+        if ((version == 100) || (version == 101) || (version == 102))
+        {
+            fread(&params.waveTypeValue, 1, sizeof(int), sfsFile);
+
+            float sfsVolume = 0.5f;
+
+            if (version == 102) fread(&sfsVolume, 1, sizeof(float), sfsFile);
+            if (volume != NULL) *volume = sfsVolume;
+
+            fread(&params.startFrequencyValue, 1, sizeof(float), sfsFile);
+            fread(&params.minFrequencyValue, 1, sizeof(float), sfsFile);
+            fread(&params.slideValue, 1, sizeof(float), sfsFile);
+
+            if (version >= 101) fread(&params.deltaSlideValue, 1, sizeof(float), sfsFile);
+
+            fread(&params.squareDutyValue, 1, sizeof(float), sfsFile);
+            fread(&params.dutySweepValue, 1, sizeof(float), sfsFile);
+
+            fread(&params.vibratoDepthValue, 1, sizeof(float), sfsFile);
+            fread(&params.vibratoSpeedValue, 1, sizeof(float), sfsFile);
+
+            float vibratoPhaseDelay = 0.0f;
+            fread(&vibratoPhaseDelay, 1, sizeof(float), sfsFile); // Not used
+
+            fread(&params.attackTimeValue, 1, sizeof(float), sfsFile);
+            fread(&params.sustainTimeValue, 1, sizeof(float), sfsFile);
+            fread(&params.decayTimeValue, 1, sizeof(float), sfsFile);
+            fread(&params.sustainPunchValue, 1, sizeof(float), sfsFile);
+
+            bool filterOn = false;
+            fread(&filterOn, 1, sizeof(bool), sfsFile); // Not used
+
+            fread(&params.lpfResonanceValue, 1, sizeof(float), sfsFile);
+            fread(&params.lpfCutoffValue, 1, sizeof(float), sfsFile);
+            fread(&params.lpfCutoffSweepValue, 1, sizeof(float), sfsFile);
+            fread(&params.hpfCutoffValue, 1, sizeof(float), sfsFile);
+            fread(&params.hpfCutoffSweepValue, 1, sizeof(float), sfsFile);
+
+            fread(&params.phaserOffsetValue, 1, sizeof(float), sfsFile);
+            fread(&params.phaserSweepValue, 1, sizeof(float), sfsFile);
+            fread(&params.repeatSpeedValue, 1, sizeof(float), sfsFile);
+
+            if (version >= 101)
+            {
+                fread(&params.changeSpeedValue, 1, sizeof(float), sfsFile);
+                fread(&params.changeAmountValue, 1, sizeof(float), sfsFile);
+            }
+        }
+        else printf("[%s] SFS file version not supported\n", fileName);
+
+        fclose(sfsFile);
+    }
+
+    return params;
+}
+
+// Save .rfx sound parameters file
+void SaveWaveParams(WaveParams params, const char *fileName)
+{
+    if (IsSynthFileExtension(fileName, ".rfx"))
+    {
+        // Fx Sound File Structure (.rfx)
+        // ------------------------------------------------------
+        // Offset | Size  | Type       | Description
+        // ------------------------------------------------------
+        // 0      | 4     | char       | Signature: "rFX "
+        // 4      | 2     | short      | Version: 200
+        // 6      | 2     | short      | Data length: 96 bytes
+        // 8      | 96    | WaveParams | Wave parameters
+        // ------------------------------------------------------
+
+        FILE *rfxFile = fopen(fileName, "wb");
+
+        if (rfxFile != NULL)
+        {
+            unsigned char signature[5] = "rFX ";
+            unsigned short version = 200;
+            unsigned short length = sizeof(WaveParams);
+            
+            // Write .rfx file header
+            fwrite(signature, 4, sizeof(unsigned char), rfxFile);
+            fwrite(&version, 1, sizeof(unsigned short), rfxFile);
+            fwrite(&length, 1, sizeof(unsigned short), rfxFile);
+
+            // Write wave generation parameters
+            fwrite(&params, 1, sizeof(WaveParams), rfxFile);
+
+            fclose(rfxFile);
+        }
+    }
+}
+
+#if !defined(RAYLIB_H)
+// Unload wave data
+void UnloadWave(Wave wave)
+{
+    free(wave.data);
+}
+#endif
+
+//--------------------------------------------------------------------------------------------
+// Wave stream functions
+//--------------------------------------------------------------------------------------------
+
+// Init wave stream in desired format (44100 or 22050 Hz, 8, 16 or 32 bit, mono or stereo) and quality
+// NOTE: Wave analyzer is only allocated if analysis is required, voice generation does not allocate
+bool InitWaveStream(WaveStream *stream, WaveParams params, int sampleRate, int sampleSize, int channels, int quality, bool analyze)
+{
+    memset(stream, 0, sizeof(WaveStream));
+
+    if (((sampleRate != WAVE_SAMPLE_RATE) && (sampleRate != WAVE_SAMPLE_RATE/2)) ||
+        ((sampleSize != 8) && (sampleSize != 16) && (sampleSize != 32)) || ((channels != 1) && (channels != 2))) return false;
+
+#if defined(SYNTH_PROFILE)
+    double resetTime = GetSynthProfileTime();
+#endif
+    InitSynthVoiceEx(&stream->voice, params, quality);
+
+    stream->sampleRate = sampleRate;
+    stream->sampleSize = sampleSize;
+    stream->channels = channels;
+
+    int decimation = WAVE_SAMPLE_RATE/sampleRate;       // Generated samples per output frame: 1 (44100 Hz) or 2 (22050 Hz)
+    stream->frameCount = (GetWaveSampleCount(params) + decimation - 1)/decimation;
+
+    // NOTE: Dither uses its own random state, same parameters always generate same wave
+    stream->rng = InitRandomState(params.randSeed ^ 0x5eed);
+
+    if (analyze)
+    {
+        stream->analyzer = (SynthAnalyzer *)calloc(1, sizeof(SynthAnalyzer));
+        InitSynthAnalyzer(stream->analyzer, sampleRate);
+    }
+
+#if defined(SYNTH_PROFILE)
+    // NOTE: Rendering and conversion are interleaved by blocks, their total time is reported as consecutive events on close
+    stream->synthTime = GetSynthProfileTime();
+    AddSynthProfileEvent(SYNTH_PROFILE_RESET, resetTime, stream->synthTime - resetTime, 1);
+#endif
+
+    return true;
+}
+
+// Read next frames in stream format, voice is rendered by blocks as required
+// NOTE: 22050 Hz samples are the average of two generated samples, 8 and 16 bit samples use TPDF dither
+int ReadWaveStream(WaveStream *stream, void *data, int frames)
+{
+#if defined(SYNTH_PROFILE)
+    double readTime = GetSynthProfileTime();
+    double synthDuration = 0.0;
+#endif
+    int decimation = WAVE_SAMPLE_RATE/stream->sampleRate;
+    int channels = stream->channels;
+    int count = 0;
+
+    while ((count < frames) && (stream->frame < stream->frameCount))
+    {
+        // Render next block once current block has been read
+        if (stream->blockPosition >= stream->blockCount)
+        {
+#if defined(SYNTH_PROFILE)
+            double blockTime = GetSynthProfileTime();
+#endif
+            stream->blockCount = RenderSynthVoice(&stream->voice, stream->block, SYNTH_BLOCK_FRAMES);
+            stream->blockPosition = 0;
+#if defined(SYNTH_PROFILE)
+            synthDuration += (GetSynthProfileTime() - blockTime);
+#endif
+            if (stream->blockCount == 0)
+            {
+                stream->frameCount = stream->frame;     // Voice finished before expected wave length
+                break;
+            }
+        }
+
+        // NOTE: Blocks are only incomplete at wave end, so averaged samples never cross blocks
+        int i = stream->blockPosition;
+        float sample = stream->block[i];
+        if ((decimation == 2) && ((i + 1) < stream->blockCount)) sample = (stream->block[i] + stream->block[i + 1])*0.5f;
+        stream->blockPosition += decimation;
+
+        if (stream->analyzer != NULL) AddSynthAnalyzerSample(stream->analyzer, sample);
+
+        // NOTE: All channels get the same sample (and dither), stereo wave sounds same as mono
+        int index = count*channels;
+
+        if (stream->sampleSize == 32)
+        {
+            for (int c = 0; c < channels; c++) ((float *)data)[index + c] = sample;
+        }
+        else
+        {
+            // TPDF dither: difference of two uniform random values, +/-1 LSB
+            float dither = frnd(&stream->rng, 1.0f) - frnd(&stream->rng, 1.0f);
+
+            if (stream->sampleSize == 16)
+            {
+                int value = (int)floorf(sample*32767.0f + dither + 0.5f);
+                if (value > 32767) value = 32767;
+                else if (value < -32768) value = -32768;
+
+                for (int c = 0; c < channels; c++) ((short *)data)[index + c] = (short)value;
+            }
+            else
+            {
+                // NOTE: 8 bit samples are unsigned, centered at 128
+                int value = (int)floorf(sample*127.0f + 128.0f + dither + 0.5f);
+                if (value > 255) value = 255;
+                else if (value < 0) value = 0;
+
+                for (int c = 0; c < channels; c++) ((unsigned char *)data)[index + c] = (unsigned char)value;
+            }
+        }
+
+        count++;
+        stream->frame++;
+    }
+
+#if defined(SYNTH_PROFILE)
+    stream->synthDuration += synthDuration;
+    stream->formatDuration += (GetSynthProfileTime() - readTime - synthDuration);
+#endif
+
+    return count;
+}
+
+// Close wave stream, retrieving wave analysis if stream was analyzed (zeroed otherwise)
+void CloseWaveStream(WaveStream *stream, WaveAnalysis *analysis)
+{
+#if defined(SYNTH_PROFILE)
+    AddSynthProfileEvent(SYNTH_PROFILE_SYNTH, stream->synthTime, stream->synthDuration, stream->voice.framesRendered);
+    AddSynthProfileEvent(SYNTH_PROFILE_FORMAT, stream->synthTime + stream->synthDuration, stream->formatDuration, 1);
+    AddSynthVoiceProfile(&stream->voice);
+#endif
+
+#if defined(SYNTH_SIMD_VALIDATE)
+    if (stream->voice.simdMaxError > SYNTH_SIMD_TOLERANCE) printf("WARNING: SIMD oscillator difference exceeds tolerance: %f\n", stream->voice.simdMaxError);
+#endif
+
+    if (stream->analyzer != NULL)
+    {
+        stream->analyzer->clippedCount = stream->voice.clippedCount;
+        if (analysis != NULL) *analysis = GetSynthAnalysis(stream->analyzer, stream->sampleRate, stream->channels);
+
+        free(stream->analyzer);
+        stream->analyzer = NULL;
+    }
+    else if (analysis != NULL) memset(analysis, 0, sizeof(WaveAnalysis));
+}
+
+//--------------------------------------------------------------------------------------------
+// Wave analysis functions
+//--------------------------------------------------------------------------------------------
+
+// Init wave analyzer, K-weighting filters (ITU-R BS.1770) computed for sample rate
+// NOTE: Filters coefficients are derived from the analog prototype, so they are also valid for 44100 and 22050 Hz
+static void InitSynthAnalyzer(SynthAnalyzer *analyzer, int sampleRate)
+{
+    memset(analyzer, 0, sizeof(SynthAnalyzer));
+
+    // Stage 1: high shelf filter (head acoustic effects), +4 dB above 1.5 kHz
+    double K = tan(PI*1681.974450955533/sampleRate);
+    double Q = 0.7071752369554196;
+    double Vh = pow(10.0, 3.999843853973347/20.0);
+    double Vb = pow(Vh, 0.4996667741545416);
+    double a0 = 1.0 + K/Q + K*K;
+
+    analyzer->shelf[0] = (Vh + Vb*K/Q + K*K)/a0;
+    analyzer->shelf[1] = 2.0*(K*K - Vh)/a0;
+    analyzer->shelf[2] = (Vh - Vb*K/Q + K*K)/a0;
+    analyzer->shelf[3] = 2.0*(K*K - 1.0)/a0;
+    analyzer->shelf[4] = (1.0 - K/Q + K*K)/a0;
+
+    // Stage 2: high pass filter (RLB weighting), 38 Hz cutoff
+    K = tan(PI*38.13547087602444/sampleRate);
+    Q = 0.5003270373238773;
+    a0 = 1.0 + K/Q + K*K;
+
+    analyzer->highpass[0] = 1.0;
+    analyzer->highpass[1] = -2.0;
+    analyzer->highpass[2] = 1.0;
+    analyzer->highpass[3] = 2.0*(K*K - 1.0)/a0;
+    analyzer->highpass[4] = (1.0 - K/Q + K*K)/a0;
+
+    analyzer->blockLength = sampleRate/10;
+}
+
+// Add output sample to wave analyzer: peak, sum of squares and K-weighted sub-block sum of squares
+static SYNTH_INLINE void AddSynthAnalyzerSample(SynthAnalyzer *analyzer, float sample)
+{
+    float value = fabsf(sample);
+    if (value > analyzer->peak) analyzer->peak = value;
+
+    analyzer->sumSquares += (double)sample*sample;
+
+    // K-weighting filters, biquads in transposed direct form II
+    double x = sample;
+    double y = analyzer->shelf[0]*x + analyzer->shelfState[0];
+    analyzer->shelfState[0] = analyzer->shelf[1]*x - analyzer->shelf[3]*y + analyzer->shelfState[1];
+    analyzer->shelfState[1] = analyzer->shelf[2]*x - analyzer->shelf[4]*y;
+
+    x = y;
+    y = analyzer->highpass[0]*x + analyzer->highpassState[0];
+    analyzer->highpassState[0] = analyzer->highpass[1]*x - analyzer->highpass[3]*y + analyzer->highpassState[1];
+    analyzer->highpassState[1] = analyzer->highpass[2]*x - analyzer->highpass[4]*y;
+
+    analyzer->sumWeighted += y*y;
+    analyzer->blockSum += y*y;
+    analyzer->blockSamples++;
+    analyzer->sampleCount++;
+
+    if (analyzer->blockSamples == analyzer->blockLength)
+    {
+        if (analyzer->blockCount < (MAX_WAVE_LENGTH_SECONDS*10 + 1)) analyzer->blocks[analyzer->blockCount++] = analyzer->blockSum/analyzer->blockLength;
+
+        analyzer->blockSum = 0.0;
+        analyzer->blockSamples = 0;
+    }
+}
+
+// Get wave analysis from analyzer accumulators
+// NOTE: Integrated loudness uses 400 ms gating blocks (75% overlap), absolute gate (-70 LUFS) and relative gate (-10 LU),
+// sounds shorter than one gating block are measured as one block. All channels get the same sample, so they are
+// summed with same weight (stereo is 3 dB louder than mono, as defined by ITU-R BS.1770)
+static WaveAnalysis GetSynthAnalysis(SynthAnalyzer *analyzer, int sampleRate, int channels)
+{
+    WaveAnalysis analysis = { 0 };
+
+    analysis.sampleCount = analyzer->sampleCount;
+    analysis.duration = (float)analyzer->sampleCount/sampleRate;
+    analysis.peak = analyzer->peak;
+    analysis.clippedCount = analyzer->clippedCount;
+    analysis.loudness = SYNTH_LOUDNESS_MIN;
+
+    if (analyzer->sampleCount == 0) return analysis;
+
+    analysis.rms = (float)sqrt(analyzer->sumSquares/analyzer->sampleCount);
+
+    double meanSquare = 0.0;
+
+    if (analyzer->blockCount < 4) meanSquare = analyzer->sumWeighted/analyzer->sampleCount;
+    else
+    {
+        int gateCount = analyzer->blockCount - 3;
+        double absoluteGate = pow(10.0, (SYNTH_LOUDNESS_MIN + 0.691)/10.0)/channels;
+        double gatedSum = 0.0;
+        int gatedCount = 0;
+
+        // Absolute gate, used to compute relative gate
+        for (int i = 0; i < gateCount; i++)
+        {
+            double blockMean = (analyzer->blocks[i] + analyzer->blocks[i + 1] + analyzer->blocks[i + 2] + analyzer->blocks[i + 3])/4.0;
+
+            if (blockMean > absoluteGate)
+            {
+                gatedSum += blockMean;
+                gatedCount++;
+            }
+        }
+
+        if (gatedCount > 0)
+        {
+            double relativeGate = gatedSum/gatedCount*0.1;      // -10 LU
+            gatedSum = 0.0;
+            gatedCount = 0;
+
+            for (int i = 0; i < gateCount; i++)
+            {
+                double blockMean = (analyzer->blocks[i] + analyzer->blocks[i + 1] + analyzer->blocks[i + 2] + analyzer->blocks[i + 3])/4.0;
+
+                if ((blockMean > absoluteGate) && (blockMean > relativeGate))
+                {
+                    gatedSum += blockMean;
+                    gatedCount++;
+                }
+            }
+
+            if (gatedCount > 0) meanSquare = gatedSum/gatedCount;
+        }
+    }
+
+    if (meanSquare*channels > 0.0)
+    {
+        analysis.loudness = (float)(-0.691 + 10.0*log10(meanSquare*channels));
+        if (analysis.loudness < SYNTH_LOUDNESS_MIN) analysis.loudness = SYNTH_LOUDNESS_MIN;
+    }
+
+    return analysis;
+}
+
+//--------------------------------------------------------------------------------------------
+// Synth voice functions
+//--------------------------------------------------------------------------------------------
+
+// Init synth voice for streaming generation
+void InitSynthVoice(SynthVoice *voice, WaveParams params)
+{
+    InitSynthVoiceEx(voice, params, SYNTH_QUALITY_FINAL);
+}
+
+// Init synth voice for streaming generation in desired quality (SynthQuality)
+// NOTE: Not supported quality values are generated at final quality
+void InitSynthVoiceEx(SynthVoice *voice, WaveParams params, int quality)
+{
+    memset(voice, 0, sizeof(SynthVoice));
+
+    if ((quality != SYNTH_QUALITY_ADAPTIVE) && (quality != SYNTH_QUALITY_DRAFT) &&
+        (quality != SYNTH_QUALITY_LOW) && (quality != SYNTH_QUALITY_MEDIUM)) quality = SYNTH_QUALITY_FINAL;
+
+    voice->quality = quality;
+
+    // HACK: Security check to avoid crash (why?)
+    if (params.minFrequencyValue > params.startFrequencyValue) params.minFrequencyValue = params.startFrequencyValue;
+    if (params.slideValue < params.deltaSlideValue) params.slideValue = params.deltaSlideValue;
+
+    voice->params = params;
+
+    // NOTE: Noise is generated from a local random state, initialized with wave random seed
+    voice->rng = InitRandomState(params.randSeed);
+
+    // Reset sample parameters
+    ResetSynthVoiceSample(voice);
+
+    voice->arpeggioLimit = (int)(pow(1.0f - params.changeSpeedValue, 2.0f)*20000 + 32);
+
+    if (params.changeSpeedValue == 1.0f) voice->arpeggioLimit = 0;     // WATCH OUT: float comparison
+
+    // Reset filter parameters
+    voice->fltw = pow(params.lpfCutoffValue, 3.0f)*0.1f;
+    voice->fltwd = 1.0f + params.lpfCutoffSweepValue*0.0001f;
+    voice->fltdmp = 5.0f/(1.0f + pow(params.lpfResonanceValue, 2.0f)*20.0f)*(0.01f + voice->fltw);
+    if (voice->fltdmp > 0.8f) voice->fltdmp = 0.8f;
+    voice->flthp = pow(params.hpfCutoffValue, 2.0f)*0.1f;
+    voice->flthpd = 1.0 + params.hpfCutoffSweepValue*0.0003f;
+
+    // Reset vibrato
+    voice->vibratoSpeed = pow(params.vibratoSpeedValue, 2.0f)*0.01f;
+    voice->vibratoAmplitude = params.vibratoDepthValue*0.5f;
+
+    // Reset envelope
+    voice->envelopeLength[0] = (int)(params.attackTimeValue*params.attackTimeValue*100000.0f);
+    voice->envelopeLength[1] = (int)(params.sustainTimeValue*params.sustainTimeValue*100000.0f);
+    voice->envelopeLength[2] = (int)(params.decayTimeValue*params.decayTimeValue*100000.0f);
+
+    voice->fphase = pow(params.phaserOffsetValue, 2.0f)*1020.0f;
+    if (params.phaserOffsetValue < 0.0f) voice->fphase = -voice->fphase;
+
+    voice->fdphase = pow(params.phaserSweepValue, 2.0f)*1.0f;
+    if (params.phaserSweepValue < 0.0f) voice->fdphase = -voice->fdphase;
+
+    voice->iphase = abs((int)voice->fphase);
+
+    for (int i = 0; i < 32; i++) voice->noiseBuffer[i] = frnd(&voice->rng, 2.0f) - 1.0f;
+
+    voice->repeatLimit = (int)(pow(1.0f - params.repeatSpeedValue, 2.0f)*20000 + 32);
+
+    if (params.repeatSpeedValue == 0.0f) voice->repeatLimit = 0;
+
+    // Select render kernel once, generation loop does not check disabled features
+    voice->kernel = GetSynthKernel(voice);
+}
+
+// Render next frames into buffer, returns number of frames rendered
+// NOTE: Less frames than requested are rendered only when voice finishes
+int RenderSynthVoice(SynthVoice *voice, float *buffer, int frames)
+{
+    int count = voice->kernel(voice, buffer, frames);
+
+    voice->framesRendered += count;
+
+    return count;
+}
+
+// Check if synth voice finished generating
+bool IsSynthVoiceFinished(SynthVoice *voice)
+{
+    return voice->finished;
+}
+
+// Reset synth voice sample parameters (frequency, duty and arpeggio)
+// NOTE: Called on voice init and on every repeat
+static void ResetSynthVoiceSample(SynthVoice *voice)
+{
+    WaveParams *params = &voice->params;
+
+    voice->fperiod = 100.0/(params->startFrequencyValue*params->startFrequencyValue + 0.001);
+    voice->period = (int)voice->fperiod;
+    voice->fmaxperiod = 100.0/(params->minFrequencyValue*params->minFrequencyValue + 0.001);
+    voice->fslide = 1.0 - pow((double)params->slideValue, 3.0)*0.01;
+    voice->fdslide = -pow((double)params->deltaSlideValue, 3.0)*0.000001;
+    voice->squareDuty = 0.5f - params->squareDutyValue*0.5f;
+    voice->squareSlide = -params->dutySweepValue*0.00005f;
+
+    if (params->changeAmountValue >= 0.0f) voice->arpeggioModulation = 1.0 - pow((double)params->changeAmountValue, 2.0)*0.9;
+    else voice->arpeggioModulation = 1.0 + pow((double)params->changeAmountValue, 2.0)*10.0;
+}
+
+// Update synth voice frequency for next sample (repeat, arpeggio and slide)
+// NOTE: Voice is finished if frequency goes below min frequency, used also to get wave length
+static SYNTH_INLINE void UpdateSynthVoiceFrequency(SynthVoice *voice, bool repeat)
+{
+    WaveParams *params = &voice->params;
+
+    if (repeat) voice->repeatTime++;
+
+    if (repeat && (voice->repeatTime >= voice->repeatLimit))
+    {
+        // Reset sample parameters (only some of them)
+        voice->repeatTime = 0;
+
+        ResetSynthVoiceSample(voice);
+
+        voice->arpeggioTime = 0;
+        voice->arpeggioLimit = (int)(pow(1.0f - params->changeSpeedValue, 2.0f)*20000 + 32);
+
+        if (params->changeSpeedValue == 1.0f) voice->arpeggioLimit = 0;     // WATCH OUT: float comparison
+    }
+
+    // Frequency envelopes/arpeggios
+    voice->arpeggioTime++;
+
+    if ((voice->arpeggioLimit != 0) && (voice->arpeggioTime >= voice->arpeggioLimit))
+    {
+        voice->arpeggioLimit = 0;
+        voice->fperiod *= voice->arpeggioModulation;
+    }
+
+    voice->fslide += voice->fdslide;
+    voice->fperiod *= voice->fslide;
+
+    if (voice->fperiod > voice->fmaxperiod)
+    {
+        voice->fperiod = voice->fmaxperiod;
+
+        if (params->minFrequencyValue > 0.0f) voice->finished = true;
+    }
+}
+
+// Update synth voice state for next sample: frequency, vibrato, duty, envelope and sweeps
+// NOTE: Voice state is updated once per sample, independently of generated subsamples
+static SYNTH_INLINE void UpdateSynthVoiceSample(SynthVoice *voice, bool vibrato, bool phaser, bool repeat)
+{
+    WaveParams *params = &voice->params;
+
+    UpdateSynthVoiceFrequency(voice, repeat);
+
+    float rfperiod = voice->fperiod;
+
+    if (vibrato)
+    {
+        voice->vibratoPhase += voice->vibratoSpeed;
+        rfperiod = voice->fperiod*(1.0 + sinf(voice->vibratoPhase)*voice->vibratoAmplitude);
+    }
+
+    voice->period = (int)rfperiod;
+
+    if (voice->period < 8) voice->period = 8;
+
+    voice->squareDuty += voice->squareSlide;
+
+    if (voice->squareDuty < 0.0f) voice->squareDuty = 0.0f;
+    if (voice->squareDuty > 0.5f) voice->squareDuty = 0.5f;
+
+    // Volume envelope
+    voice->envelopeTime++;
+
+    if (voice->envelopeTime > voice->envelopeLength[voice->envelopeStage])
+    {
+        voice->envelopeTime = 0;
+        voice->envelopeStage++;
+
+        if (voice->envelopeStage == 3) voice->finished = true;
+    }
+
+    if (voice->envelopeStage == 0) voice->envelopeVolume = (float)voice->envelopeTime/voice->envelopeLength[0];
+    if (voice->envelopeStage == 1) voice->envelopeVolume = 1.0f + pow(1.0f - (float)voice->envelopeTime/voice->envelopeLength[1], 1.0f)*2.0f*params->sustainPunchValue;
+    if (voice->envelopeStage == 2) voice->envelopeVolume = 1.0f - (float)voice->envelopeTime/voice->envelopeLength[2];
+
+    // Phaser step
+    if (phaser)
+    {
+        voice->fphase += voice->fdphase;
+        voice->iphase = abs((int)voice->fphase);
+
+        if (voice->iphase > 1023) voice->iphase = 1023;
+    }
+
+    if (voice->flthpd != 0.0f)     // WATCH OUT!
+    {
+        voice->flthp *= voice->flthpd;
+        if (voice->flthp < 0.00001f) voice->flthp = 0.00001f;
+        if (voice->flthp > 0.1f) voice->flthp = 0.1f;
+    }
+}
+
+// Generate next voice sample using voice parameters
+// NOTE: Wave type and features flags are constants on specialized kernels, disabled features code is removed
+static SYNTH_INLINE float GenerateSynthVoiceSample(SynthVoice *voice, int waveType, bool lpf, bool vibrato, bool phaser, bool repeat)
+{
+    UpdateSynthVoiceSample(voice, vibrato, phaser, repeat);
+
+    float ssample = 0.0f;
+
+    // Generate base waveform subsamples
+    float oscBuffer[MAX_SUPERSAMPLING] = { 0 };
+    GenerateSynthVoiceOscillator(voice, oscBuffer, waveType, MAX_SUPERSAMPLING, 1);
+
+    // Supersampling x8: LP/HP filter
+    SYNTH_PROFILE_BEGIN(voice, SYNTH_PROFILE_FILTER);
+
+    for (int si = 0; si < MAX_SUPERSAMPLING; si++)
+    {
+        float sample = oscBuffer[si];
+
+        // LP filter
+        // NOTE: Filter coefficients are only required while filter is enabled
+        float pp = voice->fltp;
+
+        if (lpf)
+        {
+            voice->fltw *= voice->fltwd;
+
+            if (voice->fltw < 0.0f) voice->fltw = 0.0f;
+            if (voice->fltw > 0.1f) voice->fltw = 0.1f;
+
+            voice->fltdp += (sample - voice->fltp)*voice->fltw;
+            voice->fltdp -= voice->fltdp*voice->fltdmp;
+        }
+        else
+        {
+            voice->fltp = sample;
+            voice->fltdp = 0.0f;
+        }
+
+        voice->fltp += voice->fltdp;
+
+        // HP filter
+        voice->fltphp += voice->fltp - pp;
+        voice->fltphp -= voice->fltphp*voice->flthp;
+        oscBuffer[si] = voice->fltphp;
+    }
+
+    SYNTH_PROFILE_END(voice, SYNTH_PROFILE_FILTER);
+
+    // Phaser
+    // NOTE: Without phaser offset and sweep, phase is 0 and delayed sample is current sample
+    if (phaser)
+    {
+        SYNTH_PROFILE_BEGIN(voice, SYNTH_PROFILE_PHASER);
+
+        for (int si = 0; si < MAX_SUPERSAMPLING; si++)
+        {
+            voice->phaserBuffer[voice->ipp & 1023] = oscBuffer[si];
+            oscBuffer[si] += voice->phaserBuffer[(voice->ipp - voice->iphase + 1024) & 1023];
+            voice->ipp = (voice->ipp + 1) & 1023;
+        }
+
+        SYNTH_PROFILE_END(voice, SYNTH_PROFILE_PHASER);
+    }
+    else
+    {
+        for (int si = 0; si < MAX_SUPERSAMPLING; si++) oscBuffer[si] += oscBuffer[si];
+    }
+
+    // Final accumulation and envelope application
+    for (int si = 0; si < MAX_SUPERSAMPLING; si++) ssample += oscBuffer[si]*voice->envelopeVolume;
+
+    ssample = (ssample/MAX_SUPERSAMPLING)*SAMPLE_SCALE_COEFICIENT;
+
+    // Clamp sample to [-1..1]
+    if (ssample > 1.0f)
+    {
+        ssample = 1.0f;
+        voice->clippedCount++;
+    }
+    if (ssample < -1.0f)
+    {
+        ssample = -1.0f;
+        voice->clippedCount++;
+    }
+
+    return ssample;
+}
+
+// Generate next voice sample with reduced subsamples (quality below final or adaptive)
+// NOTE: Quality is a constant on specialized kernels, adaptive quality selects subsamples per sample
+// and every subsamples count gets its own specialized code
+static SYNTH_INLINE float GenerateSynthVoiceSampleQuality(SynthVoice *voice, int waveType, int quality, bool lpf, bool vibrato, bool phaser, bool repeat)
+{
+    UpdateSynthVoiceSample(voice, vibrato, phaser, repeat);
+
+    int subsamples = (quality == SYNTH_QUALITY_ADAPTIVE)? GetSynthVoiceSubsamples(voice, waveType) : quality;
+
+    switch (subsamples)
+    {
+        case 1: return GenerateSynthVoiceSubsamples(voice, waveType, 1, lpf, phaser);
+        case 2: return GenerateSynthVoiceSubsamples(voice, waveType, 2, lpf, phaser);
+        case 4: return GenerateSynthVoiceSubsamples(voice, waveType, 4, lpf, phaser);
+        default: return GenerateSynthVoiceSubsamples(voice, waveType, MAX_SUPERSAMPLING, lpf, phaser);
+    }
+}
+
+// Generate and filter reduced subsamples for voice sample, voice state must be already updated
+// NOTE: Every subsample covers several final quality subsamples (step), filters coefficients
+// are scaled to get a similar response at lower rate and phaser delay is converted to subsamples
+static SYNTH_INLINE float GenerateSynthVoiceSubsamples(SynthVoice *voice, int waveType, int subsamples, bool lpf, bool phaser)
+{
+    int step = MAX_SUPERSAMPLING/subsamples;
+
+    float oscBuffer[MAX_SUPERSAMPLING] = { 0 };
+    GenerateSynthVoiceOscillator(voice, oscBuffer, waveType, subsamples, step);
+
+    // Filters coefficients for step subsamples: sweep and damping are applied step times,
+    // LP filter resonator frequency is scaled by step (coefficient by step squared, limited for stability)
+    float fltwdStep = voice->fltwd;
+    float fltdmpKeep = 1.0f - voice->fltdmp;
+    float flthpKeep = 1.0f - voice->flthp;
+
+    for (int i = 1; i < step; i *= 2)
+    {
+        fltwdStep *= fltwdStep;
+        fltdmpKeep *= fltdmpKeep;
+        flthpKeep *= flthpKeep;
+    }
+
+    // LP/HP filter
+    SYNTH_PROFILE_BEGIN(voice, SYNTH_PROFILE_FILTER);
+
+    for (int si = 0; si < subsamples; si++)
+    {
+        float sample = oscBuffer[si];
+        float pp = voice->fltp;
+
+        if (lpf)
+        {
+            voice->fltw *= fltwdStep;
+
+            if (voice->fltw < 0.0f) voice->fltw = 0.0f;
+            if (voice->fltw > 0.1f) voice->fltw = 0.1f;
+
+            float fltw = voice->fltw*step*step;
+            if (fltw > 1.0f) fltw = 1.0f;
+
+            voice->fltdp += (sample - voice->fltp)*fltw;
+            voice->fltdp -= voice->fltdp*(1.0f - fltdmpKeep);
+        }
+        else
+        {
+            voice->fltp = sample;
+            voice->fltdp = 0.0f;
+        }
+
+        voice->fltp += voice->fltdp;
+
+        voice->fltphp += voice->fltp - pp;
+        voice->fltphp -= voice->fltphp*(1.0f - flthpKeep);
+        oscBuffer[si] = voice->fltphp;
+    }
+
+    SYNTH_PROFILE_END(voice, SYNTH_PROFILE_FILTER);
+
+    // Phaser
+    if (phaser)
+    {
+        SYNTH_PROFILE_BEGIN(voice, SYNTH_PROFILE_PHASER);
+
+        // NOTE: Delay is not a whole number of subsamples, delayed sample is interpolated
+        int delay = voice->iphase/step;
+        float delayFraction = (float)(voice->iphase - delay*step)/step;
+
+        for (int si = 0; si < subsamples; si++)
+        {
+            voice->phaserBuffer[voice->ipp & 1023] = oscBuffer[si];
+            oscBuffer[si] += voice->phaserBuffer[(voice->ipp - delay + 1024) & 1023]*(1.0f - delayFraction) +
+                             voice->phaserBuffer[(voice->ipp - delay - 1 + 1024) & 1023]*delayFraction;
+            voice->ipp = (voice->ipp + 1) & 1023;
+        }
+
+        SYNTH_PROFILE_END(voice, SYNTH_PROFILE_PHASER);
+    }
+    else
+    {
+        for (int si = 0; si < subsamples; si++) oscBuffer[si] += oscBuffer[si];
+    }
+
+    float ssample = 0.0f;
+    for (int si = 0; si < subsamples; si++) ssample += oscBuffer[si]*voice->envelopeVolume;
+
+    ssample = (ssample/subsamples)*SAMPLE_SCALE_COEFICIENT;
+
+    // Clamp sample to [-1..1]
+    if (ssample > 1.0f)
+    {
+        ssample = 1.0f;
+        voice->clippedCount++;
+    }
+    if (ssample < -1.0f)
+    {
+        ssample = -1.0f;
+        voice->clippedCount++;
+    }
+
+    return ssample;
+}
+
+// Get subsamples to generate for next voice sample, depending on voice quality
+// NOTE: On adaptive quality, subsamples are doubled while a wave cycle gets less than SYNTH_ADAPTIVE_CYCLE
+// subsamples (harmonics above Nyquist would be audible as aliasing), sine wave only requires SYNTH_ADAPTIVE_SINE_CYCLE,
+// square wave narrow pulses are measured by pulse width instead of period
+static SYNTH_INLINE int GetSynthVoiceSubsamples(SynthVoice *voice, int waveType)
+{
+    if (voice->quality != SYNTH_QUALITY_ADAPTIVE) return voice->quality;
+
+    // NOTE: Voice period is measured in final quality subsamples
+    int cycle = (waveType == 2)? SYNTH_ADAPTIVE_SINE_CYCLE : SYNTH_ADAPTIVE_CYCLE;
+    float width = (waveType == 0)? voice->period*voice->squareDuty*2.0f : (float)voice->period;
+    int subsamples = 1;
+
+    while ((subsamples < MAX_SUPERSAMPLING) && (width*subsamples < cycle*MAX_SUPERSAMPLING)) subsamples *= 2;
+
+    return subsamples;
+}
+
+// Generate base waveform subsamples, SIMD oscillator is used when available
+// NOTE: Noise wave is always generated by scalar oscillator, noise buffer is refreshed on every period
+static SYNTH_INLINE void GenerateSynthVoiceOscillator(SynthVoice *voice, float *buffer, int waveType, int subsamples, int step)
+{
+#if defined(SYNTH_SIMD_AVAILABLE)
+    if (waveType != 3)
+    {
+    #if defined(SYNTH_SIMD_VALIDATE)
+        int prevPhase = voice->phase;
+        float refBuffer[MAX_SUPERSAMPLING] = { 0 };
+        GenerateSynthOscillator(voice, refBuffer, waveType, subsamples, step);
+
+        int refPhase = voice->phase;
+        voice->phase = prevPhase;
+    #endif
+        GenerateSynthOscillatorSimd(voice, buffer, waveType, subsamples, step);
+
+    #if defined(SYNTH_SIMD_VALIDATE)
+        if (voice->phase != refPhase) voice->simdMaxError = 1.0f;   // Phase tracking should be exact
+
+        for (int si = 0; si < subsamples; si++)
+        {
+            float error = fabsf(buffer[si] - refBuffer[si]);
+            if (error > voice->simdMaxError) voice->simdMaxError = error;
+        }
+    #endif
+    }
+    else GenerateSynthOscillator(voice, buffer, waveType, subsamples, step);
+#else
+    GenerateSynthOscillator(voice, buffer, waveType, subsamples, step);
+#endif
+}
+
+// Generate base waveform subsamples (scalar reference)
+// NOTE: Voice phase is advanced by step for every subsample, MAX_SUPERSAMPLING steps per sample
+static SYNTH_INLINE void GenerateSynthOscillator(SynthVoice *voice, float *buffer, int waveType, int subsamples, int step)
+{
+    for (int si = 0; si < subsamples; si++)
+    {
+        float sample = 0.0f;
+        voice->phase += step;
+
+        if (voice->phase >= voice->period)
+        {
+            //phase = 0;
+            voice->phase %= voice->period;
+
+            if (waveType == 3)
+            {
+                SYNTH_PROFILE_BEGIN(voice, SYNTH_PROFILE_NOISE);
+                for (int i = 0; i < 32; i++) voice->noiseBuffer[i] = frnd(&voice->rng, 2.0f) - 1.0f;
+                SYNTH_PROFILE_END(voice, SYNTH_PROFILE_NOISE);
+            }
+        }
+
+        // base waveform
+        float fp = (float)voice->phase/voice->period;
+
+        switch (waveType)
+        {
+            case 0: // Square wave
+            {
+                if (fp < voice->squareDuty) sample = 0.5f;
+                else sample = -0.5f;
+
+            } break;
+            case 1: sample = 1.0f - fp*2; break;    // Sawtooth wave
+            case 2: sample = sinf(fp*2*PI); break;  // Sine wave
+            case 3: sample = voice->noiseBuffer[voice->phase*32/voice->period]; break; // Noise wave
+            default: break;
+        }
+
+        buffer[si] = sample;
+    }
+}
+
+#if defined(SYNTH_SIMD_AVAILABLE)
+// SIMD helper functions, SIMD_WIDTH floats per vector
+#if defined(SYNTH_SIMD_AVX)
+    #define SIMD_WIDTH  8
+    typedef __m256 SimdFloat;
+
+    static inline SimdFloat SimdSet(float value) { return _mm256_set1_ps(value); }
+    static inline SimdFloat SimdLoad(const float *values) { return _mm256_loadu_ps(values); }
+    static inline void SimdStore(float *values, SimdFloat v) { _mm256_storeu_ps(values, v); }
+    static inline SimdFloat SimdAdd(SimdFloat a, SimdFloat b) { return _mm256_add_ps(a, b); }
+    static inline SimdFloat SimdSub(SimdFloat a, SimdFloat b) { return _mm256_sub_ps(a, b); }
+    static inline SimdFloat SimdMul(SimdFloat a, SimdFloat b) { return _mm256_mul_ps(a, b); }
+    static inline SimdFloat SimdDiv(SimdFloat a, SimdFloat b) { return _mm256_div_ps(a, b); }
+    static inline SimdFloat SimdMin(SimdFloat a, SimdFloat b) { return _mm256_min_ps(a, b); }
+    static inline SimdFloat SimdMax(SimdFloat a, SimdFloat b) { return _mm256_max_ps(a, b); }
+    static inline SimdFloat SimdSelectLess(SimdFloat a, SimdFloat b, SimdFloat x, SimdFloat y) { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+#elif defined(SYNTH_SIMD_SSE2)
+    #define SIMD_WIDTH  4
+    typedef __m128 SimdFloat;
+
+    static inline SimdFloat SimdSet(float value) { return _mm_set1_ps(value); }
+    static inline SimdFloat SimdLoad(const float *values) { return _mm_loadu_ps(values); }
+    static inline void SimdStore(float *values, SimdFloat v) { _mm_storeu_ps(values, v); }
+    static inline SimdFloat SimdAdd(SimdFloat a, SimdFloat b) { return _mm_add_ps(a, b); }
+    static inline SimdFloat SimdSub(SimdFloat a, SimdFloat b) { return _mm_sub_ps(a, b); }
+    static inline SimdFloat SimdMul(SimdFloat a, SimdFloat b) { return _mm_mul_ps(a, b); }
+    static inline SimdFloat SimdDiv(SimdFloat a, SimdFloat b) { return _mm_div_ps(a, b); }
+    static inline SimdFloat SimdMin(SimdFloat a, SimdFloat b) { return _mm_min_ps(a, b); }
+    static inline SimdFloat SimdMax(SimdFloat a, SimdFloat b) { return _mm_max_ps(a, b); }
+    static inline SimdFloat SimdSelectLess(SimdFloat a, SimdFloat b, SimdFloat x, SimdFloat y)
+    {
+        SimdFloat mask = _mm_cmplt_ps(a, b);
+        return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, y));
+    }
+#elif defined(SYNTH_SIMD_NEON)
+    #define SIMD_WIDTH  4
+    typedef float32x4_t SimdFloat;
+
+    static inline SimdFloat SimdSet(float value) { return vdupq_n_f32(value); }
+    static inline SimdFloat SimdLoad(const float *values) { return vld1q_f32(values); }
+    static inline void SimdStore(float *values, SimdFloat v) { vst1q_f32(values, v); }
+    static inline SimdFloat SimdAdd(SimdFloat a, SimdFloat b) { return vaddq_f32(a, b); }
+    static inline SimdFloat SimdSub(SimdFloat a, SimdFloat b) { return vsubq_f32(a, b); }
+    static inline SimdFloat SimdMul(SimdFloat a, SimdFloat b) { return vmulq_f32(a, b); }
+    static inline SimdFloat SimdDiv(SimdFloat a, SimdFloat b) { return vdivq_f32(a, b); }
+    static inline SimdFloat SimdMin(SimdFloat a, SimdFloat b) { return vminq_f32(a, b); }
+    static inline SimdFloat SimdMax(SimdFloat a, SimdFloat b) { return vmaxq_f32(a, b); }
+    static inline SimdFloat SimdSelectLess(SimdFloat a, SimdFloat b, SimdFloat x, SimdFloat y) { return vbslq_f32(vcltq_f32(a, b), x, y); }
+#endif
+
+// Fast sine approximation for sin(2*PI*x), x in range [0..1)
+// NOTE: Argument is reflected to [-PI/2..PI/2] and evaluated with a degree 9 polynomial,
+// max error is about 4e-6, no branches required
+static inline SimdFloat SimdSinCycle(SimdFloat x)
+{
+    SimdFloat t = SimdSub(x, SimdSet(0.5f));                  // sin(2*PI*x) = -sin(2*PI*t), t in [-0.5..0.5)
+    t = SimdMin(t, SimdSub(SimdSet(0.5f), t));
+    t = SimdMax(t, SimdSub(SimdSet(-0.5f), t));             // t in [-0.25..0.25]
+
+    SimdFloat a = SimdMul(t, SimdSet(2*PI));
+    SimdFloat a2 = SimdMul(a, a);
+
+    SimdFloat poly = SimdSet(1.0f/362880.0f);
+    poly = SimdAdd(SimdMul(poly, a2), SimdSet(-1.0f/5040.0f));
+    poly = SimdAdd(SimdMul(poly, a2), SimdSet(1.0f/120.0f));
+    poly = SimdAdd(SimdMul(poly, a2), SimdSet(-1.0f/6.0f));
+    poly = SimdAdd(SimdMul(poly, a2), SimdSet(1.0f));
+
+    return SimdMul(SimdMul(a, poly), SimdSet(-1.0f));
+}
+
+// Generate base waveform subsamples using SIMD (square, sawtooth and sine waves)
+// NOTE: Period is at least 8 subsamples and one sample advances phase by MAX_SUPERSAMPLING, so phase wraps
+// at most once after first subsample. Buffer must fit MAX_SUPERSAMPLING values, unused lanes are also stored
+static SYNTH_INLINE void GenerateSynthOscillatorSimd(SynthVoice *voice, float *buffer, int waveType, int subsamples, int step)
+{
+    static const float subsampleOffsets[MAX_SUPERSAMPLING] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+
+    int period = voice->period;
+    int phase = voice->phase + step;
+
+    if (phase >= period) phase %= period;
+
+    // Phase for last subsample, required for next sample
+    voice->phase = phase + (subsamples - 1)*step;
+    if (voice->phase >= period) voice->phase -= period;
+
+    SimdFloat vperiod = SimdSet((float)period);
+    SimdFloat vphase = SimdSet((float)phase);
+    SimdFloat vstep = SimdSet((float)step);
+
+    for (int si = 0; si < subsamples; si += SIMD_WIDTH)
+    {
+        // Subsamples phase, wrapped to period
+        SimdFloat p = SimdAdd(vphase, SimdMul(SimdLoad(subsampleOffsets + si), vstep));
+        p = SimdSub(p, SimdSelectLess(p, vperiod, SimdSet(0.0f), vperiod));
+
+        SimdFloat fp = SimdDiv(p, vperiod);
+        SimdFloat sample = SimdSet(0.0f);
+
+        switch (waveType)
+        {
+            case 0: sample = SimdSelectLess(fp, SimdSet(voice->squareDuty), SimdSet(0.5f), SimdSet(-0.5f)); break;  // Square wave
+            case 1: sample = SimdSub(SimdSet(1.0f), SimdMul(fp, SimdSet(2.0f))); break;     // Sawtooth wave
+            case 2: sample = SimdSinCycle(fp); break;                                       // Sine wave
+            default: break;
+        }
+
+        SimdStore(buffer + si, sample);
+    }
+}
+#endif      // SYNTH_SIMD_AVAILABLE
+
+// Render frames into buffer until voice finishes (render kernel template)
+// NOTE: Final quality uses reference sample generation, reduced qualities use scaled filters
+static SYNTH_INLINE int RenderSynthVoiceBlock(SynthVoice *voice, float *buffer, int frames, int quality, int waveType, bool lpf, bool vibrato, bool phaser, bool repeat)
+{
+    int count = 0;
+
+    while ((count < frames) && !voice->finished)
+    {
+        if (quality == SYNTH_QUALITY_FINAL) buffer[count] = GenerateSynthVoiceSample(voice, waveType, lpf, vibrato, phaser, repeat);
+        else buffer[count] = GenerateSynthVoiceSampleQuality(voice, waveType, quality, lpf, vibrato, phaser, repeat);
+        count++;
+    }
+
+    return count;
+}
+
+// Render kernels specialized for every quality (adaptive, draft, low, medium, final),
+// wave type (0..3) and features combination: LP filter, vibrato, phaser and repeat enabled (1) or disabled (0)
+#define SYNTH_KERNEL(q, w, l, v, p, r) RenderSynthKernel##q##_##w##l##v##p##r
+#define SYNTH_KERNEL_DEFINE(q, w, l, v, p, r) \
+    static int SYNTH_KERNEL(q, w, l, v, p, r)(SynthVoice *voice, float *buffer, int frames) { return RenderSynthVoiceBlock(voice, buffer, frames, q, w, l, v, p, r); }
+
+#define SYNTH_KERNELS_DEFINE_R(q, w, l, v, p) SYNTH_KERNEL_DEFINE(q, w, l, v, p, 0) SYNTH_KERNEL_DEFINE(q, w, l, v, p, 1)
+#define SYNTH_KERNELS_DEFINE_P(q, w, l, v) SYNTH_KERNELS_DEFINE_R(q, w, l, v, 0) SYNTH_KERNELS_DEFINE_R(q, w, l, v, 1)
+#define SYNTH_KERNELS_DEFINE_V(q, w, l) SYNTH_KERNELS_DEFINE_P(q, w, l, 0) SYNTH_KERNELS_DEFINE_P(q, w, l, 1)
+#define SYNTH_KERNELS_DEFINE_L(q, w) SYNTH_KERNELS_DEFINE_V(q, w, 0) SYNTH_KERNELS_DEFINE_V(q, w, 1)
+#define SYNTH_KERNELS_DEFINE_W(q) SYNTH_KERNELS_DEFINE_L(q, 0) SYNTH_KERNELS_DEFINE_L(q, 1) SYNTH_KERNELS_DEFINE_L(q, 2) SYNTH_KERNELS_DEFINE_L(q, 3)
+
+SYNTH_KERNELS_DEFINE_W(0)
+SYNTH_KERNELS_DEFINE_W(1)
+SYNTH_KERNELS_DEFINE_W(2)
+SYNTH_KERNELS_DEFINE_W(4)
+SYNTH_KERNELS_DEFINE_W(8)
+
+#define SYNTH_KERNELS_R(q, w, l, v, p) { SYNTH_KERNEL(q, w, l, v, p, 0), SYNTH_KERNEL(q, w, l, v, p, 1) }
+#define SYNTH_KERNELS_P(q, w, l, v) { SYNTH_KERNELS_R(q, w, l, v, 0), SYNTH_KERNELS_R(q, w, l, v, 1) }
+#define SYNTH_KERNELS_V(q, w, l) { SYNTH_KERNELS_P(q, w, l, 0), SYNTH_KERNELS_P(q, w, l, 1) }
+#define SYNTH_KERNELS_L(q, w) { SYNTH_KERNELS_V(q, w, 0), SYNTH_KERNELS_V(q, w, 1) }
+#define SYNTH_KERNELS_W(q) { SYNTH_KERNELS_L(q, 0), SYNTH_KERNELS_L(q, 1), SYNTH_KERNELS_L(q, 2), SYNTH_KERNELS_L(q, 3) }
+
+// Render kernels table: [quality][waveType][lpf][vibrato][phaser][repeat]
+// NOTE: Quality index: 0-Adaptive, 1-Draft, 2-Low, 3-Medium, 4-Final
+static const SynthKernel synthKernels[5][4][2][2][2][2] = {
+    SYNTH_KERNELS_W(0), SYNTH_KERNELS_W(1), SYNTH_KERNELS_W(2), SYNTH_KERNELS_W(4), SYNTH_KERNELS_W(8)
+};
+
+// Render kernel for invalid wave types, quality and features are checked at runtime
+static int RenderSynthKernelGeneric(SynthVoice *voice, float *buffer, int frames)
+{
+    return RenderSynthVoiceBlock(voice, buffer, frames, voice->quality, voice->params.waveTypeValue,
+                                 (voice->params.lpfCutoffValue != 1.0f), (voice->vibratoAmplitude > 0.0f),
+                                 ((voice->fphase != 0.0f) || (voice->fdphase != 0.0f)), (voice->repeatLimit != 0));
+}
+
+// Get render kernel specialized for voice wave type and features
+// NOTE: Voice must be initialized, features are enabled depending on voice state
+static SynthKernel GetSynthKernel(SynthVoice *voice)
+{
+    int waveType = voice->params.waveTypeValue;
+
+    if ((waveType < 0) || (waveType > 3)) return RenderSynthKernelGeneric;
+
+    // NOTE: Voice quality is already normalized: 0, 1, 2, 4 or 8 subsamples
+    int quality = 0;
+    switch (voice->quality)
+    {
+        case SYNTH_QUALITY_DRAFT: quality = 1; break;
+        case SYNTH_QUALITY_LOW: quality = 2; break;
+        case SYNTH_QUALITY_MEDIUM: quality = 3; break;
+        case SYNTH_QUALITY_FINAL: quality = 4; break;
+        default: break;
+    }
+
+    bool lpf = (voice->params.lpfCutoffValue != 1.0f);     // WATCH OUT: float comparison
+    bool vibrato = (voice->vibratoAmplitude > 0.0f);
+    bool phaser = ((voice->fphase != 0.0f) || (voice->fdphase != 0.0f));
+    bool repeat = (voice->repeatLimit != 0);
+
+    return synthKernels[quality][waveType][lpf][vibrato][phaser][repeat];
+}
+
+//--------------------------------------------------------------------------------------------
+// Synth mixer functions
+//--------------------------------------------------------------------------------------------
+
+// Init synth mixer, voices pool and commands queue are allocated in one block
+// NOTE: No more memory is allocated by mixer after init
+bool InitSynthMixer(SynthMixer *mixer, int voiceCapacity, int queueCapacity)
+{
+    memset(mixer, 0, sizeof(SynthMixer));
+
+    if (voiceCapacity <= 0) voiceCapacity = SYNTH_MIXER_MAX_VOICES;
+    if (queueCapacity <= 0) queueCapacity = SYNTH_MIXER_QUEUE_SIZE;
+
+    unsigned int queueSize = 2;
+    while (queueSize < (unsigned int)queueCapacity) queueSize *= 2;
+
+    mixer->arena = calloc(1, voiceCapacity*sizeof(SynthMixerVoice) + queueSize*sizeof(SynthMixerCell));
+    if (mixer->arena == NULL) return false;
+
+    mixer->voices = (SynthMixerVoice *)mixer->arena;
+    mixer->voiceCapacity = voiceCapacity;
+    mixer->queue = (SynthMixerCell *)(mixer->voices + voiceCapacity);
+    mixer->queueMask = queueSize - 1;
+
+    // Cell sequence equals write position when cell is free
+    for (unsigned int i = 0; i < queueSize; i++) mixer->queue[i].sequence = i;
+
+    return true;
+}
+
+// Close synth mixer, free allocated memory
+void CloseSynthMixer(SynthMixer *mixer)
+{
+    free(mixer->arena);
+    memset(mixer, 0, sizeof(SynthMixer));
+}
+
+// Start voice on mixer with wave parameters and gain, it can be called from any thread
+// NOTE: Voice starts on next mixer render, returns voice id (0 if commands queue is full)
+unsigned int PlaySynthMixerVoice(SynthMixer *mixer, WaveParams params, float gain)
+{
+    SynthMixerCommand command = { 0 };
+    command.type = SYNTH_MIXER_PLAY;
+    command.gain = gain;
+    command.params = params;
+
+    // Get new voice id (0 is reserved for free voices)
+    do
+    {
+        command.voiceId = SynthAtomicLoad(&mixer->nextVoiceId);
+    } while (!SynthAtomicCompareSwap(&mixer->nextVoiceId, command.voiceId, command.voiceId + 1) || ((command.voiceId + 1) == 0));
+
+    command.voiceId++;
+
+    return PushSynthMixerCommand(mixer, command)? command.voiceId : 0;
+}
+
+// Stop voice on mixer, it can be called from any thread
+bool StopSynthMixerVoice(SynthMixer *mixer, unsigned int voiceId)
+{
+    SynthMixerCommand command = { 0 };
+    command.type = SYNTH_MIXER_STOP;
+    command.voiceId = voiceId;
+
+    return PushSynthMixerCommand(mixer, command);
+}
+
+// Stop all voices on mixer, it can be called from any thread
+bool StopSynthMixerVoices(SynthMixer *mixer)
+{
+    SynthMixerCommand command = { 0 };
+    command.type = SYNTH_MIXER_STOP_ALL;
+
+    return PushSynthMixerCommand(mixer, command);
+}
+
+// Render all voices mixed into buffer (mono, 32 bit float, WAVE_SAMPLE_RATE), returns voices playing
+// NOTE: Only one thread can render mixer, pending commands are processed first
+int RenderSynthMixer(SynthMixer *mixer, float *buffer, int frames)
+{
+    SynthMixerCommand command = { 0 };
+
+    // NOTE: Commands processed are limited to queue capacity, render time is bounded
+    for (unsigned int i = 0; (i <= mixer->queueMask) && PopSynthMixerCommand(mixer, &command); i++) ProcessSynthMixerCommand(mixer, command);
+
+    memset(buffer, 0, frames*sizeof(float));
+
+    for (int v = 0; (v < mixer->voiceCapacity) && (mixer->activeCount > 0); v++)
+    {
+        SynthMixerVoice *voice = &mixer->voices[v];
+
+        if (voice->id == 0) continue;
+
+        for (int frame = 0; frame < frames; )
+        {
+            int blockFrames = ((frames - frame) < SYNTH_BLOCK_FRAMES)? (frames - frame) : SYNTH_BLOCK_FRAMES;
+            int count = RenderSynthVoice(&voice->voice, mixer->block, blockFrames);
+
+            for (int i = 0; i < count; i++) buffer[frame + i] += mixer->block[i]*voice->gain;
+
+            frame += count;
+
+            // Voice finished, it is available for new voices
+            if (count < blockFrames)
+            {
+                voice->id = 0;
+                mixer->activeCount--;
+                break;
+            }
+        }
+    }
+
+    return mixer->activeCount;
+}
+
+// Push command into mixer queue, multiple producers supported (lock-free)
+// NOTE: Bounded queue with cells sequence numbers, a cell is written after its position is reserved
+static bool PushSynthMixerCommand(SynthMixer *mixer, SynthMixerCommand command)
+{
+    SynthMixerCell *cell = NULL;
+    unsigned int position = SynthAtomicLoad(&mixer->queueTail);
+
+    while (true)
+    {
+        cell = &mixer->queue[position & mixer->queueMask];
+        int diff = (int)(SynthAtomicLoad(&cell->sequence) - position);
+
+        if (diff == 0)
+        {
+            // Cell is free, try to reserve position
+            if (SynthAtomicCompareSwap(&mixer->queueTail, position, position + 1)) break;
+            position = SynthAtomicLoad(&mixer->queueTail);
+        }
+        else if (diff < 0) return false;    // Queue is full
+        else position = SynthAtomicLoad(&mixer->queueTail);
+    }
+
+    cell->command = command;
+    SynthAtomicStore(&cell->sequence, position + 1);    // Cell ready to be read
+
+    return true;
+}
+
+// Pop command from mixer queue, only mixer thread can pop commands
+static bool PopSynthMixerCommand(SynthMixer *mixer, SynthMixerCommand *command)
+{
+    SynthMixerCell *cell = &mixer->queue[mixer->queueHead & mixer->queueMask];
+
+    if (SynthAtomicLoad(&cell->sequence) != (mixer->queueHead + 1)) return false;   // Queue is empty (or cell being written)
+
+    *command = cell->command;
+    SynthAtomicStore(&cell->sequence, mixer->queueHead + mixer->queueMask + 1);     // Cell free for next queue cycle
+    mixer->queueHead++;
+
+    return true;
+}
+
+// Process command on mixer thread
+// NOTE: If voices pool is full, oldest voice is stolen for new voice
+static void ProcessSynthMixerCommand(SynthMixer *mixer, SynthMixerCommand command)
+{
+    if (command.type == SYNTH_MIXER_PLAY)
+    {
+        SynthMixerVoice *voice = NULL;
+
+        for (int v = 0; v < mixer->voiceCapacity; v++)
+        {
+            if (mixer->voices[v].id == 0) { voice = &mixer->voices[v]; break; }
+            if ((voice == NULL) || ((int)(mixer->voices[v].order - voice->order) < 0)) voice = &mixer->voices[v];
+        }
+
+        if (voice->id == 0) mixer->activeCount++;
+        else mixer->stolenCount++;
+
+        InitSynthVoice(&voice->voice, command.params);
+        voice->id = command.voiceId;
+        voice->order = mixer->startCount++;
+        voice->gain = command.gain;
+    }
+    else
+    {
+        for (int v = 0; v < mixer->voiceCapacity; v++)
+        {
+            if ((mixer->voices[v].id != 0) && ((command.type == SYNTH_MIXER_STOP_ALL) || (mixer->voices[v].id == command.voiceId)))
+            {
+                mixer->voices[v].id = 0;
+                mixer->activeCount--;
+            }
+        }
+    }
+}
+
+// Atomic load (acquire)
+static unsigned int SynthAtomicLoad(volatile unsigned int *value)
+{
+#if defined(_MSC_VER)
+    return (unsigned int)_InterlockedOr((volatile long *)value, 0);
+#else
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// Atomic store (release)
+static void SynthAtomicStore(volatile unsigned int *value, unsigned int newValue)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchange((volatile long *)value, (long)newValue);
+#else
+    __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+#endif
+}
+
+// Atomic compare and swap, returns true if value was expected and it has been replaced
+static bool SynthAtomicCompareSwap(volatile unsigned int *value, unsigned int expected, unsigned int newValue)
+{
+#if defined(_MSC_VER)
+    return ((unsigned int)_InterlockedCompareExchange((volatile long *)value, (long)newValue, (long)expected) == expected);
+#else
+    return __atomic_compare_exchange_n(value, &expected, newValue, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+#if defined(SYNTH_PROFILE)
+//--------------------------------------------------------------------------------------------
+// Synth profile functions
+//--------------------------------------------------------------------------------------------
+
+// Set profile events callback, called from generation thread for every measured event
+// NOTE: Callback must be set before generation starts, it is not thread-safe
+void SetSynthProfileCallback(SynthProfileCallback callback, void *userData)
+{
+    synthProfileCallback = callback;
+    synthProfileUserData = userData;
+}
+
+// Add measured event to profile (any thread)
+void AddSynthProfileEvent(int stage, double startTime, double duration, unsigned long long count)
+{
+    if ((stage < 0) || (stage >= SYNTH_PROFILE_STAGES)) return;
+
+    SynthAtomicAdd64(&synthProfileCount[stage], count);
+    SynthAtomicAdd64(&synthProfileTime[stage], (unsigned long long)(duration*1e9));
+
+    if (synthProfileCallback != NULL) synthProfileCallback(stage, startTime, duration, count, synthProfileUserData);
+}
+
+// Get profile counters for all stages (SYNTH_PROFILE_STAGES)
+void GetSynthProfile(SynthProfileCounter *counters)
+{
+    for (int i = 0; i < SYNTH_PROFILE_STAGES; i++)
+    {
+        counters[i].count = SynthAtomicLoad64(&synthProfileCount[i]);
+        counters[i].time = SynthAtomicLoad64(&synthProfileTime[i]);
+    }
+}
+
+// Reset profile counters, timer overhead is measured again
+// NOTE: Counters must be reset while no wave is being generated
+void ResetSynthProfile(void)
+{
+    for (int i = 0; i < SYNTH_PROFILE_STAGES; i++)
+    {
+        synthProfileCount[i] = 0;
+        synthProfileTime[i] = 0;
+    }
+
+    // Timer overhead: average time between two consecutive timer reads
+    double startTime = GetSynthProfileTime();
+    for (int i = 0; i < 1000; i++) GetSynthProfileTime();
+    synthProfileOverhead = (GetSynthProfileTime() - startTime)/1001.0;
+}
+
+// Get profile stage name
+const char *GetSynthProfileStageName(int stage)
+{
+    static const char *stageNames[SYNTH_PROFILE_STAGES] = { "reset", "synth", "filter", "phaser", "noise", "format", "export" };
+
+    if ((stage < 0) || (stage >= SYNTH_PROFILE_STAGES)) return "unknown";
+
+    return stageNames[stage];
+}
+
+// Get profile time in seconds (monotonic, high resolution)
+double GetSynthProfileTime(void)
+{
+#if defined(_WIN32)
+    unsigned long long frequency = 0, counter = 0;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return (double)counter/(double)frequency;
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+#endif
+}
+
+// Add voice per-sample stages counters to profile
+// NOTE: Voice counters are not shared, they are added once on wave generation end
+static void AddSynthVoiceProfile(SynthVoice *voice)
+{
+    for (int i = 0; i < SYNTH_PROFILE_STAGES; i++)
+    {
+        if (voice->profile[i].count == 0) continue;
+
+        SynthAtomicAdd64(&synthProfileCount[i], voice->profile[i].count);
+        SynthAtomicAdd64(&synthProfileTime[i], voice->profile[i].time);
+    }
+}
+
+// Atomic add (relaxed)
+static void SynthAtomicAdd64(volatile unsigned long long *value, unsigned long long addValue)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchangeAdd64((volatile long long *)value, (long long)addValue);
+#else
+    __atomic_fetch_add(value, addValue, __ATOMIC_RELAXED);
+#endif
+}
+
+// Atomic load (relaxed)
+static unsigned long long SynthAtomicLoad64(volatile unsigned long long *value)
+{
+#if defined(_MSC_VER)
+    return (unsigned long long)_InterlockedCompareExchange64((volatile long long *)value, 0, 0);
+#else
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+#endif
+}
+#endif      // SYNTH_PROFILE
+
+//--------------------------------------------------------------------------------------------
+// Random numbers generation functions
+//--------------------------------------------------------------------------------------------
+
+// Init random state from seed
+// NOTE: Seed is scrambled (murmur3 finalizer) so close seeds start on unrelated states
+static RandomState InitRandomState(unsigned int seed)
+{
+    RandomState rng = { 0 };
+
+    unsigned int value = seed + 0x9e3779b9;
+    value ^= value >> 16;
+    value *= 0x85ebca6b;
+    value ^= value >> 13;
+    value *= 0xc2b2ae35;
+    value ^= value >> 16;
+
+    rng.value = (value != 0)? value : 0x6d2b79f5;     // Zero state not allowed on xorshift
+
+    return rng;
+}
+
+// Get next random value between min and max (both included)
+static int GetRandomStateValue(RandomState *rng, int min, int max)
+{
+    if (min > max)
+    {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+
+    // xorshift32 step
+    rng->value ^= rng->value << 13;
+    rng->value ^= rng->value >> 17;
+    rng->value ^= rng->value << 5;
+
+    return min + (int)(rng->value%(unsigned int)(max - min + 1));
+}
+
+//--------------------------------------------------------------------------------------------
+// Sound generation functions
+//--------------------------------------------------------------------------------------------
+
+// Generate sound: Pickup/Coin
+WaveParams GenPickupCoin(unsigned int seed)
+{
+    WaveParams params = { 0 };
+    ResetWaveParams(&params);
+    params.randSeed = seed;
+
+    RandomState rng = InitRandomState(seed);
+
+    params.startFrequencyValue = 0.4f + frnd(&rng, 0.5f);
+    params.attackTimeValue = 0.0f;
+    params.sustainTimeValue = frnd(&rng, 0.1f);
+    params.decayTimeValue = 0.1f + frnd(&rng, 0.4f);
+    params.sustainPunchValue = 0.3f + frnd(&rng, 0.3f);
+
+    if (GetRandomStateValue(&rng, 0, 1))
+    {
+        params.changeSpeedValue = 0.5f + frnd(&rng, 0.2f);
+        params.changeAmountValue = 0.2f + frnd(&rng, 0.4f);
+    }
+    
+    return params;
+}
+
+// Generate sound: Laser shoot
+WaveParams GenLaserShoot(unsigned int seed)
+{
+    WaveParams params = { 0 };
+    ResetWaveParams(&params);
+    params.randSeed = seed;
+
+    RandomState rng = InitRandomState(seed);
+
+    params.waveTypeValue = GetRandomStateValue(&rng, 0, 2);
+
+    if ((params.waveTypeValue == 2) && GetRandomStateValue(&rng, 0, 1)) params.waveTypeValue = GetRandomStateValue(&rng, 0, 1);
+
+    params.startFrequencyValue = 0.5f + frnd(&rng, 0.5f);
+    params.minFrequencyValue = params.startFrequencyValue - 0.2f - frnd(&rng, 0.6f);
+
+    if (params.minFrequencyValue < 0.2f) params.minFrequencyValue = 0.2f;
+
+    params.slideValue = -0.15f - frnd(&rng, 0.2f);
+
+    if (GetRandomStateValue(&rng, 0, 2) == 0)
+    {
+        params.startFrequencyValue = 0.3f + frnd(&rng, 0.6f);
+        params.minFrequencyValue = frnd(&rng, 0.1f);
+        params.slideValue = -0.35f - frnd(&rng, 0.3f);
+    }
+
+    if (GetRandomStateValue(&rng, 0, 1))
+    {
+        params.squareDutyValue = frnd(&rng, 0.5f);
+        params.dutySweepValue = frnd(&rng, 0.2f);
+    }
+    else
+    {
+        params.squareDutyValue = 0.4f + frnd(&rng, 0.5f);
+        params.dutySweepValue = -frnd(&rng, 0.7f);
+    }
+
+    params.attackTimeValue = 0.0f;
+    params.sustainTimeValue = 0.1f + frnd(&rng, 0.2f);
+    params.decayTimeValue = frnd(&rng, 0.4f);
+
+    if (GetRandomStateValue(&rng, 0, 1)) params.sustainPunchValue = frnd(&rng, 0.3f);
+
+    if (GetRandomStateValue(&rng, 0, 2) == 0)
+    {
+        params.phaserOffsetValue = frnd(&rng, 0.2f);
+        params.phaserSweepValue = -frnd(&rng, 0.2f);
+    }
+
+    if (GetRandomStateValue(&rng, 0, 1)) params.hpfCutoffValue = frnd(&rng, 0.3f);
+
+    return params;
+}
+
+// Generate sound: Explosion
+WaveParams GenExplosion(unsigned int seed)
+{
+    WaveParams params = { 0 };
+    ResetWaveParams(&params);
+    params.randSeed = seed;
+
+    RandomState rng = InitRandomState(seed);
+
+    params.waveTypeValue = 3;
+
+    if (GetRandomStateValue(&rng, 0, 1))
+    {
+        params.startFrequencyValue = 0.1f + frnd(&rng, 0.4f);
+        params.slideValue = -0.1f + frnd(&rng, 0.4f);
+    }
+    else
+    {
+        params.startFrequencyValue = 0.2f + frnd(&rng, 0.7f);
+        params.slideValue = -0.2f - frnd(&rng, 0.2f);
+    }
+
+    params.startFrequencyValue *= params.startFrequencyValue;
+
+    if (GetRandomStateValue(&rng, 0, 4) == 0) params.slideValue = 0.0f;
+    if (GetRandomStateValue(&rng, 0, 2) == 0) params.repeatSpeedValue = 0.3f + frnd(&rng, 0.5f);
+
+    params.attackTimeValue = 0.0f;
+    params.sustainTimeValue = 0.1f + frnd(&rng, 0.3f);
+    params.decayTimeValue = frnd(&rng, 0.5f);
+
+    if (GetRandomStateValue(&rng, 0, 1) == 0)
+    {
+        params.phaserOffsetValue = -0.3f + frnd(&rng, 0.9f);
+        params.phaserSweepValue = -frnd(&rng, 0.3f);
+    }
+
+    params.sustainPunchValue = 0.2f + frnd(&rng, 0.6f);
+
+    if (GetRandomStateValue(&rng, 0, 1))
+    {
+        params.vibratoDepthValue = frnd(&rng, 0.7f);
+        params.vibratoSpeedValue = frnd(&rng, 0.6f);
+    }
+
+    if (GetRandomStateValue(&rng, 0, 2) == 0)
+    {
+        params.changeSpeedValue = 0.6f + frnd(&rng, 0.3f);
+        params.changeAmountValue = 0.8f - frnd(&rng, 1.6f);
+    }
+
+    return params;
+}
+
+// Generate sound: Powerup
+WaveParams GenPowerup(unsigned int seed)
+{
+    WaveParams params = { 0 };
+    ResetWaveParams(&params);
+    params.randSeed = seed;
+
+    RandomState rng = InitRandomState(seed);
+    
+    if (GetRandomStateValue(&rng, 0, 1)) params.waveTypeValue = 1;
+    else params.squareDutyValue = frnd(&rng, 0.6f);
+
+    if (GetRandomStateValue(&rng, 0, 1))
+    {
+        params.startFrequencyValue = 0.2f + frnd(&rng, 0.3f);
+        params.slideValue = 0.1f + frnd(&rng, 0.4f);
+        params.repeatSpeedValue = 0.4f + frnd(&rng, 0.4f);
+    }
+    else
+    {
+        params.startFrequencyValue = 0.2f + frnd(&rng, 0.3f);
+        params.slideValue = 0.05f + frnd(&rng, 0.2f);
+
+        if (GetRandomStateValue(&rng, 0, 1))
+        {
+            params.vibratoDepthValue = frnd(&rng, 0.7f);
+            params.vibratoSpeedValue = frnd(&rng, 0.6f);
+        }
+    }
+
+    params.attackTimeValue = 0.0f;
+    params.sustainTimeValue = frnd(&rng, 0.4f);
+    params.decayTimeValue = 0.1f + frnd(&rng, 0.4f);
+
+    return params;
+}
+
+// Generate sound: Hit/Hurt
+WaveParams GenHitHurt(unsigned int seed)
+{
+    WaveParams params = { 0 };
+    ResetWaveParams(&params);
+    params.randSeed = seed;
+
+    RandomState rng = InitRandomState(seed);
+
+    params.waveTypeValue = GetRandomStateValue(&rng, 0, 2);
+    if (params.waveTypeValue == 2) params.waveTypeValue = 3;
+    if (params.waveTypeValue == 0) params.squareDutyValue = frnd(&rng, 0.6f);
+
+    params.startFrequencyValue = 0.2f + frnd(&rng, 0.6f);
+    params.slideValue = -0.3f - frnd(&rng, 0.4f);
+    params.attackTimeValue = 0.0f;
+    params.sustainTimeValue = frnd(&rng, 0.1f);
+    params.decayTimeValue = 0.1f + frnd(&rng, 0.2f);
+
+    if (GetRandomStateValue(&rng, 0, 1)) params.hpfCutoffValue = frnd(&rng, 0.3f);
+
+    return params;
+}
+
+// Generate sound: Jump
+WaveParams GenJump(unsigned int seed)
+{
+    WaveParams params = { 0 };
+    ResetWaveParams(&params);
+    params.randSeed = seed;
+
+    RandomState rng = InitRandomState(seed);
+
+    params.waveTypeValue = 0;
+    params.squareDutyValue = frnd(&rng, 0.6f);
+    params.startFrequencyValue = 0.3f + frnd(&rng, 0.3f);
+    params.slideValue = 0.1f + frnd(&rng, 0.2f);
+    params.attackTimeValue = 0.0f;
+    params.sustainTimeValue = 0.1f + frnd(&rng, 0.3f);
+    params.decayTimeValue = 0.1f + frnd(&rng, 0.2f);
+
+    if (GetRandomStateValue(&rng, 0, 1)) params.hpfCutoffValue = frnd(&rng, 0.3f);
+    if (GetRandomStateValue(&rng, 0, 1)) params.lpfCutoffValue = 1.0f - frnd(&rng, 0.6f);
+
+    return params;
+}
+
+// Generate sound: Blip/Select
+WaveParams GenBlipSelect(unsigned int seed)
+{
+    WaveParams params = { 0 };
+    ResetWaveParams(&params);
+    params.randSeed = seed;
+
+    RandomState rng = InitRandomState(seed);
+
+    params.waveTypeValue = GetRandomStateValue(&rng, 0, 1);
+    if (params.waveTypeValue == 0) params.squareDutyValue = frnd(&rng, 0.6f);
+    params.startFrequencyValue = 0.2f + frnd(&rng, 0.4f);
+    params.attackTimeValue = 0.0f;
+    params.sustainTimeValue = 0.1f + frnd(&rng, 0.1f);
+    params.decayTimeValue = frnd(&rng, 0.2f);
+    params.hpfCutoffValue = 0.1f;
+
+    return params;
+}
+
+// Generate random sound
+WaveParams GenRandomize(unsigned int seed)
+{
+    WaveParams params = { 0 };
+    ResetWaveParams(&params);
+    params.randSeed = seed;
+
+    RandomState rng = InitRandomState(seed);
+
+    params.startFrequencyValue = pow(frnd(&rng, 2.0f) - 1.0f, 2.0f);
+
+    if (GetRandomStateValue(&rng, 0, 1)) params.startFrequencyValue = pow(frnd(&rng, 2.0f) - 1.0f, 3.0f)+0.5f;
+
+    params.minFrequencyValue = 0.0f;
+    params.slideValue = pow(frnd(&rng, 2.0f) - 1.0f, 5.0f);
+
+    if ((params.startFrequencyValue > 0.7f) && (params.slideValue > 0.2f)) params.slideValue = -params.slideValue;
+    if ((params.startFrequencyValue < 0.2f) && (params.slideValue < -0.05f)) params.slideValue = -params.slideValue;
+
+    params.deltaSlideValue = pow(frnd(&rng, 2.0f) - 1.0f, 3.0f);
+    params.squareDutyValue = frnd(&rng, 2.0f) - 1.0f;
+    params.dutySweepValue = pow(frnd(&rng, 2.0f) - 1.0f, 3.0f);
+    params.vibratoDepthValue = pow(frnd(&rng, 2.0f) - 1.0f, 3.0f);
+    params.vibratoSpeedValue = frnd(&rng, 2.0f) - 1.0f;
+    //params.vibratoPhaseDelay = frnd(&rng, 2.0f) - 1.0f;
+    params.attackTimeValue = pow(frnd(&rng, 2.0f) - 1.0f, 3.0f);
+    params.sustainTimeValue = pow(frnd(&rng, 2.0f) - 1.0f, 2.0f);
+    params.decayTimeValue = frnd(&rng, 2.0f)-1.0f;
+    params.sustainPunchValue = pow(frnd(&rng, 0.8f), 2.0f);
+
+    if (params.attackTimeValue + params.sustainTimeValue + params.decayTimeValue < 0.2f)
+    {
+        params.sustainTimeValue += 0.2f + frnd(&rng, 0.3f);
+        params.decayTimeValue += 0.2f + frnd(&rng, 0.3f);
+    }
+
+    params.lpfResonanceValue = frnd(&rng, 2.0f) - 1.0f;
+    params.lpfCutoffValue = 1.0f - pow(frnd(&rng, 1.0f), 3.0f);
+    params.lpfCutoffSweepValue = pow(frnd(&rng, 2.0f) - 1.0f, 3.0f);
+
+    if (params.lpfCutoffValue < 0.1f && params.lpfCutoffSweepValue < -0.05f) params.lpfCutoffSweepValue = -params.lpfCutoffSweepValue;
+
+    params.hpfCutoffValue = pow(frnd(&rng, 1.0f), 5.0f);
+    params.hpfCutoffSweepValue = pow(frnd(&rng, 2.0f) - 1.0f, 5.0f);
+    params.phaserOffsetValue = pow(frnd(&rng, 2.0f) - 1.0f, 3.0f);
+    params.phaserSweepValue = pow(frnd(&rng, 2.0f) - 1.0f, 3.0f);
+    params.repeatSpeedValue = frnd(&rng, 2.0f) - 1.0f;
+    params.changeSpeedValue = frnd(&rng, 2.0f) - 1.0f;
+    params.changeAmountValue = frnd(&rng, 2.0f) - 1.0f;
+    
+    return params;
+}
+
+// Mutate current sound
+// NOTE: Wave random seed is not modified
+void WaveMutate(WaveParams *params, unsigned int seed)
+{
+    RandomState rng = InitRandomState(seed);
+
+    if (GetRandomStateValue(&rng, 0, 1)) params->startFrequencyValue += frnd(&rng, 0.1f) - 0.05f;
+    //if (GetRandomStateValue(&rng, 0, 1)) params.minFrequencyValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->slideValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->deltaSlideValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->squareDutyValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->dutySweepValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->vibratoDepthValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->vibratoSpeedValue += frnd(&rng, 0.1f) - 0.05f;
+    //if (GetRandomStateValue(&rng, 0, 1)) params.vibratoPhaseDelay += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->attackTimeValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->sustainTimeValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->decayTimeValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->sustainPunchValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->lpfResonanceValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->lpfCutoffValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->lpfCutoffSweepValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->hpfCutoffValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->hpfCutoffSweepValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->phaserOffsetValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->phaserSweepValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->repeatSpeedValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->changeSpeedValue += frnd(&rng, 0.1f) - 0.05f;
+    if (GetRandomStateValue(&rng, 0, 1)) params->changeAmountValue += frnd(&rng, 0.1f) - 0.05f;
+}
+
+//--------------------------------------------------------------------------------------------
+// Auxiliar functions
+//--------------------------------------------------------------------------------------------
+
+// Check file extension (same as raylib IsFileExtension())
+static bool IsSynthFileExtension(const char *fileName, const char *ext)
+{
+    const char *fileExt = strrchr(fileName, '.');
+
+    return ((fileExt != NULL) && (strcmp(fileExt, ext) == 0));
+}
+
+#endif // RFXGEN_SYNTH_IMPLEMENTATION